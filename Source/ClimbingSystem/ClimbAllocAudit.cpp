@@ -0,0 +1,228 @@
+#include "ClimbAllocAudit.h"
+
+#if CLIMB_ALLOC_AUDIT
+
+#include "ClimbingSystem.h"
+#include "HAL/MemoryBase.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+namespace
+{
+    thread_local uint64 ThreadAllocCount = 0;
+    bool bAuditInstalled = false;
+    bool bAuditEnabled = false;
+    FClimbAllocAuditStats AuditStats;
+
+    TAutoConsoleVariable<int32> CVarClimbAllocAuditBudget(
+        TEXT("Climb.AllocAudit.SteadyStateBudget"),
+        0,
+        TEXT("Heap allocations a steady state climb tick may make before it is logged as an error, with -ClimbAllocAudit"));
+
+    /** Forwards everything to the real allocator and counts allocations per thread */
+    class FClimbAllocAuditMalloc final : public FMalloc
+    {
+    public:
+        explicit FClimbAllocAuditMalloc(FMalloc *InInnerMalloc)
+            : InnerMalloc(InInnerMalloc)
+        {
+        }
+
+        virtual void *Malloc(SIZE_T Count, uint32 Alignment) override
+        {
+            ++ThreadAllocCount;
+            return InnerMalloc->Malloc(Count, Alignment);
+        }
+
+        virtual void *TryMalloc(SIZE_T Count, uint32 Alignment) override
+        {
+            ++ThreadAllocCount;
+            return InnerMalloc->TryMalloc(Count, Alignment);
+        }
+
+        virtual void *Realloc(void *Original, SIZE_T Count, uint32 Alignment) override
+        {
+            ThreadAllocCount += Count > 0 ? 1 : 0;
+            return InnerMalloc->Realloc(Original, Count, Alignment);
+        }
+
+        virtual void *TryRealloc(void *Original, SIZE_T Count, uint32 Alignment) override
+        {
+            ThreadAllocCount += Count > 0 ? 1 : 0;
+            return InnerMalloc->TryRealloc(Original, Count, Alignment);
+        }
+
+        virtual void Free(void *Original) override { InnerMalloc->Free(Original); }
+        virtual SIZE_T QuantizeSize(SIZE_T Count, uint32 Alignment) override { return InnerMalloc->QuantizeSize(Count, Alignment); }
+        virtual bool GetAllocationSize(void *Original, SIZE_T &SizeOut) override { return InnerMalloc->GetAllocationSize(Original, SizeOut); }
+        virtual void Trim(bool bTrimThreadCaches) override { InnerMalloc->Trim(bTrimThreadCaches); }
+        virtual void SetupTLSCachesOnCurrentThread() override { InnerMalloc->SetupTLSCachesOnCurrentThread(); }
+        virtual void ClearAndDisableTLSCachesOnCurrentThread() override { InnerMalloc->ClearAndDisableTLSCachesOnCurrentThread(); }
+        virtual void InitializeStatsMetadata() override { InnerMalloc->InitializeStatsMetadata(); }
+        virtual void UpdateStats() override { InnerMalloc->UpdateStats(); }
+        virtual void GetAllocatorStats(FGenericMemoryStats &OutStats) override { InnerMalloc->GetAllocatorStats(OutStats); }
+        virtual void DumpAllocatorStats(FOutputDevice &Ar) override { InnerMalloc->DumpAllocatorStats(Ar); }
+        virtual bool IsInternallyThreadSafe() const override { return InnerMalloc->IsInternallyThreadSafe(); }
+        virtual bool ValidateHeap() override { return InnerMalloc->ValidateHeap(); }
+        virtual const TCHAR *GetDescriptiveName() override { return InnerMalloc->GetDescriptiveName(); }
+
+    private:
+        FMalloc *InnerMalloc;
+    };
+
+    /** Inclusive allocation counts of each audited scope during the current climb tick, game thread only */
+    struct FTickRecord
+    {
+        static constexpr int32 MaxScopes = 32;
+
+        const TCHAR *ScopeNames[MaxScopes];
+        uint64 NumAllocs[MaxScopes];
+        int32 NumScopes = 0;
+        uint64 StartCount = 0;
+        bool bInTick = false;
+
+        void Add(const TCHAR *ScopeName, uint64 Count)
+        {
+            for (int32 i = 0; i < NumScopes; ++i)
+            {
+                if (ScopeNames[i] == ScopeName)
+                {
+                    NumAllocs[i] += Count;
+                    return;
+                }
+            }
+
+            if (NumScopes < MaxScopes)
+            {
+                ScopeNames[NumScopes] = ScopeName;
+                NumAllocs[NumScopes] = Count;
+                NumScopes++;
+            }
+        }
+    };
+
+    FTickRecord TickRecord;
+
+#if IS_MONOLITHIC
+    /**
+     * Runs before main, when static initialization is the only thing running, the same point the engine puts its own
+     * allocator proxies in place. The proxy only forwards, so blocks allocated before it can still be freed through it.
+     */
+    struct FClimbAllocAuditInstaller
+    {
+        FClimbAllocAuditInstaller()
+        {
+            // GMalloc is created on first use
+            FMemory::Free(FMemory::Malloc(1));
+
+            GMalloc = new FClimbAllocAuditMalloc(GMalloc);
+            bAuditInstalled = true;
+        }
+    };
+
+    FClimbAllocAuditInstaller AuditInstaller;
+#endif
+}
+
+void ClimbAllocAudit::EnableIfRequested()
+{
+    if (!FParse::Param(FCommandLine::Get(), TEXT("ClimbAllocAudit")))
+        return;
+
+    if (!bAuditInstalled)
+    {
+        UE_LOG(LogClimbing, Warning, TEXT("Climb allocation audit needs a monolithic build, -ClimbAllocAudit ignored"));
+        return;
+    }
+
+    bAuditEnabled = true;
+    UE_LOG(LogClimbing, Display, TEXT("Climb allocation audit enabled"));
+}
+
+bool ClimbAllocAudit::IsInstalled()
+{
+    return bAuditInstalled;
+}
+
+bool ClimbAllocAudit::IsEnabled()
+{
+    return bAuditEnabled;
+}
+
+void ClimbAllocAudit::SetEnabled(bool bEnabled)
+{
+    bAuditEnabled = bEnabled && bAuditInstalled;
+}
+
+int32 ClimbAllocAudit::GetSteadyStateBudget()
+{
+    return FMath::Max(CVarClimbAllocAuditBudget.GetValueOnGameThread(), 0);
+}
+
+const FClimbAllocAuditStats &ClimbAllocAudit::GetStats()
+{
+    return AuditStats;
+}
+
+void ClimbAllocAudit::ResetStats()
+{
+    AuditStats = FClimbAllocAuditStats();
+}
+
+uint64 ClimbAllocAudit::GetThreadAllocCount()
+{
+    return ThreadAllocCount;
+}
+
+void ClimbAllocAudit::Record(const TCHAR *ScopeName, uint64 NumAllocs)
+{
+    if (!bAuditEnabled || !TickRecord.bInTick || !IsInGameThread())
+        return;
+
+    TickRecord.Add(ScopeName, NumAllocs);
+}
+
+void ClimbAllocAudit::BeginTick()
+{
+    if (!bAuditEnabled)
+        return;
+
+    TickRecord.NumScopes = 0;
+    TickRecord.StartCount = ThreadAllocCount;
+    TickRecord.bInTick = true;
+}
+
+void ClimbAllocAudit::EndTick(const UObject &Context, bool bSteadyState)
+{
+    if (!bAuditEnabled || !TickRecord.bInTick)
+        return;
+
+    TickRecord.bInTick = false;
+
+    if (!bSteadyState)
+        return;
+
+    const uint64 TickAllocs = ThreadAllocCount - TickRecord.StartCount;
+    const int32 Budget = GetSteadyStateBudget();
+
+    AuditStats.NumSteadyTicks++;
+    AuditStats.MaxSteadyTickAllocs = FMath::Max(AuditStats.MaxSteadyTickAllocs, TickAllocs);
+
+    if (TickAllocs <= uint64(Budget))
+        return;
+
+    AuditStats.NumTicksOverBudget++;
+
+    UE_LOG(LogClimbing, Error, TEXT("%s: steady state climb tick made %llu heap allocations, budget is %d"),
+        *Context.GetName(), TickAllocs, Budget);
+
+    for (int32 i = 0; i < TickRecord.NumScopes; ++i)
+    {
+        if (TickRecord.NumAllocs[i] > 0)
+        {
+            UE_LOG(LogClimbing, Error, TEXT("  %-32s %llu"), TickRecord.ScopeNames[i], TickRecord.NumAllocs[i]);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,73 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Debug only count of heap allocations made by the climbing code on the game thread.
+ * The counting proxy goes in front of GMalloc during static initialization of monolithic builds, before main starts
+ * any other thread that could be inside the allocator. Modular builds load this module too late to do that safely and
+ * count nothing. Steady state climb ticks that allocate more than Climb.AllocAudit.SteadyStateBudget are logged as
+ * errors with -ClimbAllocAudit, and fail the ClimbingSystem.AllocAudit automation test.
+ */
+#define CLIMB_ALLOC_AUDIT (!UE_BUILD_SHIPPING && !UE_BUILD_TEST)
+
+#if CLIMB_ALLOC_AUDIT
+
+/** Steady state climb ticks since the last reset */
+struct FClimbAllocAuditStats
+{
+	int32 NumSteadyTicks = 0;
+	int32 NumTicksOverBudget = 0;
+	uint64 MaxSteadyTickAllocs = 0;
+};
+
+namespace ClimbAllocAudit
+{
+	/** Climb ticks after the start of a climb, or the end of a climb action, that are not counted as steady state yet */
+	constexpr int32 SteadyStateWarmupTicks = 10;
+
+	/** Turns the steady state tick report on with -ClimbAllocAudit */
+	void EnableIfRequested();
+
+	/** False in builds that could not put the counting proxy in place */
+	bool IsInstalled();
+	bool IsEnabled();
+	void SetEnabled(bool bEnabled);
+
+	int32 GetSteadyStateBudget();
+	const FClimbAllocAuditStats &GetStats();
+	void ResetStats();
+
+	/** Heap allocations made so far by the calling thread */
+	uint64 GetThreadAllocCount();
+
+	void Record(const TCHAR *ScopeName, uint64 NumAllocs);
+
+	void BeginTick();
+	void EndTick(const UObject &Context, bool bSteadyState);
+}
+
+struct FClimbAllocAuditScope
+{
+	explicit FClimbAllocAuditScope(const TCHAR *InScopeName)
+		: ScopeName(InScopeName), StartCount(ClimbAllocAudit::GetThreadAllocCount())
+	{
+	}
+
+	~FClimbAllocAuditScope()
+	{
+		ClimbAllocAudit::Record(ScopeName, ClimbAllocAudit::GetThreadAllocCount() - StartCount);
+	}
+
+private:
+	const TCHAR *ScopeName;
+	uint64 StartCount;
+};
+
+#define CLIMB_ALLOC_AUDIT_SCOPE(Name) FClimbAllocAuditScope ANONYMOUS_VARIABLE(ClimbAllocAuditScope)(TEXT(#Name))
+
+#else
+
+#define CLIMB_ALLOC_AUDIT_SCOPE(Name)
+
+#endif
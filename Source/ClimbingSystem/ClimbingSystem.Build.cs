@@ -15,7 +15,15 @@ public class ClimbingSystem : ModuleRules
 			"InputCore",
 			"HeadMountedDisplay",
 			"EnhancedInput",
-			"MotionWarping"
+			"MotionWarping",
+			"DeveloperSettings",
+			"MassEntity",
+			"MassCommon",
+			"AnimationBudgetAllocator",
+			"AssetRegistry",
+			"PhysicsCore",
+			"Chaos",
+			"Niagara"
 			}
 		);
 	}
@@ -1,7 +1,21 @@
 // Copyright Epic Games, Inc. All Rights Reserved.
 
 #include "ClimbingSystem.h"
+#include "ClimbAllocAudit.h"
 #include "Modules/ModuleManager.h"
 
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, ClimbingSystem, "ClimbingSystem" );
- 
\ No newline at end of file
+DEFINE_LOG_CATEGORY(LogClimbing);
+LLM_DEFINE_TAG(Climbing);
+
+class FClimbingSystemModule : public FDefaultGameModuleImpl
+{
+public:
+	virtual void StartupModule() override
+	{
+#if CLIMB_ALLOC_AUDIT
+		ClimbAllocAudit::EnableIfRequested();
+#endif
+	}
+};
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FClimbingSystemModule, ClimbingSystem, "ClimbingSystem" );
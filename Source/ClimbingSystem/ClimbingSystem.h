@@ -3,3 +3,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogClimbing, Log, All);
+
+/** Low level memory tag of everything the climbing code allocates */
+LLM_DECLARE_TAG_API(Climbing, CLIMBINGSYSTEM_API);
+
+/** Object channel of the simplified climb-only collision, see UClimbCollisionProxyComponent */
+#define ECC_ClimbProxy ECC_GameTraceChannel1
+
+DECLARE_STATS_GROUP(TEXT("Climbing"), STATGROUP_Climbing, STATCAT_Advanced);
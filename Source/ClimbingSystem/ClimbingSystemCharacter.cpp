@@ -10,6 +10,10 @@
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "MotionWarpingComponent.h"
+#include "Components/ClimbAnimUpdateRateComponent.h"
+#include "Components/ClimbLimbIKComponent.h"
+#include "Components/ClimbSpringArmComponent.h"
+#include "SkeletalMeshComponentBudgeted.h"
 
 #include "DebugHelper.h"
 
@@ -17,7 +21,9 @@
 // AClimbingSystemCharacter
 
 AClimbingSystemCharacter::AClimbingSystemCharacter(const FObjectInitializer &ObjectInitializer)
-	: Super(ObjectInitializer.SetDefaultSubobjectClass<UCustomMovementComponent>(ACharacter::CharacterMovementComponentName))
+	: Super(ObjectInitializer
+				.SetDefaultSubobjectClass<UCustomMovementComponent>(ACharacter::CharacterMovementComponentName)
+				.SetDefaultSubobjectClass<USkeletalMeshComponentBudgeted>(ACharacter::MeshComponentName))
 {
 	// Set size for collision capsule
 	GetCapsuleComponent()->InitCapsuleSize(42.f, 96.0f);
@@ -42,9 +48,9 @@ AClimbingSystemCharacter::AClimbingSystemCharacter(const FObjectInitializer &Obj
 	GetCharacterMovement()->BrakingDecelerationWalking = 2000.f;
 
 	// Create a camera boom (pulls in towards the player if there is a collision)
-	CameraBoom = CreateDefaultSubobject<USpringArmComponent>(TEXT("CameraBoom"));
+	// Arm lengths per ground, climb and hang framing are set on the boom itself
+	CameraBoom = CreateDefaultSubobject<UClimbSpringArmComponent>(TEXT("CameraBoom"));
 	CameraBoom->SetupAttachment(RootComponent);
-	CameraBoom->TargetArmLength = 400.0f;		// The camera follows at this distance behind the character
 	CameraBoom->bUsePawnControlRotation = true; // Rotate the arm based on the controller
 
 	// Create a follow camera
@@ -53,6 +59,10 @@ AClimbingSystemCharacter::AClimbingSystemCharacter(const FObjectInitializer &Obj
 	FollowCamera->bUsePawnControlRotation = false;								// Camera does not rotate relative to arm
 
 	MotionWarpingComponent = CreateDefaultSubobject<UMotionWarpingComponent>(TEXT("MotionWarpingComp"));
+
+	ClimbAnimUpdateRateComponent = CreateDefaultSubobject<UClimbAnimUpdateRateComponent>(TEXT("ClimbAnimUpdateRate"));
+
+	ClimbLimbIKComponent = CreateDefaultSubobject<UClimbLimbIKComponent>(TEXT("ClimbLimbIK"));
 }
 
 void AClimbingSystemCharacter::BeginPlay()
@@ -64,8 +74,7 @@ void AClimbingSystemCharacter::BeginPlay()
 
 	if (CustomMovementComponent)
 	{
-		CustomMovementComponent->OnEnterClimbStateDelegate.BindUObject(this, &ThisClass::OnPlayerEnterClimbState);
-		CustomMovementComponent->OnExitClimbStateDelegate.BindUObject(this, &ThisClass::OnPlayerExitClimbState);
+		CustomMovementComponent->OnClimbEventDelegate.AddUObject(this, &ThisClass::OnClimbEvent);
 	}
 }
 
@@ -178,16 +187,21 @@ void AClimbingSystemCharacter::Look(const FInputActionValue &Value)
 
 void AClimbingSystemCharacter::OnClimbActionStarted(const FInputActionValue &Value)
 {
-	if (!CustomMovementComponent)
-		return;
+	if (CustomMovementComponent)
+	{
+		CustomMovementComponent->RequestClimbAction();
+	}
+}
 
-	if (!CustomMovementComponent->IsClimbing())
+void AClimbingSystemCharacter::OnClimbEvent(const FClimbEvent &Event)
+{
+	if (Event.Type == EClimbEventType::ClimbStarted)
 	{
-		CustomMovementComponent->ToggleClimbing(true);
+		OnPlayerEnterClimbState();
 	}
-	else
+	else if (Event.Type == EClimbEventType::ClimbEnded)
 	{
-		CustomMovementComponent->ToggleClimbing(false);
+		OnPlayerExitClimbState();
 	}
 }
 
@@ -11,8 +11,11 @@ class USpringArmComponent;
 class UCameraComponent;
 class UCustomMovementComponent;
 class UMotionWarpingComponent;
+class UClimbAnimUpdateRateComponent;
+class UClimbLimbIKComponent;
 class UInputMappingContext;
 class UInputAction;
+struct FClimbEvent;
 UCLASS(config = Game)
 class AClimbingSystemCharacter : public ACharacter
 {
@@ -38,9 +41,16 @@ private:
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Movement, meta = (AllowPrivateAccess = "true"))
 	UMotionWarpingComponent *MotionWarpingComponent;
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Animation, meta = (AllowPrivateAccess = "true"))
+	UClimbAnimUpdateRateComponent *ClimbAnimUpdateRateComponent;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Animation, meta = (AllowPrivateAccess = "true"))
+	UClimbLimbIKComponent *ClimbLimbIKComponent;
+
 #pragma endregion
 
 #pragma region Input
+	void OnClimbEvent(const FClimbEvent &Event);
 	void OnPlayerEnterClimbState();
 	void OnPlayerExitClimbState();
 	void AddInputMappingContext(UInputMappingContext *ContextToAdd, int32 InPriority);
@@ -104,4 +114,5 @@ public:
 
 	FORCEINLINE UCustomMovementComponent *GetCustomMovementComponent() const { return CustomMovementComponent; }
 	FORCEINLINE UMotionWarpingComponent *GetMotionWarpingComponent() const { return MotionWarpingComponent; }
+	FORCEINLINE UClimbLimbIKComponent *GetClimbLimbIKComponent() const { return ClimbLimbIKComponent; }
 };
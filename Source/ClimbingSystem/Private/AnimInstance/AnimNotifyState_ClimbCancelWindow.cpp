@@ -0,0 +1,28 @@
+#include "AnimInstance/AnimNotifyState_ClimbCancelWindow.h"
+#include "Animation/AnimMontage.h"
+
+FString UAnimNotifyState_ClimbCancelWindow::GetNotifyName_Implementation() const
+{
+    if (bAllowTraversal && bAllowLocomotion)
+        return TEXT("Climb Cancel: Traversal + Locomotion");
+
+    return bAllowTraversal ? TEXT("Climb Cancel: Traversal") : TEXT("Climb Cancel: Locomotion");
+}
+
+void UAnimNotifyState_ClimbCancelWindow::GatherWindows(const UAnimMontage &Montage, TArray<FClimbCancelWindow> &OutWindows)
+{
+    OutWindows.Reset();
+
+    for (const FAnimNotifyEvent &NotifyEvent : Montage.Notifies)
+    {
+        const UAnimNotifyState_ClimbCancelWindow *CancelNotify = Cast<UAnimNotifyState_ClimbCancelWindow>(NotifyEvent.NotifyStateClass);
+        if (!CancelNotify)
+            continue;
+
+        FClimbCancelWindow &Window = OutWindows.AddDefaulted_GetRef();
+        Window.StartTime = NotifyEvent.GetTriggerTime();
+        Window.EndTime = NotifyEvent.GetEndTriggerTime();
+        Window.bAllowTraversal = CancelNotify->bAllowTraversal;
+        Window.bAllowLocomotion = CancelNotify->bAllowLocomotion;
+    }
+}
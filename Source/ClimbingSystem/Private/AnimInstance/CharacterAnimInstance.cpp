@@ -12,6 +12,7 @@ void UCharacterAnimInstance::NativeInitializeAnimation()
     if (ClimbingSystemCharacter)
     {
         CustomMovementComponent = ClimbingSystemCharacter->GetCustomMovementComponent();
+        ClimbLimbIKComponent = ClimbingSystemCharacter->GetClimbLimbIKComponent();
     }
 }
 
@@ -27,7 +28,19 @@ void UCharacterAnimInstance::NativeUpdateAnimation(float DeltaSeconds)
     GetShouldMove();
     GetIsFalling();
     GetIsClimbing();
+    GetIsHanging();
     GetClimbVelocity();
+    GetClimbPhase();
+}
+
+void UCharacterAnimInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+    Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
+
+    if (!ClimbLimbIKComponent)
+        return;
+
+    GetLimbIKTargets();
 }
 
 void UCharacterAnimInstance::GetGroundSpeed()
@@ -55,10 +68,32 @@ void UCharacterAnimInstance::GetIsFalling()
 
 void UCharacterAnimInstance::GetIsClimbing()
 {
-    bIsClimbing = CustomMovementComponent->IsClimbing();
+    bIsClimbing = CustomMovementComponent->IsClimbing() || CustomMovementComponent->IsClimbingSpline();
+}
+
+void UCharacterAnimInstance::GetIsHanging()
+{
+    bIsHanging = CustomMovementComponent->IsHanging();
 }
 
 void UCharacterAnimInstance::GetClimbVelocity()
 {
     ClimbVelocity = CustomMovementComponent->GetUnrotatedClimbVelocity();
+}
+
+void UCharacterAnimInstance::GetClimbPhase()
+{
+    ClimbPhase = CustomMovementComponent->GetClimbPhase();
+}
+
+void UCharacterAnimInstance::GetLimbIKTargets()
+{
+    // Runs on an anim worker thread, the component hands over a copy taken under its lock
+    FClimbLimbIKSnapshot Snapshot;
+    ClimbLimbIKComponent->ReadSnapshot(Snapshot);
+
+    LeftHandIK = Snapshot.Limbs[int32(EClimbLimb::LeftHand)];
+    RightHandIK = Snapshot.Limbs[int32(EClimbLimb::RightHand)];
+    LeftFootIK = Snapshot.Limbs[int32(EClimbLimb::LeftFoot)];
+    RightFootIK = Snapshot.Limbs[int32(EClimbLimb::RightFoot)];
 }
\ No newline at end of file
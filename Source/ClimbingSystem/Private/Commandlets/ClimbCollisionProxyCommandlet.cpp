@@ -0,0 +1,55 @@
+#include "Commandlets/ClimbCollisionProxyCommandlet.h"
+#include "ClimbCommandletHelpers.h"
+#include "ClimbingSystem.h"
+#include "Components/ClimbCollisionProxyUserData.h"
+#include "Engine/StaticMesh.h"
+
+UClimbCollisionProxyCommandlet::UClimbCollisionProxyCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UClimbCollisionProxyCommandlet::Main(const FString &Params)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+#if WITH_EDITOR
+    const FClimbCollisionProxyBuildSettings BuildSettings;
+    int64 NumSourceTriangles = 0;
+    int64 NumProxyElements = 0;
+
+    const ClimbCommandletHelpers::FMeshPassResult Result = ClimbCommandletHelpers::ProcessStaticMeshes(
+        Params,
+        UClimbCollisionProxyUserData::StaticClass(),
+        [&](UStaticMesh &StaticMesh)
+        {
+            UClimbCollisionProxyUserData *ProxyData = UClimbCollisionProxyUserData::Get(&StaticMesh);
+            if (!ProxyData)
+            {
+                ProxyData = NewObject<UClimbCollisionProxyUserData>(&StaticMesh, NAME_None, RF_Public | RF_Transactional);
+                StaticMesh.AddAssetUserData(ProxyData);
+            }
+
+            ProxyData->Generate(StaticMesh, BuildSettings);
+            NumSourceTriangles += ProxyData->SourceTriangleCount;
+            NumProxyElements += ProxyData->ProxyGeometry.GetElementCount();
+
+            UE_LOG(LogClimbing, Display, TEXT("%s: %d triangles -> %d boxes, %d capsules"),
+                *StaticMesh.GetPathName(),
+                ProxyData->SourceTriangleCount,
+                ProxyData->ProxyGeometry.BoxElems.Num(),
+                ProxyData->ProxyGeometry.SphylElems.Num());
+            return true;
+        });
+
+    UE_LOG(LogClimbing, Display, TEXT("Climb collision proxies: %d meshes saved, %d failed, %lld source triangles, %lld proxy elements"),
+        Result.NumSaved, Result.NumFailed, NumSourceTriangles, NumProxyElements);
+
+    return Result.NumFailed > 0 ? 1 : 0;
+#else
+    return 1;
+#endif
+}
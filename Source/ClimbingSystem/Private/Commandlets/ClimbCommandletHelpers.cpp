@@ -0,0 +1,105 @@
+#include "ClimbCommandletHelpers.h"
+#include "ClimbingSystem.h"
+#include "Components/CustomMovementComponent.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Engine/AssetUserData.h"
+#include "Engine/StaticMesh.h"
+#include "GameFramework/Character.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+const ACharacter *ClimbCommandletHelpers::LoadClimbingCharacter(const FString &Params, const UCustomMovementComponent *&OutMovementComponent)
+{
+    OutMovementComponent = nullptr;
+
+    FString CharacterPath = TEXT("/Game/ClimbingSystem/BP_ClimbingSystemCharacter");
+    FParse::Value(*Params, TEXT("Character="), CharacterPath);
+
+    if (!CharacterPath.Contains(TEXT(".")))
+    {
+        CharacterPath += TEXT(".") + FPackageName::GetShortName(CharacterPath) + TEXT("_C");
+    }
+
+    UClass *CharacterClass = LoadClass<ACharacter>(nullptr, *CharacterPath);
+    const ACharacter *CharacterCDO = CharacterClass ? CharacterClass->GetDefaultObject<ACharacter>() : nullptr;
+    const UCustomMovementComponent *MovementComponent =
+        CharacterCDO ? Cast<UCustomMovementComponent>(CharacterCDO->GetCharacterMovement()) : nullptr;
+
+    if (!MovementComponent)
+    {
+        UE_LOG(LogClimbing, Error, TEXT("Could not load a character using UCustomMovementComponent from %s"), *CharacterPath);
+        return nullptr;
+    }
+
+    if (MovementComponent->GetClimbableSurfaceTraceTypes().IsEmpty())
+    {
+        UE_LOG(LogClimbing, Error, TEXT("%s has no ClimbableSurfaceTraceTypes"), *CharacterPath);
+        return nullptr;
+    }
+
+    OutMovementComponent = MovementComponent;
+    return CharacterCDO;
+}
+
+#if WITH_EDITOR
+ClimbCommandletHelpers::FMeshPassResult ClimbCommandletHelpers::ProcessStaticMeshes(const FString &Params, TSubclassOf<UAssetUserData> UserDataClass, TFunctionRef<bool(UStaticMesh &)> Generate)
+{
+    FString ContentPath = TEXT("/Game");
+    FParse::Value(*Params, TEXT("Path="), ContentPath);
+    const bool bRemove = FParse::Param(*Params, TEXT("Remove"));
+
+    IAssetRegistry &AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+    AssetRegistry.SearchAllAssets(true);
+
+    FARFilter Filter;
+    Filter.ClassPaths.Add(UStaticMesh::StaticClass()->GetClassPathName());
+    Filter.PackagePaths.Add(FName(*ContentPath));
+    Filter.bRecursivePaths = true;
+
+    TArray<FAssetData> MeshAssets;
+    AssetRegistry.GetAssets(Filter, MeshAssets);
+
+    FMeshPassResult Result;
+
+    for (const FAssetData &MeshAsset : MeshAssets)
+    {
+        UStaticMesh *StaticMesh = Cast<UStaticMesh>(MeshAsset.GetAsset());
+        if (!StaticMesh)
+            continue;
+
+        if (bRemove)
+        {
+            if (!StaticMesh->GetAssetUserDataOfClass(UserDataClass))
+                continue;
+
+            StaticMesh->RemoveUserDataOfClass(UserDataClass);
+        }
+        else if (!Generate(*StaticMesh))
+        {
+            continue;
+        }
+
+        UPackage *Package = StaticMesh->GetPackage();
+        Package->MarkPackageDirty();
+
+        const FString Filename = FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension());
+
+        FSavePackageArgs SaveArgs;
+        SaveArgs.TopLevelFlags = RF_Standalone;
+        SaveArgs.Error = GError;
+
+        if (UPackage::SavePackage(Package, StaticMesh, *Filename, SaveArgs))
+        {
+            Result.NumSaved++;
+        }
+        else
+        {
+            Result.NumFailed++;
+            UE_LOG(LogClimbing, Error, TEXT("Could not save %s, is it checked out?"), *Filename);
+        }
+    }
+
+    return Result;
+}
+#endif
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SubclassOf.h"
+
+class ACharacter;
+class UAssetUserData;
+class UCustomMovementComponent;
+class UStaticMesh;
+
+/** Parameters and asset passes the climbing commandlets share */
+namespace ClimbCommandletHelpers
+{
+	/**
+	 * Class default object of the character named by -Character=, the climbing character by default. Logs and returns
+	 * null unless it moves with UCustomMovementComponent and has ClimbableSurfaceTraceTypes set.
+	 */
+	const ACharacter *LoadClimbingCharacter(const FString &Params, const UCustomMovementComponent *&OutMovementComponent);
+
+#if WITH_EDITOR
+	struct FMeshPassResult
+	{
+		int32 NumSaved = 0;
+		int32 NumFailed = 0;
+	};
+
+	/**
+	 * Runs Generate on every static mesh under -Path= and saves the meshes it returns true for. With -Remove the meshes'
+	 * UserDataClass entries are stripped and saved instead, Generate is not called.
+	 */
+	FMeshPassResult ProcessStaticMeshes(const FString &Params, TSubclassOf<UAssetUserData> UserDataClass, TFunctionRef<bool(UStaticMesh &)> Generate);
+#endif
+}
@@ -0,0 +1,86 @@
+#include "Commandlets/ClimbDistanceFieldCommandlet.h"
+#include "ClimbCommandletHelpers.h"
+#include "ClimbingSystem.h"
+#include "Components/ClimbDistanceFieldUserData.h"
+#include "Components/CustomMovementComponent.h"
+#include "Engine/StaticMesh.h"
+#include "PhysicsEngine/BodySetup.h"
+
+UClimbDistanceFieldCommandlet::UClimbDistanceFieldCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UClimbDistanceFieldCommandlet::Main(const FString &Params)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+#if WITH_EDITOR
+    const bool bRemove = FParse::Param(*Params, TEXT("Remove"));
+    const bool bAllMeshes = FParse::Param(*Params, TEXT("All"));
+
+    FClimbDistanceFieldBuildSettings BuildSettings;
+    FParse::Value(*Params, TEXT("VoxelSize="), BuildSettings.VoxelSize);
+    FParse::Value(*Params, TEXT("BandVoxels="), BuildSettings.BandVoxels);
+
+    int32 MaxKB = BuildSettings.MaxBytes / 1024;
+    FParse::Value(*Params, TEXT("MaxKB="), MaxKB);
+    BuildSettings.MaxBytes = FMath::Max(MaxKB, 1) * 1024;
+
+    FCollisionObjectQueryParams ClimbableObjectParams;
+    if (!bRemove && !bAllMeshes)
+    {
+        const UCustomMovementComponent *MovementComponent;
+        if (!ClimbCommandletHelpers::LoadClimbingCharacter(Params, MovementComponent))
+        {
+            UE_LOG(LogClimbing, Error, TEXT("Pass -All to skip the climbable channel filter"));
+            return 1;
+        }
+
+        ClimbableObjectParams = FCollisionObjectQueryParams(MovementComponent->GetClimbableSurfaceTraceTypes());
+    }
+
+    int64 NumFieldBytes = 0;
+
+    const ClimbCommandletHelpers::FMeshPassResult Result = ClimbCommandletHelpers::ProcessStaticMeshes(
+        Params,
+        UClimbDistanceFieldUserData::StaticClass(),
+        [&](UStaticMesh &StaticMesh)
+        {
+            if (!bAllMeshes)
+            {
+                const UBodySetup *BodySetup = StaticMesh.GetBodySetup();
+                if (!BodySetup || !(ClimbableObjectParams.GetQueryBitfield() & ECC_TO_BITFIELD(BodySetup->DefaultInstance.GetObjectType())))
+                    return false;
+            }
+
+            UClimbDistanceFieldUserData *FieldData = UClimbDistanceFieldUserData::Get(&StaticMesh);
+            if (!FieldData)
+            {
+                FieldData = NewObject<UClimbDistanceFieldUserData>(&StaticMesh, NAME_None, RF_Public | RF_Transactional);
+                StaticMesh.AddAssetUserData(FieldData);
+            }
+
+            FieldData->Generate(StaticMesh, BuildSettings);
+            NumFieldBytes += FieldData->GetFieldBytes();
+
+            UE_LOG(LogClimbing, Display, TEXT("%s: %d triangles -> %d bricks at %.1f voxels, %d bytes"),
+                *StaticMesh.GetPathName(),
+                FieldData->SourceTriangleCount,
+                FieldData->BrickSamples.Num() / UClimbDistanceFieldUserData::BrickSampleCount,
+                FieldData->VoxelSize,
+                FieldData->GetFieldBytes());
+            return true;
+        });
+
+    UE_LOG(LogClimbing, Display, TEXT("Climb distance fields: %d meshes saved, %d failed, %lld field bytes"),
+        Result.NumSaved, Result.NumFailed, NumFieldBytes);
+
+    return Result.NumFailed > 0 ? 1 : 0;
+#else
+    return 1;
+#endif
+}
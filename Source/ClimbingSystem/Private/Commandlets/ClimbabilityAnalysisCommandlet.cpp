@@ -0,0 +1,964 @@
+#include "Commandlets/ClimbabilityAnalysisCommandlet.h"
+#include "ClimbCommandletHelpers.h"
+#include "ClimbingSystem.h"
+#include "Components/ClimbSurfaceRules.h"
+#include "Components/ClimbMeshGeometry.h"
+#include "Components/CustomMovementComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Character.h"
+#include "Async/ParallelFor.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+#include "UObject/SoftObjectPath.h"
+#if WITH_EDITOR
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/LoaderAdapter/LoaderAdapterShape.h"
+#endif
+
+namespace ClimbabilityAnalysis
+{
+    struct FSettings
+    {
+        FCollisionObjectQueryParams ObjectQueryParams;
+        float BaseEyeHeight = 64.f;
+        float StandingHalfHeight = 96.f;
+        float CapsuleRadius = 42.f;
+        float ClimbDownWalkableSurfaceTraceOffset = 15.f;
+        float ClimbDownLedgeTraceOffset = 25.f;
+        float CellSize = 200.f;
+        float SampleSpacing = 100.f;
+        float MinRegionArea = 10000.f;
+        float RegionSize = 51200.f;
+        float RegionMargin = 1000.f;
+        float ConnectTolerance = 10.f;
+    };
+
+    struct FMeshInstance
+    {
+        const UStaticMesh *StaticMesh = nullptr;
+        FTransform Transform;
+        FString Label;
+
+        /** Index of the mesh geometry, shared by all instances of StaticMesh */
+        int32 GeometryIndex = INDEX_NONE;
+    };
+
+    struct FCell
+    {
+        float ClimbableArea = 0.f;
+        float WalkableArea = 0.f;
+        int32 LedgeSamples = 0;
+        int32 ClimbDownSamples = 0;
+        int32 VaultSamples = 0;
+        int32 DeadEndRegions = 0;
+        int32 UnreachableRegions = 0;
+
+        void Merge(const FCell &Other)
+        {
+            ClimbableArea += Other.ClimbableArea;
+            WalkableArea += Other.WalkableArea;
+            LedgeSamples += Other.LedgeSamples;
+            ClimbDownSamples += Other.ClimbDownSamples;
+            VaultSamples += Other.VaultSamples;
+            DeadEndRegions += Other.DeadEndRegions;
+            UnreachableRegions += Other.UnreachableRegions;
+        }
+    };
+
+    struct FFlaggedRegion
+    {
+        FString Label;
+        FVector Center = FVector::ZeroVector;
+        float Area = 0.f;
+        bool bUnreachable = false;
+    };
+
+    /** Connected climbable triangles of one mesh instance, joined with the pieces of touching meshes before flagging */
+    struct FRegionPiece
+    {
+        FString Label;
+        float Area = 0.f;
+        FVector WeightedCenter = FVector::ZeroVector;
+        bool bHasLedge = false;
+        bool bHasEntry = false;
+
+        /** Samples of the open climbable boundary, where a stacked or adjacent mesh can continue the wall */
+        TArray<FVector> BoundaryPoints;
+    };
+
+    struct FInstanceResult
+    {
+        TMap<FIntPoint, FCell> Cells;
+        TArray<FRegionPiece> Regions;
+        int32 NumTriangles = 0;
+        FThreadSafeCounter NumQueries;
+    };
+
+    /** Totals of every world partition region analyzed so far */
+    struct FAnalysis
+    {
+        TMap<FSoftObjectPath, int32> GeometryIndices;
+        TArray<FClimbMeshGeometry> Geometries;
+        TMap<FIntPoint, FCell> Cells;
+        TArray<FRegionPiece> Regions;
+        int32 NumInstances = 0;
+        int64 NumTriangles = 0;
+        int64 NumQueries = 0;
+    };
+
+    struct FTriangle
+    {
+        FVector A, B, C;
+        FVector Normal;
+        FVector Centroid;
+        float Area = 0.f;
+        bool bClimbable = false;
+        bool bWalkable = false;
+    };
+
+    struct FEdge
+    {
+        int32 V0 = INDEX_NONE;
+        int32 V1 = INDEX_NONE;
+        int32 Triangles[2] = {INDEX_NONE, INDEX_NONE};
+    };
+
+    enum EEdgeTests : uint8
+    {
+        Test_ClimbUp = 1 << 0,
+        Test_Vault = 1 << 1,
+        Test_ClimbDown = 1 << 2,
+    };
+
+    struct FEdgeCandidate
+    {
+        FVector Start;
+        FVector End;
+        FVector Outward;
+        int32 ClimbableTriangle = INDEX_NONE;
+        int32 Region = INDEX_NONE;
+        uint8 Tests = 0;
+    };
+
+    struct FBoundaryEdge
+    {
+        FVector Start;
+        FVector End;
+        int32 ClimbableTriangle = INDEX_NONE;
+    };
+
+    static FIntPoint GetCellKey(const FVector &Location, float CellSize)
+    {
+        return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+    }
+
+    static bool TraceHit(const UWorld &World, const FSettings &Settings, FInstanceResult &Result, const FVector &Start, const FVector &End)
+    {
+        Result.NumQueries.Increment();
+
+        FHitResult Hit;
+        return World.LineTraceSingleByObjectType(
+            Hit,
+            Start,
+            End,
+            Settings.ObjectQueryParams,
+            FCollisionQueryParams(SCENE_QUERY_STAT(ClimbabilityAnalysis), false));
+    }
+
+    // Character hanging on the wall just below the ledge, same traces as CanStartClimbing + CheckHasReachedLedge
+    static bool CanClimbUpLedgeAt(const UWorld &World, const FSettings &Settings, FInstanceResult &Result, const FVector &EdgePoint, const FVector &Outward)
+    {
+        const FVector Forward = -Outward;
+        const FVector ComponentLocation =
+            EdgePoint + Outward * Settings.CapsuleRadius -
+            FVector::UpVector * (Settings.BaseEyeHeight + ClimbSurfaceRules::LedgeTraceStartOffset - 10.f);
+
+        const FVector EyeStart = ComponentLocation + FVector::UpVector * Settings.BaseEyeHeight;
+        if (!TraceHit(World, Settings, Result, EyeStart, EyeStart + Forward * ClimbSurfaceRules::EyeHeightTraceDistance))
+            return false;
+
+        const FVector LedgeStart = EyeStart + FVector::UpVector * ClimbSurfaceRules::LedgeTraceStartOffset;
+        const FVector LedgeEnd = LedgeStart + Forward * ClimbSurfaceRules::EyeHeightTraceDistance;
+        if (TraceHit(World, Settings, Result, LedgeStart, LedgeEnd))
+            return false;
+
+        return TraceHit(World, Settings, Result, LedgeEnd, LedgeEnd - FVector::UpVector * ClimbSurfaceRules::LedgeWalkableTraceDepth);
+    }
+
+    // Character standing on top facing over the edge, same traces as CanClimbDownLedge
+    static bool CanClimbDownLedgeAt(const UWorld &World, const FSettings &Settings, FInstanceResult &Result, const FVector &EdgePoint, const FVector &Outward)
+    {
+        const FVector Forward = Outward;
+        const FVector ComponentLocation =
+            EdgePoint - Forward * (Settings.ClimbDownWalkableSurfaceTraceOffset + 5.f) +
+            FVector::UpVector * Settings.StandingHalfHeight;
+
+        const FVector WalkableStart = ComponentLocation + Forward * Settings.ClimbDownWalkableSurfaceTraceOffset;
+        if (!TraceHit(World, Settings, Result, WalkableStart, WalkableStart - FVector::UpVector * ClimbSurfaceRules::ClimbDownWalkableTraceDepth))
+            return false;
+
+        const FVector LedgeStart = WalkableStart + Forward * Settings.ClimbDownLedgeTraceOffset;
+        return !TraceHit(World, Settings, Result, LedgeStart, LedgeStart - FVector::UpVector * ClimbSurfaceRules::ClimbDownLedgeTraceDepth);
+    }
+
+    // Character standing on the ground in front of the obstacle, same traces as CanStartVaulting
+    static bool CanVaultAt(const UWorld &World, const FSettings &Settings, FInstanceResult &Result, const FVector &EdgePoint, const FVector &Outward)
+    {
+        const FVector Forward = -Outward;
+        const FVector GroundProbeStart = EdgePoint + Outward * (ClimbSurfaceRules::VaultTraceStep - 10.f);
+
+        FHitResult GroundHit;
+        Result.NumQueries.Increment();
+        const bool bHasGround = World.LineTraceSingleByObjectType(
+            GroundHit,
+            GroundProbeStart,
+            GroundProbeStart - FVector::UpVector * ClimbSurfaceRules::ClimbDownLedgeTraceDepth,
+            Settings.ObjectQueryParams,
+            FCollisionQueryParams(SCENE_QUERY_STAT(ClimbabilityAnalysis), false));
+
+        if (!bHasGround)
+            return false;
+
+        const FVector ComponentLocation = GroundHit.ImpactPoint + FVector::UpVector * Settings.StandingHalfHeight;
+
+        bool bHasStart = false;
+        bool bHasLand = false;
+        for (int32 i = 0; i < 2; i++)
+        {
+            const FVector Start = ComponentLocation + FVector::UpVector * ClimbSurfaceRules::VaultTraceHeight +
+                                  Forward * ClimbSurfaceRules::VaultTraceStep * (i + 1);
+            const FVector End = Start - FVector::UpVector * ClimbSurfaceRules::VaultTraceStep * (i + 1);
+
+            const bool bHit = TraceHit(World, Settings, Result, Start, End);
+            bHasStart |= (i == 0 && bHit);
+            bHasLand |= (i == 1 && bHit);
+        }
+
+        return bHasStart && bHasLand;
+    }
+
+    // Ground in reach at the bottom of a wall region, so a grounded character passes CanStartClimbing there
+    static bool HasFloorAccessAt(const UWorld &World, const FSettings &Settings, FInstanceResult &Result, const FVector &LowestPoint, const FVector &Outward)
+    {
+        const FVector Start = LowestPoint + Outward * (Settings.CapsuleRadius + 10.f) + FVector::UpVector * 10.f;
+        const FVector End = Start - FVector::UpVector * (Settings.StandingHalfHeight + Settings.BaseEyeHeight + 10.f);
+        return TraceHit(World, Settings, Result, Start, End);
+    }
+
+    static int32 FindRoot(TArray<int32> &Parents, int32 Index)
+    {
+        while (Parents[Index] != Index)
+        {
+            Parents[Index] = Parents[Parents[Index]];
+            Index = Parents[Index];
+        }
+        return Index;
+    }
+
+    static void AddAreaToCells(FInstanceResult &Result, const FTriangle &Triangle, float CellSize)
+    {
+        // Split large triangles so their area spreads over every cell they cover
+        const float LongestEdge = FMath::Max3((Triangle.B - Triangle.A).Size(), (Triangle.C - Triangle.B).Size(), (Triangle.A - Triangle.C).Size());
+        const int32 Subdivisions = FMath::Clamp(FMath::CeilToInt(LongestEdge / CellSize), 1, 64);
+        const float SubArea = Triangle.Area / (Subdivisions * Subdivisions);
+
+        for (int32 i = 0; i < Subdivisions; ++i)
+        {
+            for (int32 j = 0; j < Subdivisions - i; ++j)
+            {
+                // Upward and downward sub-triangles of the barycentric grid, both centroids weighted equally
+                const float U = (i + 1.f / 3.f) / Subdivisions;
+                const float V = (j + 1.f / 3.f) / Subdivisions;
+                const int32 SubTriangles = (j < Subdivisions - i - 1) ? 2 : 1;
+                const FVector SamplePoint = Triangle.A + (Triangle.B - Triangle.A) * U + (Triangle.C - Triangle.A) * V;
+
+                FCell &Cell = Result.Cells.FindOrAdd(GetCellKey(SamplePoint, CellSize));
+                if (Triangle.bClimbable)
+                {
+                    Cell.ClimbableArea += SubArea * SubTriangles;
+                }
+                else if (Triangle.bWalkable)
+                {
+                    Cell.WalkableArea += SubArea * SubTriangles;
+                }
+            }
+        }
+    }
+
+    static void AnalyzeInstance(const UWorld &World, const FSettings &Settings, const FMeshInstance &Instance, const FClimbMeshGeometry &Geometry, FInstanceResult &Result)
+    {
+        const int32 NumTriangles = Geometry.Indices.Num() / 3;
+        Result.NumTriangles = NumTriangles;
+
+        if (NumTriangles == 0)
+            return;
+
+        TArray<FTriangle> Triangles;
+        Triangles.SetNum(NumTriangles);
+
+        ParallelFor(NumTriangles, [&](int32 TriangleIndex)
+        {
+            FTriangle &Triangle = Triangles[TriangleIndex];
+            const int32 I0 = Geometry.Indices[TriangleIndex * 3];
+            const int32 I1 = Geometry.Indices[TriangleIndex * 3 + 1];
+            const int32 I2 = Geometry.Indices[TriangleIndex * 3 + 2];
+
+            Triangle.A = Instance.Transform.TransformPosition(FVector(Geometry.Positions[I0]));
+            Triangle.B = Instance.Transform.TransformPosition(FVector(Geometry.Positions[I1]));
+            Triangle.C = Instance.Transform.TransformPosition(FVector(Geometry.Positions[I2]));
+            Triangle.Centroid = (Triangle.A + Triangle.B + Triangle.C) / 3.f;
+
+            const FVector Cross = FVector::CrossProduct(Triangle.B - Triangle.A, Triangle.C - Triangle.A);
+            Triangle.Area = Cross.Size() * 0.5f;
+            Triangle.Normal = Cross.GetSafeNormal();
+
+            // Winding is not reliable under mirrored transforms, orient by the authored vertex normals
+            const FVector VertexNormal = Instance.Transform.TransformVectorNoScale(
+                FVector(Geometry.VertexNormals[I0] + Geometry.VertexNormals[I1] + Geometry.VertexNormals[I2]));
+            if (FVector::DotProduct(Triangle.Normal, VertexNormal) < 0.f)
+            {
+                Triangle.Normal = -Triangle.Normal;
+            }
+
+            Triangle.bClimbable = ClimbSurfaceRules::IsClimbableSurfaceNormal(Triangle.Normal);
+            Triangle.bWalkable = !Triangle.bClimbable && Triangle.Normal.Z > 0.f;
+        });
+
+        TMap<uint64, FEdge> Edges;
+        Edges.Reserve(NumTriangles * 3 / 2);
+
+        for (int32 TriangleIndex = 0; TriangleIndex < NumTriangles; ++TriangleIndex)
+        {
+            for (int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                const int32 V0 = Geometry.Indices[TriangleIndex * 3 + Corner];
+                const int32 V1 = Geometry.Indices[TriangleIndex * 3 + (Corner + 1) % 3];
+                const uint64 Key = (uint64(FMath::Min(V0, V1)) << 32) | uint64(FMath::Max(V0, V1));
+
+                FEdge &Edge = Edges.FindOrAdd(Key);
+                if (Edge.Triangles[0] == INDEX_NONE)
+                {
+                    Edge.V0 = V0;
+                    Edge.V1 = V1;
+                    Edge.Triangles[0] = TriangleIndex;
+                }
+                else if (Edge.Triangles[1] == INDEX_NONE)
+                {
+                    Edge.Triangles[1] = TriangleIndex;
+                }
+            }
+        }
+
+        // Connected climbable regions
+        TArray<int32> Parents;
+        Parents.SetNumUninitialized(NumTriangles);
+        for (int32 TriangleIndex = 0; TriangleIndex < NumTriangles; ++TriangleIndex)
+        {
+            Parents[TriangleIndex] = TriangleIndex;
+        }
+
+        TArray<FEdgeCandidate> Candidates;
+        TArray<FBoundaryEdge> BoundaryEdges;
+
+        for (const TPair<uint64, FEdge> &EdgePair : Edges)
+        {
+            const FEdge &Edge = EdgePair.Value;
+            const FTriangle &First = Triangles[Edge.Triangles[0]];
+            const FTriangle *Second = Edge.Triangles[1] != INDEX_NONE ? &Triangles[Edge.Triangles[1]] : nullptr;
+
+            if (Second && First.bClimbable && Second->bClimbable)
+            {
+                Parents[FindRoot(Parents, Edge.Triangles[0])] = FindRoot(Parents, Edge.Triangles[1]);
+                continue;
+            }
+
+            FEdgeCandidate Candidate;
+            Candidate.Start = Instance.Transform.TransformPosition(FVector(Geometry.Positions[Edge.V0]));
+            Candidate.End = Instance.Transform.TransformPosition(FVector(Geometry.Positions[Edge.V1]));
+
+            if (!Second && First.bClimbable)
+            {
+                BoundaryEdges.Add({Candidate.Start, Candidate.End, Edge.Triangles[0]});
+            }
+
+            const FVector EdgeMid = (Candidate.Start + Candidate.End) * 0.5f;
+            const FVector EdgeDirection = (Candidate.End - Candidate.Start).GetSafeNormal();
+
+            // Ledges are roughly horizontal edges
+            if (FMath::Abs(EdgeDirection.Z) > 0.5f)
+                continue;
+
+            const FTriangle *Wall = First.bClimbable ? &First : (Second && Second->bClimbable ? Second : nullptr);
+            const FTriangle *Top = First.bWalkable ? &First : (Second && Second->bWalkable ? Second : nullptr);
+
+            if (Wall)
+            {
+                // Top edge of a wall, either shared with the walkable top or open to another mesh
+                if (EdgeMid.Z < Wall->Centroid.Z || (Second && !Top))
+                    continue;
+
+                Candidate.Outward = FVector(Wall->Normal.X, Wall->Normal.Y, 0.f).GetSafeNormal();
+                Candidate.ClimbableTriangle = Wall == &First ? Edge.Triangles[0] : Edge.Triangles[1];
+                Candidate.Tests = Test_ClimbUp | Test_Vault | Test_ClimbDown;
+            }
+            else if (Top && !Second)
+            {
+                // Open boundary of a walkable surface, the drop continues on another mesh or into the void
+                const FVector ToEdge = EdgeMid - Top->Centroid;
+                Candidate.Outward = (ToEdge - EdgeDirection * FVector::DotProduct(ToEdge, EdgeDirection)).GetSafeNormal2D();
+                Candidate.Tests = Test_ClimbDown;
+            }
+
+            if (Candidate.Tests != 0 && !Candidate.Outward.IsNearlyZero())
+            {
+                Candidates.Add(Candidate);
+            }
+        }
+
+        struct FRegion
+        {
+            FVector LowestPoint = FVector(0.f, 0.f, TNumericLimits<float>::Max());
+            FVector LowestOutward = FVector::ZeroVector;
+        };
+
+        // Regions are indexed densely by their union-find root, the array is final before the candidate tests run
+        TMap<int32, int32> RegionIndices;
+        TArray<FRegion> Regions;
+
+        for (int32 TriangleIndex = 0; TriangleIndex < NumTriangles; ++TriangleIndex)
+        {
+            const FTriangle &Triangle = Triangles[TriangleIndex];
+            AddAreaToCells(Result, Triangle, Settings.CellSize);
+
+            if (!Triangle.bClimbable)
+                continue;
+
+            const int32 Root = FindRoot(Parents, TriangleIndex);
+            int32 &RegionIndex = RegionIndices.FindOrAdd(Root, INDEX_NONE);
+            if (RegionIndex == INDEX_NONE)
+            {
+                RegionIndex = Regions.AddDefaulted();
+                Result.Regions.AddDefaulted_GetRef().Label = Instance.Label;
+            }
+
+            FRegion &Region = Regions[RegionIndex];
+            FRegionPiece &Piece = Result.Regions[RegionIndex];
+            Piece.Area += Triangle.Area;
+            Piece.WeightedCenter += Triangle.Centroid * Triangle.Area;
+
+            for (const FVector &Corner : {Triangle.A, Triangle.B, Triangle.C})
+            {
+                if (Corner.Z < Region.LowestPoint.Z)
+                {
+                    Region.LowestPoint = Corner;
+                    Region.LowestOutward = FVector(Triangle.Normal.X, Triangle.Normal.Y, 0.f).GetSafeNormal();
+                }
+            }
+        }
+
+        for (FEdgeCandidate &Candidate : Candidates)
+        {
+            if (Candidate.ClimbableTriangle != INDEX_NONE)
+            {
+                Candidate.Region = RegionIndices.FindChecked(FindRoot(Parents, Candidate.ClimbableTriangle));
+            }
+        }
+
+        struct FCandidateResult
+        {
+            TArray<FVector> Ledges;
+            TArray<FVector> ClimbDowns;
+            TArray<FVector> Vaults;
+            bool bHasLedge = false;
+            bool bHasEntry = false;
+        };
+
+        TArray<FCandidateResult> CandidateResults;
+        CandidateResults.SetNum(Candidates.Num());
+
+        ParallelFor(Candidates.Num(), [&](int32 CandidateIndex)
+        {
+            const FEdgeCandidate &Candidate = Candidates[CandidateIndex];
+            FCandidateResult &CandidateResult = CandidateResults[CandidateIndex];
+
+            const float EdgeLength = (Candidate.End - Candidate.Start).Size();
+            const int32 NumSamples = FMath::Max(1, FMath::FloorToInt(EdgeLength / Settings.SampleSpacing));
+
+            for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+            {
+                const FVector EdgePoint = FMath::Lerp(Candidate.Start, Candidate.End, (SampleIndex + 0.5f) / NumSamples);
+
+                if ((Candidate.Tests & Test_ClimbUp) && CanClimbUpLedgeAt(World, Settings, Result, EdgePoint, Candidate.Outward))
+                {
+                    CandidateResult.Ledges.Add(EdgePoint);
+                    CandidateResult.bHasLedge = true;
+                    CandidateResult.bHasEntry = true;
+                }
+
+                if ((Candidate.Tests & Test_ClimbDown) && CanClimbDownLedgeAt(World, Settings, Result, EdgePoint, Candidate.Outward))
+                {
+                    CandidateResult.ClimbDowns.Add(EdgePoint);
+                    CandidateResult.bHasEntry = true;
+                }
+
+                if ((Candidate.Tests & Test_Vault) && CanVaultAt(World, Settings, Result, EdgePoint, Candidate.Outward))
+                {
+                    CandidateResult.Vaults.Add(EdgePoint);
+                }
+            }
+        });
+
+        for (int32 CandidateIndex = 0; CandidateIndex < Candidates.Num(); ++CandidateIndex)
+        {
+            const FCandidateResult &CandidateResult = CandidateResults[CandidateIndex];
+
+            if (Candidates[CandidateIndex].Region != INDEX_NONE)
+            {
+                FRegionPiece &Piece = Result.Regions[Candidates[CandidateIndex].Region];
+                Piece.bHasLedge |= CandidateResult.bHasLedge;
+                Piece.bHasEntry |= CandidateResult.bHasEntry;
+            }
+
+            for (const FVector &Point : CandidateResult.Ledges)
+            {
+                Result.Cells.FindOrAdd(GetCellKey(Point, Settings.CellSize)).LedgeSamples++;
+            }
+            for (const FVector &Point : CandidateResult.ClimbDowns)
+            {
+                Result.Cells.FindOrAdd(GetCellKey(Point, Settings.CellSize)).ClimbDownSamples++;
+            }
+            for (const FVector &Point : CandidateResult.Vaults)
+            {
+                Result.Cells.FindOrAdd(GetCellKey(Point, Settings.CellSize)).VaultSamples++;
+            }
+        }
+
+        for (const FBoundaryEdge &Edge : BoundaryEdges)
+        {
+            const int32 NumPoints = FMath::Clamp(FMath::CeilToInt((Edge.End - Edge.Start).Size() / Settings.ConnectTolerance), 1, 256);
+            FRegionPiece &Piece = Result.Regions[RegionIndices.FindChecked(FindRoot(Parents, Edge.ClimbableTriangle))];
+
+            for (int32 PointIndex = 0; PointIndex <= NumPoints; ++PointIndex)
+            {
+                Piece.BoundaryPoints.Add(FMath::Lerp(Edge.Start, Edge.End, float(PointIndex) / NumPoints));
+            }
+        }
+
+        // A wall piece standing on the floor can be entered from it, whichever mesh it ends up joined with
+        for (int32 RegionIndex = 0; RegionIndex < Regions.Num(); ++RegionIndex)
+        {
+            FRegionPiece &Piece = Result.Regions[RegionIndex];
+            if (!Piece.bHasEntry && HasFloorAccessAt(World, Settings, Result, Regions[RegionIndex].LowestPoint, Regions[RegionIndex].LowestOutward))
+            {
+                Piece.bHasEntry = true;
+            }
+        }
+    }
+
+    // Joins the region pieces of touching meshes in world space and flags the joined regions without an entry or a ledge
+    static void FlagRegions(const FSettings &Settings, TArray<FRegionPiece> &Pieces, TMap<FIntPoint, FCell> &Cells, TArray<FFlaggedRegion> &OutFlagged)
+    {
+        TArray<int32> Parents;
+        Parents.SetNumUninitialized(Pieces.Num());
+        for (int32 PieceIndex = 0; PieceIndex < Pieces.Num(); ++PieceIndex)
+        {
+            Parents[PieceIndex] = PieceIndex;
+        }
+
+        // Boundary points closer than a cell join their pieces, the cells are ConnectTolerance wide so the neighbours cover it
+        TMap<FIntVector, int32> BoundaryCells;
+
+        for (int32 PieceIndex = 0; PieceIndex < Pieces.Num(); ++PieceIndex)
+        {
+            for (const FVector &Point : Pieces[PieceIndex].BoundaryPoints)
+            {
+                const FIntVector Key(
+                    FMath::FloorToInt(Point.X / Settings.ConnectTolerance),
+                    FMath::FloorToInt(Point.Y / Settings.ConnectTolerance),
+                    FMath::FloorToInt(Point.Z / Settings.ConnectTolerance));
+
+                for (int32 X = -1; X <= 1; ++X)
+                {
+                    for (int32 Y = -1; Y <= 1; ++Y)
+                    {
+                        for (int32 Z = -1; Z <= 1; ++Z)
+                        {
+                            if (const int32 *Other = BoundaryCells.Find(Key + FIntVector(X, Y, Z)))
+                            {
+                                Parents[FindRoot(Parents, *Other)] = FindRoot(Parents, PieceIndex);
+                            }
+                        }
+                    }
+                }
+
+                BoundaryCells.FindOrAdd(Key, PieceIndex);
+            }
+
+            Pieces[PieceIndex].BoundaryPoints.Empty();
+        }
+
+        TMap<int32, FRegionPiece> Joined;
+        TMap<int32, float> LargestPieceAreas;
+
+        for (int32 PieceIndex = 0; PieceIndex < Pieces.Num(); ++PieceIndex)
+        {
+            const FRegionPiece &Piece = Pieces[PieceIndex];
+            const int32 Root = FindRoot(Parents, PieceIndex);
+
+            FRegionPiece &Region = Joined.FindOrAdd(Root);
+            Region.Area += Piece.Area;
+            Region.WeightedCenter += Piece.WeightedCenter;
+            Region.bHasLedge |= Piece.bHasLedge;
+            Region.bHasEntry |= Piece.bHasEntry;
+
+            // Named after its largest piece
+            float &LargestPieceArea = LargestPieceAreas.FindOrAdd(Root, 0.f);
+            if (Piece.Area > LargestPieceArea)
+            {
+                LargestPieceArea = Piece.Area;
+                Region.Label = Piece.Label;
+            }
+        }
+
+        for (const TPair<int32, FRegionPiece> &RegionPair : Joined)
+        {
+            const FRegionPiece &Region = RegionPair.Value;
+            if (Region.Area < Settings.MinRegionArea || (Region.bHasEntry && Region.bHasLedge))
+                continue;
+
+            FFlaggedRegion &Flagged = OutFlagged.AddDefaulted_GetRef();
+            Flagged.Label = Region.Label;
+            Flagged.Center = Region.WeightedCenter / Region.Area;
+            Flagged.Area = Region.Area;
+            Flagged.bUnreachable = !Region.bHasEntry;
+
+            FCell &Cell = Cells.FindOrAdd(GetCellKey(Flagged.Center, Settings.CellSize));
+            if (Flagged.bUnreachable)
+            {
+                Cell.UnreachableRegions++;
+            }
+            else
+            {
+                Cell.DeadEndRegions++;
+            }
+        }
+    }
+
+    static bool LoadSettings(const FString &Params, FSettings &OutSettings)
+    {
+        const UCustomMovementComponent *MovementComponent;
+        const ACharacter *CharacterCDO = ClimbCommandletHelpers::LoadClimbingCharacter(Params, MovementComponent);
+        if (!CharacterCDO)
+            return false;
+
+        OutSettings.ObjectQueryParams = FCollisionObjectQueryParams(MovementComponent->GetClimbableSurfaceTraceTypes());
+        OutSettings.BaseEyeHeight = CharacterCDO->BaseEyeHeight;
+        OutSettings.StandingHalfHeight = CharacterCDO->GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight();
+        OutSettings.CapsuleRadius = CharacterCDO->GetCapsuleComponent()->GetUnscaledCapsuleRadius();
+        OutSettings.ClimbDownWalkableSurfaceTraceOffset = MovementComponent->GetClimbDownWalkableSurfaceTraceOffset();
+        OutSettings.ClimbDownLedgeTraceOffset = MovementComponent->GetClimbDownLedgeTraceOffset();
+
+        FParse::Value(*Params, TEXT("CellSize="), OutSettings.CellSize);
+        FParse::Value(*Params, TEXT("SampleSpacing="), OutSettings.SampleSpacing);
+        FParse::Value(*Params, TEXT("RegionSize="), OutSettings.RegionSize);
+        FParse::Value(*Params, TEXT("RegionMargin="), OutSettings.RegionMargin);
+        FParse::Value(*Params, TEXT("ConnectTolerance="), OutSettings.ConnectTolerance);
+
+        float MinRegionAreaM2 = OutSettings.MinRegionArea / 10000.f;
+        FParse::Value(*Params, TEXT("MinRegionArea="), MinRegionAreaM2);
+        OutSettings.MinRegionArea = MinRegionAreaM2 * 10000.f;
+
+        OutSettings.CellSize = FMath::Max(OutSettings.CellSize, 10.f);
+        OutSettings.SampleSpacing = FMath::Max(OutSettings.SampleSpacing, 10.f);
+        OutSettings.RegionSize = FMath::Max(OutSettings.RegionSize, 1000.f);
+        OutSettings.RegionMargin = FMath::Max(OutSettings.RegionMargin, 0.f);
+        OutSettings.ConnectTolerance = FMath::Max(OutSettings.ConnectTolerance, 1.f);
+        return true;
+    }
+
+    // IsOwned decides from an instance's bounds center whether the current region analyzes it, so instances loaded by several regions count once
+    static void GatherMeshInstances(UWorld &World, const FSettings &Settings, TFunctionRef<bool(const FVector &)> IsOwned, TArray<FMeshInstance> &OutInstances)
+    {
+        for (TActorIterator<AActor> It(&World); It; ++It)
+        {
+            TInlineComponentArray<UStaticMeshComponent *> MeshComponents(*It);
+
+            for (UStaticMeshComponent *MeshComponent : MeshComponents)
+            {
+                if (!MeshComponent->GetStaticMesh() || !MeshComponent->IsQueryCollisionEnabled())
+                    continue;
+
+                if (!(Settings.ObjectQueryParams.GetQueryBitfield() & ECC_TO_BITFIELD(MeshComponent->GetCollisionObjectType())))
+                    continue;
+
+                const FString Label = It->GetActorNameOrLabel();
+                const FVector MeshCenter = MeshComponent->GetStaticMesh()->GetBounds().Origin;
+
+                if (const UInstancedStaticMeshComponent *InstancedComponent = Cast<UInstancedStaticMeshComponent>(MeshComponent))
+                {
+                    for (int32 InstanceIndex = 0; InstanceIndex < InstancedComponent->GetInstanceCount(); ++InstanceIndex)
+                    {
+                        FTransform InstanceTransform;
+                        InstancedComponent->GetInstanceTransform(InstanceIndex, InstanceTransform, true);
+                        if (!IsOwned(InstanceTransform.TransformPosition(MeshCenter)))
+                            continue;
+
+                        FMeshInstance &Instance = OutInstances.AddDefaulted_GetRef();
+                        Instance.StaticMesh = InstancedComponent->GetStaticMesh();
+                        Instance.Transform = InstanceTransform;
+                        Instance.Label = FString::Printf(TEXT("%s[%d]"), *Label, InstanceIndex);
+                    }
+                }
+                else if (IsOwned(MeshComponent->GetComponentTransform().TransformPosition(MeshCenter)))
+                {
+                    FMeshInstance &Instance = OutInstances.AddDefaulted_GetRef();
+                    Instance.StaticMesh = MeshComponent->GetStaticMesh();
+                    Instance.Transform = MeshComponent->GetComponentTransform();
+                    Instance.Label = Label;
+                }
+            }
+        }
+    }
+
+    // Analyzes the loaded instances IsOwned accepts and adds them to the totals, the region pieces are joined once every region is done
+    static void AnalyzeLoadedInstances(UWorld &World, const FSettings &Settings, TFunctionRef<bool(const FVector &)> IsOwned, FAnalysis &Analysis)
+    {
+        TArray<FMeshInstance> Instances;
+        GatherMeshInstances(World, Settings, IsOwned, Instances);
+
+        if (Instances.IsEmpty())
+            return;
+
+        // Geometry outlives the region that loaded its mesh, keyed by path since the mesh itself may be collected in between
+        TArray<const UStaticMesh *> NewMeshes;
+        for (FMeshInstance &Instance : Instances)
+        {
+            int32 &GeometryIndex = Analysis.GeometryIndices.FindOrAdd(FSoftObjectPath(Instance.StaticMesh), INDEX_NONE);
+            if (GeometryIndex == INDEX_NONE)
+            {
+                GeometryIndex = Analysis.Geometries.AddDefaulted();
+                NewMeshes.Add(Instance.StaticMesh);
+            }
+            Instance.GeometryIndex = GeometryIndex;
+        }
+
+        const int32 FirstNewGeometry = Analysis.Geometries.Num() - NewMeshes.Num();
+        ParallelFor(NewMeshes.Num(), [&](int32 MeshIndex)
+        {
+            Analysis.Geometries[FirstNewGeometry + MeshIndex].Build(*NewMeshes[MeshIndex]);
+        });
+
+        TArray<FInstanceResult> Results;
+        Results.SetNum(Instances.Num());
+
+        ParallelFor(Instances.Num(), [&](int32 InstanceIndex)
+        {
+            const FMeshInstance &Instance = Instances[InstanceIndex];
+            const FClimbMeshGeometry &Geometry = Analysis.Geometries[Instance.GeometryIndex];
+            AnalyzeInstance(World, Settings, Instance, Geometry, Results[InstanceIndex]);
+        });
+
+        for (FInstanceResult &Result : Results)
+        {
+            for (const TPair<FIntPoint, FCell> &CellPair : Result.Cells)
+            {
+                Analysis.Cells.FindOrAdd(CellPair.Key).Merge(CellPair.Value);
+            }
+
+            Analysis.Regions.Append(MoveTemp(Result.Regions));
+            Analysis.NumTriangles += Result.NumTriangles;
+            Analysis.NumQueries += Result.NumQueries.GetValue();
+        }
+
+        Analysis.NumInstances += Instances.Num();
+    }
+
+    static bool WriteReport(const FString &OutputPath, const FString &MapName, const FSettings &Settings, FAnalysis &Analysis, const TArray<FFlaggedRegion> &FlaggedRegions, double Seconds)
+    {
+        TMap<FIntPoint, FCell> &Cells = Analysis.Cells;
+        int32 NumDeadEnds = 0;
+        int32 NumUnreachable = 0;
+
+        Cells.KeySort([](const FIntPoint &A, const FIntPoint &B)
+        {
+            return A.Y != B.Y ? A.Y < B.Y : A.X < B.X;
+        });
+
+        TArray<FString> Lines;
+        Lines.Add(FString::Printf(TEXT("# ClimbabilityAnalysis Map=%s CellSize=%.0f SampleSpacing=%.0f"), *MapName, Settings.CellSize, Settings.SampleSpacing));
+        Lines.Add(TEXT("# Cell,X,Y,ClimbableM2,WalkableM2,Ledges,ClimbDowns,Vaults,DeadEnds,Unreachable"));
+
+        for (const TPair<FIntPoint, FCell> &CellPair : Cells)
+        {
+            const FCell &Cell = CellPair.Value;
+            Lines.Add(FString::Printf(TEXT("Cell,%d,%d,%.2f,%.2f,%d,%d,%d,%d,%d"),
+                CellPair.Key.X, CellPair.Key.Y,
+                Cell.ClimbableArea / 10000.f, Cell.WalkableArea / 10000.f,
+                Cell.LedgeSamples, Cell.ClimbDownSamples, Cell.VaultSamples,
+                Cell.DeadEndRegions, Cell.UnreachableRegions));
+        }
+
+        Lines.Add(TEXT("# Region,Kind,Actor,X,Y,Z,AreaM2"));
+
+        for (const FFlaggedRegion &Region : FlaggedRegions)
+        {
+            Lines.Add(FString::Printf(TEXT("Region,%s,%s,%.0f,%.0f,%.0f,%.2f"),
+                Region.bUnreachable ? TEXT("Unreachable") : TEXT("DeadEnd"),
+                *Region.Label,
+                Region.Center.X, Region.Center.Y, Region.Center.Z,
+                Region.Area / 10000.f));
+
+            if (Region.bUnreachable)
+            {
+                ++NumUnreachable;
+            }
+            else
+            {
+                ++NumDeadEnds;
+            }
+        }
+
+        Lines.Add(FString::Printf(TEXT("# Summary Instances=%d Triangles=%lld Queries=%lld DeadEnds=%d Unreachable=%d Seconds=%.1f"),
+            Analysis.NumInstances, Analysis.NumTriangles, Analysis.NumQueries, NumDeadEnds, NumUnreachable, Seconds));
+
+        UE_LOG(LogClimbing, Display, TEXT("%s"), *Lines.Last());
+
+        return FFileHelper::SaveStringArrayToFile(Lines, *OutputPath);
+    }
+}
+
+UClimbabilityAnalysisCommandlet::UClimbabilityAnalysisCommandlet()
+{
+    IsClient = false;
+    IsEditor = true;
+    IsServer = false;
+    LogToConsole = true;
+}
+
+int32 UClimbabilityAnalysisCommandlet::Main(const FString &Params)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+#if WITH_EDITOR
+    using namespace ClimbabilityAnalysis;
+
+    FString MapName;
+    if (!FParse::Value(*Params, TEXT("Map="), MapName))
+    {
+        UE_LOG(LogClimbing, Error, TEXT("Missing -Map=<package path>"));
+        return 1;
+    }
+
+    FSettings Settings;
+    if (!LoadSettings(Params, Settings))
+        return 1;
+
+    UPackage *MapPackage = LoadPackage(nullptr, *MapName, LOAD_None);
+    UWorld *World = MapPackage ? UWorld::FindWorldInPackage(MapPackage) : nullptr;
+
+    if (!World)
+    {
+        UE_LOG(LogClimbing, Error, TEXT("Could not load map %s"), *MapName);
+        return 1;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    World->WorldType = EWorldType::Editor;
+    World->AddToRoot();
+
+    if (!World->bIsWorldInitialized)
+    {
+        UWorld::InitializationValues InitValues;
+        InitValues
+            .RequiresHitProxies(false)
+            .ShouldSimulatePhysics(false)
+            .EnableTraceCollision(true)
+            .CreateNavigation(false)
+            .CreateAISystem(false)
+            .AllowAudioPlayback(false)
+            .CreatePhysicsScene(true);
+
+        World->InitWorld(InitValues);
+    }
+
+    FAnalysis Analysis;
+
+    if (UWorldPartition *WorldPartition = World->GetWorldPartition())
+    {
+        // One region at a time, loaded with a margin so the traces at its border see the neighbouring geometry
+        const FBox WorldBounds = WorldPartition->GetEditorWorldBounds();
+        const FIntPoint NumRegions = WorldBounds.IsValid
+            ? FIntPoint(
+                  FMath::Max(1, FMath::CeilToInt((WorldBounds.Max.X - WorldBounds.Min.X) / Settings.RegionSize)),
+                  FMath::Max(1, FMath::CeilToInt((WorldBounds.Max.Y - WorldBounds.Min.Y) / Settings.RegionSize)))
+            : FIntPoint::ZeroValue;
+
+        // Outside the bounds counts toward the closest region, so nothing loaded is left out
+        auto GetRegion = [&](const FVector &Location)
+        {
+            return FIntPoint(
+                FMath::Clamp(FMath::FloorToInt((Location.X - WorldBounds.Min.X) / Settings.RegionSize), 0, NumRegions.X - 1),
+                FMath::Clamp(FMath::FloorToInt((Location.Y - WorldBounds.Min.Y) / Settings.RegionSize), 0, NumRegions.Y - 1));
+        };
+
+        UE_LOG(LogClimbing, Display, TEXT("Analyzing %s in %dx%d regions"), *MapName, NumRegions.X, NumRegions.Y);
+
+        for (int32 RegionY = 0; RegionY < NumRegions.Y; ++RegionY)
+        {
+            for (int32 RegionX = 0; RegionX < NumRegions.X; ++RegionX)
+            {
+                const FIntPoint Region(RegionX, RegionY);
+                const FVector RegionMin(WorldBounds.Min.X + RegionX * Settings.RegionSize, WorldBounds.Min.Y + RegionY * Settings.RegionSize, WorldBounds.Min.Z);
+                const FBox RegionBox(RegionMin, FVector(RegionMin.X + Settings.RegionSize, RegionMin.Y + Settings.RegionSize, WorldBounds.Max.Z));
+
+                FLoaderAdapterShape Loader(World, RegionBox.ExpandBy(Settings.RegionMargin), TEXT("ClimbabilityAnalysis"));
+                Loader.Load();
+                World->UpdateWorldComponents(true, false);
+
+                AnalyzeLoadedInstances(*World, Settings, [&](const FVector &Center) { return GetRegion(Center) == Region; }, Analysis);
+
+                Loader.Unload();
+                CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+            }
+        }
+    }
+    else
+    {
+        World->LoadSecondaryLevels(true, nullptr);
+        World->UpdateWorldComponents(true, false);
+
+        AnalyzeLoadedInstances(*World, Settings, [](const FVector &) { return true; }, Analysis);
+    }
+
+    UE_LOG(LogClimbing, Display, TEXT("Analyzed %d mesh instances (%d unique meshes) in %s"), Analysis.NumInstances, Analysis.Geometries.Num(), *MapName);
+
+    TArray<FFlaggedRegion> FlaggedRegions;
+    FlagRegions(Settings, Analysis.Regions, Analysis.Cells, FlaggedRegions);
+
+    FString OutputPath = FPaths::ProjectSavedDir() / TEXT("ClimbAnalysis") / (FPackageName::GetShortName(MapName) + TEXT(".climbreport.csv"));
+    FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+    const bool bWritten = WriteReport(OutputPath, MapName, Settings, Analysis, FlaggedRegions, FPlatformTime::Seconds() - StartTime);
+
+    World->RemoveFromRoot();
+    World->DestroyWorld(false);
+
+    if (!bWritten)
+    {
+        UE_LOG(LogClimbing, Error, TEXT("Could not write %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogClimbing, Display, TEXT("Wrote %s"), *OutputPath);
+    return 0;
+#else
+    return 1;
+#endif
+}
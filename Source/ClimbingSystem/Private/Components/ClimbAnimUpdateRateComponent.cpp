@@ -0,0 +1,164 @@
+#include "Components/ClimbAnimUpdateRateComponent.h"
+#include "GameFramework/Character.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "SkeletalMeshComponentBudgeted.h"
+#include "IAnimationBudgetAllocator.h"
+#include "Kismet/GameplayStatics.h"
+#include "ClimbingSystem.h"
+
+UClimbAnimUpdateRateComponent::UClimbAnimUpdateRateComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UClimbAnimUpdateRateComponent::OnRegister()
+{
+    Super::OnRegister();
+
+    const ACharacter *OwnerCharacter = Cast<ACharacter>(GetOwner());
+    if (!OwnerCharacter)
+        return;
+
+    OwnerMesh = OwnerCharacter->GetMesh();
+    CustomMovementComponent = Cast<UCustomMovementComponent>(OwnerCharacter->GetCharacterMovement());
+
+    if (!OwnerMesh)
+        return;
+
+    // Must be decided before the mesh begins play, that is when it registers with the allocator
+    if (USkeletalMeshComponentBudgeted *BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(OwnerMesh))
+    {
+        BudgetedMesh->SetAutoRegisterWithBudgetAllocator(bUseAnimBudgetAllocator);
+        BudgetedMesh->SetAutoCalculateSignificance(false);
+    }
+
+    OwnerMesh->bEnableUpdateRateOptimizations = true;
+    OwnerMesh->OnAnimUpdateRateParamsCreated.BindUObject(this, &ThisClass::OnAnimUpdateRateParamsCreated);
+}
+
+void UClimbAnimUpdateRateComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    if (!OwnerMesh)
+        return;
+
+    // The mesh has to see this frame's climb phase before it decides whether to evaluate
+    if (CustomMovementComponent)
+    {
+        AddTickPrerequisiteComponent(CustomMovementComponent);
+    }
+    OwnerMesh->PrimaryComponentTick.AddPrerequisite(this, PrimaryComponentTick);
+
+    if (!UpdateRateParams && OwnerMesh->AnimUpdateRateParams)
+    {
+        OnAnimUpdateRateParamsCreated(OwnerMesh->AnimUpdateRateParams);
+    }
+}
+
+void UClimbAnimUpdateRateComponent::OnAnimUpdateRateParamsCreated(FAnimUpdateRateParameters *Params)
+{
+    UpdateRateParams = Params;
+
+    if (!UpdateRateParams)
+        return;
+
+    UpdateRateParams->bShouldUseLodMap = true;
+    UpdateRateParams->bInterpolateSkippedFrames = bInterpolateSkippedFrames;
+    bFrameSkipsDirty = true;
+    ApplyFrameSkips();
+}
+
+void UClimbAnimUpdateRateComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    if (!CustomMovementComponent)
+        return;
+
+    const EClimbPhase ClimbPhase = CustomMovementComponent->GetClimbPhase();
+
+    if (ClimbPhase != LastClimbPhase)
+    {
+        // Idle -> moving on the wall is the only change that does not start or end a transition
+        const bool bIsClimbIdleToggle =
+            (ClimbPhase == EClimbPhase::ClimbingIdle && LastClimbPhase == EClimbPhase::ClimbingMoving) ||
+            (ClimbPhase == EClimbPhase::ClimbingMoving && LastClimbPhase == EClimbPhase::ClimbingIdle);
+
+        if (!bIsClimbIdleToggle)
+        {
+            FullRateFramesRemaining = PhaseBoundaryFullRateFrames;
+        }
+
+        LastClimbPhase = ClimbPhase;
+        bFrameSkipsDirty = true;
+    }
+    else if (FullRateFramesRemaining > 0 && --FullRateFramesRemaining == 0)
+    {
+        bFrameSkipsDirty = true;
+    }
+
+    if (bUseAnimBudgetAllocator)
+    {
+        UpdateBudgetSignificance();
+    }
+    else
+    {
+        ApplyFrameSkips();
+    }
+}
+
+void UClimbAnimUpdateRateComponent::ApplyFrameSkips()
+{
+    if (!UpdateRateParams || !bFrameSkipsDirty || LODFrameSkips.IsEmpty())
+        return;
+
+    bFrameSkipsDirty = false;
+
+    const int32 NumLODs = FMath::Max(OwnerMesh->GetNumLODs(), LODFrameSkips.Num());
+
+    for (int32 LODIndex = 0; LODIndex < NumLODs; ++LODIndex)
+    {
+        int32 FrameSkip = LODFrameSkips[FMath::Min(LODIndex, LODFrameSkips.Num() - 1)];
+
+        if (FullRateFramesRemaining > 0 || LastClimbPhase == EClimbPhase::Traversal)
+        {
+            FrameSkip = 0;
+        }
+        else if (LastClimbPhase == EClimbPhase::ClimbingIdle)
+        {
+            FrameSkip = FMath::Max(FrameSkip, IdleClimbFrameSkip);
+        }
+
+        UpdateRateParams->LODToFrameSkipMap.Add(LODIndex, FrameSkip);
+    }
+}
+
+void UClimbAnimUpdateRateComponent::UpdateBudgetSignificance()
+{
+    USkeletalMeshComponentBudgeted *BudgetedMesh = Cast<USkeletalMeshComponentBudgeted>(OwnerMesh);
+    IAnimationBudgetAllocator *BudgetAllocator = IAnimationBudgetAllocator::Get(GetWorld());
+
+    if (!BudgetedMesh || !BudgetAllocator)
+        return;
+
+    float Significance = 1.f;
+
+    if (const APlayerCameraManager *CameraManager = UGameplayStatics::GetPlayerCameraManager(this, 0))
+    {
+        const float Distance = FVector::Dist(CameraManager->GetCameraLocation(), OwnerMesh->GetComponentLocation());
+        Significance = 1.f - FMath::Clamp(Distance / BudgetSignificanceDistance, 0.f, 1.f);
+    }
+
+    if (LastClimbPhase == EClimbPhase::ClimbingIdle)
+    {
+        Significance *= IdleClimbSignificanceScale;
+    }
+
+    const bool bNeverSkip = FullRateFramesRemaining > 0 || LastClimbPhase == EClimbPhase::Traversal;
+
+    BudgetAllocator->SetComponentSignificance(BudgetedMesh, Significance, bNeverSkip);
+}
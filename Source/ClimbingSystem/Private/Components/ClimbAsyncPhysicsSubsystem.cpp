@@ -0,0 +1,298 @@
+#include "Components/ClimbAsyncPhysicsSubsystem.h"
+#include "Components/ClimbSurfaceRules.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "Physics/GenericPhysicsInterface_Internal.h"
+#include "Components/PrimitiveComponent.h"
+#include "Chaos/Capsule.h"
+#include "PBDRigidsSolver.h"
+#include "Engine/World.h"
+#include "ClimbingSystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Climb Async Physics Step"), STAT_ClimbAsyncPhysicsStep, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Async Physics Climbers"), STAT_ClimbAsyncPhysicsClimbers, STATGROUP_Climbing);
+
+namespace
+{
+    // Same offsets as the game thread climb queries in UCustomMovementComponent
+    constexpr float ClimbSweepForwardOffset = 30.f;
+    constexpr float ClimbRotationInterpSpeed = 5.f;
+
+    FCollisionQueryParams MakeClimbQueryParams()
+    {
+        return FCollisionQueryParams(SCENE_QUERY_STAT(ClimbAsyncPhysics), false);
+    }
+
+    void SweepClimbCapsule(const UWorld *World, const FClimbAsyncClimberInput &Input, const FVector &Start, const FVector &End, TArray<FHitResult> &OutHits)
+    {
+        const Chaos::FCapsule Capsule(
+            FVector(0.f, 0.f, -Input.CapsuleTraceHalfHeight + Input.CapsuleTraceRadius),
+            FVector(0.f, 0.f, Input.CapsuleTraceHalfHeight - Input.CapsuleTraceRadius),
+            Input.CapsuleTraceRadius);
+
+        FGenericPhysicsInterface_Internal::GeomSweepMulti(World, Capsule, FQuat::Identity, OutHits, Start, End,
+            DefaultCollisionChannel, MakeClimbQueryParams(), FCollisionResponseParams::DefaultResponseParam, Input.ObjectQueryParams);
+    }
+
+    bool RaycastClimb(const UWorld *World, const FClimbAsyncClimberInput &Input, const FVector &Start, const FVector &End)
+    {
+        FHitResult Hit;
+        return FGenericPhysicsInterface_Internal::RaycastSingle(World, Hit, Start, End,
+            DefaultCollisionChannel, MakeClimbQueryParams(), FCollisionResponseParams::DefaultResponseParam, Input.ObjectQueryParams);
+    }
+}
+
+void FClimbAsyncPhysicsCallback::OnPreSimulate_Internal()
+{
+    LLM_SCOPE_BYTAG(Climbing);
+    SCOPE_CYCLE_COUNTER(STAT_ClimbAsyncPhysicsStep);
+
+    const FClimbAsyncInput *Input = GetConsumerInput_Internal();
+    if (!Input)
+        return;
+
+    for (int32 ClimberId : Input->RemovedClimbers)
+    {
+        ClimberStates.Remove(ClimberId);
+    }
+
+    if (Input->Climbers.IsEmpty() || !Input->World)
+        return;
+
+    INC_DWORD_STAT_BY(STAT_ClimbAsyncPhysicsClimbers, Input->Climbers.Num());
+
+    FClimbAsyncOutput &Output = GetProducerOutputData_Internal();
+    const float DeltaTime = GetDeltaTime_Internal();
+
+    for (const FClimbAsyncClimberInput &ClimberInput : Input->Climbers)
+    {
+        FClimberState &State = ClimberStates.FindOrAdd(ClimberInput.ClimberId);
+
+        // Several physics steps can consume the same input, only a new submission moves the climber back to the game thread transform
+        if (State.Serial != ClimberInput.Serial)
+        {
+            State.Serial = ClimberInput.Serial;
+            State.Location = ClimberInput.Location;
+            State.Rotation = ClimberInput.Rotation;
+            State.Velocity = ClimberInput.Velocity;
+        }
+
+        FClimbAsyncClimberOutput &ClimberOutput = Output.Climbers.AddDefaulted_GetRef();
+        StepClimber(Input->World, ClimberInput, State, DeltaTime, ClimberOutput);
+    }
+}
+
+void FClimbAsyncPhysicsCallback::StepClimber(const UWorld *World, const FClimbAsyncClimberInput &Input, FClimberState &State, float DeltaTime, FClimbAsyncClimberOutput &Output) const
+{
+    Output.ClimberId = Input.ClimberId;
+    Output.Serial = State.Serial;
+
+    const FVector Forward = State.Rotation.GetForwardVector();
+    const FVector Up = State.Rotation.GetUpVector();
+
+    TArray<FHitResult> Hits;
+    const FVector SweepStart = State.Location + Forward * ClimbSweepForwardOffset;
+    SweepClimbCapsule(World, Input, SweepStart, SweepStart + Forward, Hits);
+
+    if (Hits.IsEmpty())
+    {
+        Output.bShouldStop = true;
+        return;
+    }
+
+    // Components may be collected on the game thread meanwhile, so their pointers are copied here and never resolved
+    int32 ContactHitIndices[FClimbContactManifold::MaxContacts];
+    Output.Contacts.Num = FClimbContactManifold::SelectMostRelevantHits(Hits, State.Location, Forward, ContactHitIndices);
+
+    for (int32 i = 0; i < Output.Contacts.Num; ++i)
+    {
+        const FHitResult &Hit = Hits[ContactHitIndices[i]];
+        Output.Contacts.Positions[i] = Hit.ImpactPoint;
+        Output.Contacts.Normals[i] = Hit.ImpactNormal;
+        Output.Contacts.PrimitiveIds[i] = 0;
+        Output.ContactComponents[i] = Hit.Component;
+    }
+
+    // Same as UCustomMovementComponent::ProcessClimbableSurfaceInfo, averaging both faces of a corner gives a diagonal normal
+    FVector SurfaceLocation;
+    FVector SurfaceNormal;
+
+    if (Output.Contacts.FitCorner(Output.Corner, Input.CornerMinAngle) &&
+        ClimbSurfaceRules::IsClimbableSurfaceNormal(Output.Corner.Normals[0]) &&
+        ClimbSurfaceRules::IsClimbableSurfaceNormal(Output.Corner.Normals[1]))
+    {
+        const int32 Facing = Output.Corner.GetFacingPlane(Forward);
+        SurfaceLocation = Output.Corner.Points[Facing];
+        SurfaceNormal = Output.Corner.Normals[Facing];
+    }
+    else
+    {
+        Output.Corner.Reset();
+        SurfaceLocation = Output.Contacts.GetAverageLocation();
+        SurfaceNormal = Output.Contacts.GetAverageNormal();
+    }
+
+    Output.SurfaceLocation = SurfaceLocation;
+    Output.SurfaceNormal = SurfaceNormal;
+
+    if (!ClimbSurfaceRules::IsClimbableSurfaceNormal(SurfaceNormal))
+    {
+        Output.bShouldStop = true;
+        return;
+    }
+
+    const FVector FloorSweepStart = State.Location - Up * ClimbSurfaceRules::FloorTraceStartOffset;
+    Hits.Reset();
+    SweepClimbCapsule(World, Input, FloorSweepStart, FloorSweepStart - Up, Hits);
+
+    const bool bMovingDown = State.Rotation.UnrotateVector(State.Velocity).Z < -ClimbSurfaceRules::MinReachFloorSpeed;
+    for (const FHitResult &Hit : Hits)
+    {
+        if (bMovingDown && ClimbSurfaceRules::IsFloorSurfaceNormal(Hit.ImpactNormal))
+        {
+            Output.bReachedFloor = true;
+            return;
+        }
+    }
+
+    // CalcVelocity with no friction and fluid braking, as PhysClimb uses it
+    if (Input.Acceleration.IsNearlyZero())
+    {
+        const float Speed = State.Velocity.Size();
+        const float NewSpeed = FMath::Max(Speed - Input.BrakingDeceleration * DeltaTime, 0.f);
+        State.Velocity = Speed > UE_KINDA_SMALL_NUMBER ? State.Velocity * (NewSpeed / Speed) : FVector::ZeroVector;
+    }
+    else
+    {
+        State.Velocity = (State.Velocity + Input.Acceleration * DeltaTime).GetClampedToMaxSize(Input.MaxSpeed);
+    }
+
+    State.Location += State.Velocity * DeltaTime;
+
+    const FQuat TargetRotation = FRotationMatrix::MakeFromX(-SurfaceNormal).ToQuat();
+    State.Rotation = FMath::QInterpTo(State.Rotation, TargetRotation, DeltaTime, ClimbRotationInterpSpeed);
+
+    // SnapMovementToClimbableSurfaces
+    const FVector ProjectedCharacterToSurface = (SurfaceLocation - State.Location).ProjectOnTo(State.Rotation.GetForwardVector());
+    State.Location += -SurfaceNormal * ProjectedCharacterToSurface.Length() * DeltaTime * Input.MaxSpeed;
+
+    Output.Location = State.Location;
+    Output.Rotation = State.Rotation;
+    Output.Velocity = State.Velocity;
+
+    // CheckHasReachedLedge
+    const FVector EyeStart = State.Location + State.Rotation.GetUpVector() * (Input.BaseEyeHeight + ClimbSurfaceRules::LedgeTraceStartOffset);
+    const FVector EyeEnd = EyeStart + State.Rotation.GetForwardVector() * ClimbSurfaceRules::EyeHeightTraceDistance;
+
+    if (!RaycastClimb(World, Input, EyeStart, EyeEnd))
+    {
+        const FVector WalkableEnd = EyeEnd - State.Rotation.GetUpVector() * ClimbSurfaceRules::LedgeWalkableTraceDepth;
+
+        Output.bReachedLedge =
+            RaycastClimb(World, Input, EyeEnd, WalkableEnd) &&
+            State.Rotation.UnrotateVector(State.Velocity).Z > ClimbSurfaceRules::MinClimbUpLedgeSpeed;
+    }
+}
+
+bool UClimbAsyncPhysicsSubsystem::ShouldCreateSubsystem(UObject *Outer) const
+{
+    const UWorld *World = Cast<UWorld>(Outer);
+    return Super::ShouldCreateSubsystem(Outer) && World && World->IsGameWorld();
+}
+
+void UClimbAsyncPhysicsSubsystem::OnWorldBeginPlay(UWorld &InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    FPhysScene *PhysScene = InWorld.GetPhysicsScene();
+    Chaos::FPhysicsSolver *Solver = PhysScene ? PhysScene->GetSolver() : nullptr;
+    if (!Solver)
+        return;
+
+    Callback = Solver->CreateAndRegisterSimCallbackObject_External<FClimbAsyncPhysicsCallback>();
+}
+
+void UClimbAsyncPhysicsSubsystem::Deinitialize()
+{
+    if (Callback)
+    {
+        FPhysScene *PhysScene = GetWorld()->GetPhysicsScene();
+        if (Chaos::FPhysicsSolver *Solver = PhysScene ? PhysScene->GetSolver() : nullptr)
+        {
+            Solver->UnregisterAndFreeSimCallbackObject_External(Callback);
+        }
+        Callback = nullptr;
+    }
+
+    LatestOutputs.Reset();
+    SubmittedSerials.Reset();
+
+    Super::Deinitialize();
+}
+
+void UClimbAsyncPhysicsSubsystem::Tick(float DeltaTime)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+    Super::Tick(DeltaTime);
+
+    if (!Callback)
+        return;
+
+    // Outputs arrive in step order, the last one of each climber wins
+    while (auto Output = Callback->PopOutputData_External())
+    {
+        for (const FClimbAsyncClimberOutput &ClimberOutput : Output->Climbers)
+        {
+            if (SubmittedSerials.Contains(ClimberOutput.ClimberId))
+            {
+                LatestOutputs.Add(ClimberOutput.ClimberId, ClimberOutput);
+            }
+        }
+    }
+}
+
+TStatId UClimbAsyncPhysicsSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UClimbAsyncPhysicsSubsystem, STATGROUP_Climbing);
+}
+
+int32 UClimbAsyncPhysicsSubsystem::RegisterClimber()
+{
+    if (!Callback)
+        return INDEX_NONE;
+
+    const int32 ClimberId = NextClimberId++;
+    SubmittedSerials.Add(ClimberId, 0);
+    return ClimberId;
+}
+
+void UClimbAsyncPhysicsSubsystem::UnregisterClimber(int32 ClimberId)
+{
+    if (!SubmittedSerials.Remove(ClimberId))
+        return;
+
+    LatestOutputs.Remove(ClimberId);
+
+    if (Callback)
+    {
+        Callback->GetProducerInputData_External()->RemovedClimbers.Add(ClimberId);
+    }
+}
+
+void UClimbAsyncPhysicsSubsystem::SubmitClimberInput(FClimbAsyncClimberInput &Input)
+{
+    uint32 *Serial = SubmittedSerials.Find(Input.ClimberId);
+    if (!Callback || !Serial)
+        return;
+
+    Input.Serial = ++(*Serial);
+
+    FClimbAsyncInput *ProducerInput = Callback->GetProducerInputData_External();
+    ProducerInput->World = GetWorld();
+    ProducerInput->Climbers.Add(Input);
+}
+
+const FClimbAsyncClimberOutput *UClimbAsyncPhysicsSubsystem::GetLatestOutput(int32 ClimberId) const
+{
+    return LatestOutputs.Find(ClimberId);
+}
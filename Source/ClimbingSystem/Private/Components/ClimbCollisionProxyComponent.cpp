@@ -0,0 +1,153 @@
+#include "Components/ClimbCollisionProxyComponent.h"
+#include "Components/ClimbCollisionProxyUserData.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "ClimbingSystem.h"
+
+namespace
+{
+    void AppendTransformedGeometry(FKAggregateGeom &Target, const FKAggregateGeom &Source, const FTransform &Transform)
+    {
+        const FVector Scale = Transform.GetScale3D().GetAbs();
+
+        for (const FKBoxElem &Box : Source.BoxElems)
+        {
+            FKBoxElem &NewBox = Target.BoxElems.Add_GetRef(Box);
+            NewBox.Center = Transform.TransformPosition(Box.Center);
+            NewBox.Rotation = (Transform.GetRotation() * Box.Rotation.Quaternion()).Rotator();
+
+            // Exact for unrotated boxes, conservative enough for patches under non uniform instance scale
+            const FQuat BoxRotation = Box.Rotation.Quaternion();
+            NewBox.X = Box.X * BoxRotation.GetAxisX().GetAbs().Dot(Scale);
+            NewBox.Y = Box.Y * BoxRotation.GetAxisY().GetAbs().Dot(Scale);
+            NewBox.Z = Box.Z * BoxRotation.GetAxisZ().GetAbs().Dot(Scale);
+        }
+
+        for (const FKSphylElem &Capsule : Source.SphylElems)
+        {
+            FKSphylElem &NewCapsule = Target.SphylElems.Add_GetRef(Capsule);
+            NewCapsule.Center = Transform.TransformPosition(Capsule.Center);
+            NewCapsule.Rotation = (Transform.GetRotation() * Capsule.Rotation.Quaternion()).Rotator();
+            NewCapsule.Length = Capsule.Length * Capsule.Rotation.Quaternion().GetAxisZ().GetAbs().Dot(Scale);
+        }
+    }
+}
+
+UClimbCollisionProxyComponent::UClimbCollisionProxyComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+
+    SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+    SetCollisionObjectType(ECC_ClimbProxy);
+    SetCollisionResponseToAllChannels(ECR_Ignore);
+    SetGenerateOverlapEvents(false);
+    SetCanEverAffectNavigation(false);
+    CanCharacterStepUpOn = ECB_No;
+    bHiddenInGame = true;
+}
+
+UStaticMeshComponent *UClimbCollisionProxyComponent::GetSourceMeshComponent() const
+{
+    return Cast<UStaticMeshComponent>(GetAttachParent());
+}
+
+void UClimbCollisionProxyComponent::OnRegister()
+{
+    if (const USceneComponent *Parent = GetAttachParent())
+    {
+        SetMobility(Parent->Mobility);
+    }
+
+    if (bBuildOnRegister)
+    {
+        RebuildProxyBody();
+    }
+
+    Super::OnRegister();
+}
+
+void UClimbCollisionProxyComponent::RebuildProxyBody()
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+    const UStaticMeshComponent *SourceMeshComponent = GetSourceMeshComponent();
+    const UClimbCollisionProxyUserData *ProxyData =
+        SourceMeshComponent ? UClimbCollisionProxyUserData::Get(SourceMeshComponent->GetStaticMesh()) : nullptr;
+
+    NumProxyElements = 0;
+
+    if (!ProxyData)
+    {
+        ProxyBodySetup = nullptr;
+        return;
+    }
+
+    if (!ProxyBodySetup)
+    {
+        ProxyBodySetup = NewObject<UBodySetup>(this, NAME_None, RF_Transient);
+        ProxyBodySetup->CollisionTraceFlag = CTF_UseSimpleAsComplex;
+        ProxyBodySetup->bGenerateMirroredCollision = false;
+    }
+
+    ProxyBodySetup->AggGeom.EmptyElements();
+
+    if (const UInstancedStaticMeshComponent *InstancedComponent = Cast<UInstancedStaticMeshComponent>(SourceMeshComponent))
+    {
+        auto AppendInstance = [this, InstancedComponent, ProxyData](int32 InstanceIndex)
+        {
+            FTransform InstanceTransform;
+            if (InstancedComponent->GetInstanceTransform(InstanceIndex, InstanceTransform, false))
+            {
+                AppendTransformedGeometry(ProxyBodySetup->AggGeom, ProxyData->ProxyGeometry, InstanceTransform);
+            }
+        };
+
+        if (SourceInstances.IsEmpty())
+        {
+            for (int32 InstanceIndex = 0; InstanceIndex < InstancedComponent->GetInstanceCount(); ++InstanceIndex)
+            {
+                AppendInstance(InstanceIndex);
+            }
+        }
+        else
+        {
+            for (const int32 InstanceIndex : SourceInstances)
+            {
+                AppendInstance(InstanceIndex);
+            }
+        }
+    }
+    else
+    {
+        ProxyBodySetup->AggGeom = ProxyData->ProxyGeometry;
+    }
+
+    NumProxyElements = ProxyBodySetup->AggGeom.GetElementCount();
+
+    ProxyBodySetup->InvalidatePhysicsData();
+    ProxyBodySetup->CreatePhysicsMeshes();
+
+    if (IsRegistered())
+    {
+        RecreatePhysicsState();
+        UpdateBounds();
+    }
+}
+
+void UClimbCollisionProxyComponent::SetSourceInstances(TArray<int32> &&InInstanceIndices)
+{
+    SourceInstances = MoveTemp(InInstanceIndices);
+}
+
+UBodySetup *UClimbCollisionProxyComponent::GetBodySetup()
+{
+    return ProxyBodySetup;
+}
+
+FBoxSphereBounds UClimbCollisionProxyComponent::CalcBounds(const FTransform &LocalToWorld) const
+{
+    if (!ProxyBodySetup || NumProxyElements == 0)
+        return FBoxSphereBounds(LocalToWorld.GetLocation(), FVector::ZeroVector, 0.f);
+
+    return FBoxSphereBounds(ProxyBodySetup->AggGeom.CalcAABB(LocalToWorld));
+}
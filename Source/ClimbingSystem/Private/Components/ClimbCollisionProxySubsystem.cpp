@@ -0,0 +1,335 @@
+#include "Components/ClimbCollisionProxySubsystem.h"
+#include "Components/ClimbCollisionProxyComponent.h"
+#include "Components/ClimbCollisionProxyUserData.h"
+#include "Components/CustomMovementComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "UObject/UObjectIterator.h"
+#include "ClimbingSystem.h"
+
+namespace
+{
+    TAutoConsoleVariable<int32> CVarClimbProxyMaxShapesPerBody(
+        TEXT("Climb.CollisionProxy.MaxShapesPerBody"),
+        1024,
+        TEXT("Proxy shapes per body, instanced meshes are split into spatial clusters of instances to stay below it"));
+
+    TAutoConsoleVariable<int32> CVarClimbProxyBuildShapesPerFrame(
+        TEXT("Climb.CollisionProxy.BuildShapesPerFrame"),
+        2048,
+        TEXT("Proxy shapes built per frame after a level is added, at least one proxy body is built each frame"));
+
+    uint32 SpreadMortonBits(uint32 Value)
+    {
+        Value &= 0xFFFF;
+        Value = (Value | (Value << 8)) & 0x00FF00FF;
+        Value = (Value | (Value << 4)) & 0x0F0F0F0F;
+        Value = (Value | (Value << 2)) & 0x33333333;
+        Value = (Value | (Value << 1)) & 0x55555555;
+        return Value;
+    }
+
+    // Z-order of the instance location on the ground plane, so consecutive instances form compact clusters
+    uint32 GetMortonKey(const FVector &Location, const FBox &Bounds)
+    {
+        const FVector Size = Bounds.GetSize().ComponentMax(FVector(1.0));
+        const FVector Normalized = (Location - Bounds.Min) / Size;
+        const uint32 X = uint32(FMath::Clamp(Normalized.X, 0.0, 1.0) * 0xFFFF);
+        const uint32 Y = uint32(FMath::Clamp(Normalized.Y, 0.0, 1.0) * 0xFFFF);
+        return SpreadMortonBits(X) | (SpreadMortonBits(Y) << 1);
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs BenchmarkClimbCollisionProxiesCommand(
+        TEXT("Climb.BenchmarkCollisionProxies"),
+        TEXT("Sweeps the climb capsule over every proxy patch against the art collision and against the proxies, and logs cost and hit counts. Arg: samples per proxy (default 8)"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+        {
+            const UClimbCollisionProxySubsystem *Subsystem = World ? World->GetSubsystem<UClimbCollisionProxySubsystem>() : nullptr;
+            if (!Subsystem)
+                return;
+
+            Subsystem->RunBenchmark(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 8);
+        }));
+
+    struct FQueryBenchmark
+    {
+        uint64 Cycles = 0;
+        int32 NumQueries = 0;
+        int32 NumHits = 0;
+
+        void Run(const UWorld &World, const FVector &Start, const FVector &End, const FCollisionShape &Shape, const FCollisionObjectQueryParams &ObjectParams)
+        {
+            TArray<FHitResult> Hits;
+            const uint64 StartCycles = FPlatformTime::Cycles64();
+            World.SweepMultiByObjectType(Hits, Start, End, FQuat::Identity, ObjectParams, Shape, FCollisionQueryParams(SCENE_QUERY_STAT(ClimbProxyBenchmark), false));
+            Cycles += FPlatformTime::Cycles64() - StartCycles;
+
+            NumQueries++;
+            NumHits += Hits.Num();
+        }
+
+        void Log(const TCHAR *Label) const
+        {
+            const double Milliseconds = FPlatformTime::ToMilliseconds64(Cycles);
+            UE_LOG(LogClimbing, Display, TEXT("  %-16s %6d queries %8.3f ms total %8.2f us/query %6.2f hits/query"),
+                Label,
+                NumQueries,
+                Milliseconds,
+                NumQueries > 0 ? Milliseconds * 1000.0 / NumQueries : 0.0,
+                NumQueries > 0 ? float(NumHits) / NumQueries : 0.f);
+        }
+    };
+}
+
+bool UClimbCollisionProxySubsystem::ShouldCreateSubsystem(UObject *Outer) const
+{
+    const UWorld *World = Cast<UWorld>(Outer);
+    return Super::ShouldCreateSubsystem(Outer) && World && World->IsGameWorld();
+}
+
+void UClimbCollisionProxySubsystem::Initialize(FSubsystemCollectionBase &Collection)
+{
+    Super::Initialize(Collection);
+
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UClimbCollisionProxySubsystem::OnLevelAddedToWorld);
+}
+
+void UClimbCollisionProxySubsystem::Deinitialize()
+{
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    ProxyComponents.Reset();
+    PendingBuilds.Reset();
+    NextPendingBuild = 0;
+
+    Super::Deinitialize();
+}
+
+void UClimbCollisionProxySubsystem::OnWorldBeginPlay(UWorld &InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    for (ULevel *Level : InWorld.GetLevels())
+    {
+        if (Level && Level->bIsVisible)
+        {
+            AddProxiesToLevel(*Level);
+        }
+    }
+}
+
+void UClimbCollisionProxySubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (PendingBuilds.IsEmpty())
+        return;
+
+    LLM_SCOPE_BYTAG(Climbing);
+
+    const int32 ShapeBudget = CVarClimbProxyBuildShapesPerFrame.GetValueOnGameThread();
+    int32 NumBuiltShapes = 0;
+
+    while (NextPendingBuild < PendingBuilds.Num() && (NumBuiltShapes == 0 || NumBuiltShapes < ShapeBudget))
+    {
+        UClimbCollisionProxyComponent *Proxy = PendingBuilds[NextPendingBuild++].Get();
+        if (!Proxy || !Proxy->IsRegistered())
+            continue;
+
+        Proxy->RebuildProxyBody();
+        NumBuiltShapes += FMath::Max(Proxy->GetNumProxyElements(), 1);
+    }
+
+    if (NextPendingBuild >= PendingBuilds.Num())
+    {
+        PendingBuilds.Reset();
+        NextPendingBuild = 0;
+    }
+}
+
+TStatId UClimbCollisionProxySubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UClimbCollisionProxySubsystem, STATGROUP_Climbing);
+}
+
+void UClimbCollisionProxySubsystem::OnLevelAddedToWorld(ULevel *Level, UWorld *World)
+{
+    if (World != GetWorld() || !Level || !World->HasBegunPlay())
+        return;
+
+    AddProxiesToLevel(*Level);
+}
+
+void UClimbCollisionProxySubsystem::AddProxiesToLevel(ULevel &Level)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+    ProxyComponents.RemoveAll([](const TWeakObjectPtr<UClimbCollisionProxyComponent> &Proxy) { return !Proxy.IsValid(); });
+
+    for (AActor *Actor : Level.Actors)
+    {
+        if (!Actor)
+            continue;
+
+        TInlineComponentArray<UStaticMeshComponent *> MeshComponents(Actor);
+
+        for (UStaticMeshComponent *MeshComponent : MeshComponents)
+        {
+            const UClimbCollisionProxyUserData *ProxyData = UClimbCollisionProxyUserData::Get(MeshComponent->GetStaticMesh());
+            if (!MeshComponent->IsQueryCollisionEnabled() || !ProxyData)
+                continue;
+
+            const bool bHasProxy = MeshComponent->GetAttachChildren().ContainsByPredicate([](const USceneComponent *Child)
+            {
+                return Child && Child->IsA<UClimbCollisionProxyComponent>();
+            });
+
+            if (bHasProxy)
+                continue;
+
+            if (MeshComponent->IsA<UInstancedStaticMeshComponent>())
+            {
+                AddInstancedProxies(*Actor, *MeshComponent, ProxyData->ProxyGeometry.GetElementCount());
+            }
+            else
+            {
+                AddProxy(*Actor, *MeshComponent, {});
+            }
+        }
+    }
+}
+
+void UClimbCollisionProxySubsystem::AddProxy(AActor &Actor, UStaticMeshComponent &MeshComponent, TArray<int32> &&InstanceIndices)
+{
+    UClimbCollisionProxyComponent *ProxyComponent = NewObject<UClimbCollisionProxyComponent>(&Actor, NAME_None, RF_Transient);
+    ProxyComponent->SetSourceInstances(MoveTemp(InstanceIndices));
+    ProxyComponent->bBuildOnRegister = false;
+    ProxyComponent->SetupAttachment(&MeshComponent);
+    ProxyComponent->RegisterComponent();
+    Actor.AddInstanceComponent(ProxyComponent);
+    ProxyComponents.Add(ProxyComponent);
+    PendingBuilds.Add(ProxyComponent);
+}
+
+void UClimbCollisionProxySubsystem::AddInstancedProxies(AActor &Actor, UStaticMeshComponent &MeshComponent, int32 ElementsPerInstance)
+{
+    const UInstancedStaticMeshComponent &InstancedComponent = static_cast<const UInstancedStaticMeshComponent &>(MeshComponent);
+    const int32 NumInstances = InstancedComponent.GetInstanceCount();
+    const int32 InstancesPerBody = FMath::Max(1, CVarClimbProxyMaxShapesPerBody.GetValueOnGameThread() / FMath::Max(ElementsPerInstance, 1));
+
+    if (NumInstances <= InstancesPerBody)
+    {
+        AddProxy(Actor, MeshComponent, {});
+        return;
+    }
+
+    TArray<FVector> Locations;
+    Locations.SetNumUninitialized(NumInstances);
+    FBox Bounds(ForceInit);
+
+    for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; ++InstanceIndex)
+    {
+        FTransform InstanceTransform;
+        InstancedComponent.GetInstanceTransform(InstanceIndex, InstanceTransform, false);
+        Locations[InstanceIndex] = InstanceTransform.GetLocation();
+        Bounds += Locations[InstanceIndex];
+    }
+
+    TArray<TPair<uint32, int32>> SortedInstances;
+    SortedInstances.Reserve(NumInstances);
+
+    for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; ++InstanceIndex)
+    {
+        SortedInstances.Emplace(GetMortonKey(Locations[InstanceIndex], Bounds), InstanceIndex);
+    }
+
+    SortedInstances.Sort([](const TPair<uint32, int32> &A, const TPair<uint32, int32> &B) { return A.Key < B.Key; });
+
+    for (int32 First = 0; First < NumInstances; First += InstancesPerBody)
+    {
+        TArray<int32> ClusterInstances;
+        ClusterInstances.Reserve(FMath::Min(InstancesPerBody, NumInstances - First));
+
+        for (int32 SortedIndex = First; SortedIndex < FMath::Min(First + InstancesPerBody, NumInstances); ++SortedIndex)
+        {
+            ClusterInstances.Add(SortedInstances[SortedIndex].Value);
+        }
+
+        AddProxy(Actor, MeshComponent, MoveTemp(ClusterInstances));
+    }
+}
+
+void UClimbCollisionProxySubsystem::RunBenchmark(int32 SamplesPerProxy) const
+{
+    const UWorld *World = GetWorld();
+    const UCustomMovementComponent *MovementComponent = nullptr;
+
+    for (TObjectIterator<UCustomMovementComponent> It; It; ++It)
+    {
+        if (It->GetWorld() == World)
+        {
+            MovementComponent = *It;
+            break;
+        }
+    }
+
+    if (!MovementComponent || MovementComponent->GetClimbableSurfaceTraceTypes().IsEmpty())
+    {
+        UE_LOG(LogClimbing, Warning, TEXT("Climb proxy benchmark needs a character with climbable surface trace types in the world"));
+        return;
+    }
+
+    const FCollisionObjectQueryParams ArtObjectParams(MovementComponent->GetClimbableSurfaceTraceTypes());
+    const FCollisionObjectQueryParams ProxyObjectParams(ECC_ClimbProxy);
+    const FCollisionShape ClimbShape = FCollisionShape::MakeCapsule(MovementComponent->GetClimbCapsuleTraceRadius(), MovementComponent->GetClimbCapsuleTraceHalfHeight());
+    const float StandOff = MovementComponent->GetClimbCapsuleTraceRadius();
+
+    FQueryBenchmark ArtBenchmark;
+    FQueryBenchmark ProxyBenchmark;
+    int32 NumProxies = 0;
+    int32 NumProxyElements = 0;
+    FRandomStream RandomStream(0x436c696d);
+
+    for (const TWeakObjectPtr<UClimbCollisionProxyComponent> &ProxyPtr : ProxyComponents)
+    {
+        UClimbCollisionProxyComponent *Proxy = ProxyPtr.Get();
+        const UBodySetup *BodySetup = Proxy ? Proxy->GetBodySetup() : nullptr;
+        if (!BodySetup)
+            continue;
+
+        NumProxies++;
+        NumProxyElements += Proxy->GetNumProxyElements();
+
+        const FTransform &ProxyTransform = Proxy->GetComponentTransform();
+
+        // Sample the front face of every patch box, where a climber would hold on to the surface
+        for (const FKBoxElem &Box : BodySetup->AggGeom.BoxElems)
+        {
+            const FTransform BoxTransform = Box.GetTransform() * ProxyTransform;
+            const FVector Normal = BoxTransform.GetUnitAxis(EAxis::Z);
+
+            for (int32 SampleIndex = 0; SampleIndex < SamplesPerProxy; ++SampleIndex)
+            {
+                const FVector LocalPoint(
+                    RandomStream.FRandRange(-0.5f, 0.5f) * Box.X,
+                    RandomStream.FRandRange(-0.5f, 0.5f) * Box.Y,
+                    Box.Z * 0.5f);
+
+                // Same sweep as UCustomMovementComponent::GetClimbableSurfaces, from a climber standing off the surface
+                const FVector ClimberLocation = BoxTransform.TransformPosition(LocalPoint) + Normal * StandOff;
+                const FVector Start = ClimberLocation - Normal * 30.f;
+                const FVector End = Start - Normal;
+
+                ArtBenchmark.Run(*World, Start, End, ClimbShape, ArtObjectParams);
+                ProxyBenchmark.Run(*World, Start, End, ClimbShape, ProxyObjectParams);
+            }
+        }
+    }
+
+    UE_LOG(LogClimbing, Display, TEXT("Climb proxy benchmark on %s: %d proxies, %d proxy elements, %d samples per patch"),
+        *GetNameSafe(World), NumProxies, NumProxyElements, SamplesPerProxy);
+    ArtBenchmark.Log(TEXT("Art collision"));
+    ProxyBenchmark.Log(TEXT("Climb proxies"));
+}
@@ -0,0 +1,309 @@
+#include "Components/ClimbCollisionProxyUserData.h"
+#include "Components/ClimbMeshGeometry.h"
+#include "Components/ClimbSurfaceRules.h"
+#include "Engine/StaticMesh.h"
+#include "ClimbingSystem.h"
+
+namespace
+{
+    struct FProxyTriangle
+    {
+        FVector Normal;
+        FVector Centroid;
+        float Area = 0.f;
+        int32 Patch = INDEX_NONE;
+        int32 Neighbors[3] = {INDEX_NONE, INDEX_NONE, INDEX_NONE};
+    };
+
+    struct FProxyPatch
+    {
+        FVector Normal = FVector::ZeroVector;
+        float Area = 0.f;
+        TArray<int32> Triangles;
+    };
+
+    struct FProxyLedge
+    {
+        FVector Direction = FVector::ZeroVector;
+        FVector Inward = FVector::ZeroVector;
+        FVector PointSum = FVector::ZeroVector;
+        float LongestEdge = 0.f;
+        TArray<FVector> Points;
+    };
+
+    uint64 MakeEdgeKey(int32 A, int32 B)
+    {
+        return (uint64(FMath::Min(A, B)) << 32) | uint64(FMath::Max(A, B));
+    }
+}
+
+UClimbCollisionProxyUserData *UClimbCollisionProxyUserData::Get(const UStaticMesh *StaticMesh)
+{
+    if (!StaticMesh)
+        return nullptr;
+
+    return const_cast<UStaticMesh *>(StaticMesh)->GetAssetUserData<UClimbCollisionProxyUserData>();
+}
+
+void UClimbCollisionProxyUserData::Generate(const UStaticMesh &StaticMesh, const FClimbCollisionProxyBuildSettings &Settings)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+    ProxyGeometry.EmptyElements();
+
+    FClimbMeshGeometry Geometry;
+    Geometry.Build(StaticMesh);
+
+    SourceTriangleCount = Geometry.GetNumTriangles();
+    if (SourceTriangleCount == 0)
+        return;
+
+    // Low obstacles and small props only need to be vaulted or climbed over as a whole
+    const FBox Bounds = StaticMesh.GetBoundingBox();
+    const FVector BoundsSize = Bounds.GetSize();
+
+    if (BoundsSize.Z <= ClimbSurfaceRules::VaultTraceHeight || BoundsSize.GetMax() <= Settings.CompactMeshMaxSize)
+    {
+        FKBoxElem VaultBox(BoundsSize.X, BoundsSize.Y, BoundsSize.Z);
+        VaultBox.Center = Bounds.GetCenter();
+        ProxyGeometry.BoxElems.Add(VaultBox);
+        return;
+    }
+
+    auto GetPosition = [&Geometry](int32 Index)
+    {
+        return FVector(Geometry.Positions[Index]);
+    };
+
+    TArray<FProxyTriangle> Triangles;
+    Triangles.SetNum(SourceTriangleCount);
+
+    TMap<uint64, FIntPoint> EdgeTriangles;
+    EdgeTriangles.Reserve(SourceTriangleCount * 3 / 2);
+
+    for (int32 TriangleIndex = 0; TriangleIndex < SourceTriangleCount; ++TriangleIndex)
+    {
+        const int32 *Corners = &Geometry.Indices[TriangleIndex * 3];
+        FProxyTriangle &Triangle = Triangles[TriangleIndex];
+
+        const FVector A = GetPosition(Corners[0]);
+        const FVector B = GetPosition(Corners[1]);
+        const FVector C = GetPosition(Corners[2]);
+        const FVector Cross = FVector::CrossProduct(B - A, C - A);
+
+        Triangle.Area = Cross.Size() * 0.5f;
+        Triangle.Normal = Cross.GetSafeNormal();
+        Triangle.Centroid = (A + B + C) / 3.f;
+
+        const FVector VertexNormal(Geometry.VertexNormals[Corners[0]] + Geometry.VertexNormals[Corners[1]] + Geometry.VertexNormals[Corners[2]]);
+        if (FVector::DotProduct(Triangle.Normal, VertexNormal) < 0.f)
+        {
+            Triangle.Normal = -Triangle.Normal;
+        }
+
+        for (int32 Corner = 0; Corner < 3; ++Corner)
+        {
+            FIntPoint &Pair = EdgeTriangles.FindOrAdd(MakeEdgeKey(Corners[Corner], Corners[(Corner + 1) % 3]), FIntPoint(INDEX_NONE, INDEX_NONE));
+            (Pair.X == INDEX_NONE ? Pair.X : Pair.Y) = TriangleIndex;
+        }
+    }
+
+    for (int32 TriangleIndex = 0; TriangleIndex < SourceTriangleCount; ++TriangleIndex)
+    {
+        const int32 *Corners = &Geometry.Indices[TriangleIndex * 3];
+
+        for (int32 Corner = 0; Corner < 3; ++Corner)
+        {
+            const FIntPoint &Pair = EdgeTriangles.FindChecked(MakeEdgeKey(Corners[Corner], Corners[(Corner + 1) % 3]));
+            Triangles[TriangleIndex].Neighbors[Corner] = Pair.X == TriangleIndex ? Pair.Y : Pair.X;
+        }
+    }
+
+    // Grow near planar patches from seeds, largest triangles first so patches start on the dominant faces
+    TArray<int32> SeedOrder;
+    SeedOrder.SetNumUninitialized(SourceTriangleCount);
+    for (int32 i = 0; i < SourceTriangleCount; ++i)
+    {
+        SeedOrder[i] = i;
+    }
+    SeedOrder.Sort([&Triangles](int32 A, int32 B) { return Triangles[A].Area > Triangles[B].Area; });
+
+    const float MinNormalDot = FMath::Cos(FMath::DegreesToRadians(Settings.PatchNormalTolerance));
+    TArray<FProxyPatch> Patches;
+    TArray<int32> Stack;
+
+    for (const int32 SeedIndex : SeedOrder)
+    {
+        if (Triangles[SeedIndex].Patch != INDEX_NONE || Triangles[SeedIndex].Area <= UE_KINDA_SMALL_NUMBER)
+            continue;
+
+        const int32 PatchIndex = Patches.AddDefaulted();
+        const FVector SeedNormal = Triangles[SeedIndex].Normal;
+        const FVector SeedPoint = Triangles[SeedIndex].Centroid;
+
+        Triangles[SeedIndex].Patch = PatchIndex;
+        Stack.Reset();
+        Stack.Add(SeedIndex);
+
+        while (!Stack.IsEmpty())
+        {
+            const int32 TriangleIndex = Stack.Pop(false);
+            FProxyTriangle &Triangle = Triangles[TriangleIndex];
+
+            Patches[PatchIndex].Triangles.Add(TriangleIndex);
+            Patches[PatchIndex].Normal += Triangle.Normal * Triangle.Area;
+            Patches[PatchIndex].Area += Triangle.Area;
+
+            for (const int32 NeighborIndex : Triangle.Neighbors)
+            {
+                if (NeighborIndex == INDEX_NONE || Triangles[NeighborIndex].Patch != INDEX_NONE)
+                    continue;
+
+                const FProxyTriangle &Neighbor = Triangles[NeighborIndex];
+                if (FVector::DotProduct(Neighbor.Normal, SeedNormal) < MinNormalDot)
+                    continue;
+
+                const int32 *Corners = &Geometry.Indices[NeighborIndex * 3];
+                bool bOnPlane = true;
+                for (int32 Corner = 0; Corner < 3 && bOnPlane; ++Corner)
+                {
+                    bOnPlane = FMath::Abs(FVector::DotProduct(GetPosition(Corners[Corner]) - SeedPoint, SeedNormal)) <= Settings.PatchPlaneTolerance;
+                }
+
+                if (!bOnPlane)
+                    continue;
+
+                Triangles[NeighborIndex].Patch = PatchIndex;
+                Stack.Add(NeighborIndex);
+            }
+        }
+    }
+
+    // Only the largest patches become proxies, the rest is detail the climb sweep does not need
+    TArray<int32> KeptPatches;
+    for (int32 PatchIndex = 0; PatchIndex < Patches.Num(); ++PatchIndex)
+    {
+        if (Patches[PatchIndex].Area >= Settings.MinPatchArea)
+        {
+            KeptPatches.Add(PatchIndex);
+        }
+    }
+    KeptPatches.Sort([&Patches](int32 A, int32 B) { return Patches[A].Area > Patches[B].Area; });
+    KeptPatches.SetNum(FMath::Min(KeptPatches.Num(), Settings.MaxPatches));
+
+    TArray<bool> bPatchKept;
+    bPatchKept.Init(false, Patches.Num());
+
+    for (const int32 PatchIndex : KeptPatches)
+    {
+        bPatchKept[PatchIndex] = true;
+        FProxyPatch &Patch = Patches[PatchIndex];
+
+        const FVector Normal = Patch.Normal.GetSafeNormal();
+        const FVector TangentX = FMath::Abs(Normal.Z) < 0.99f
+                                     ? FVector::CrossProduct(FVector::UpVector, Normal).GetSafeNormal()
+                                     : FVector::CrossProduct(Normal, FVector::ForwardVector).GetSafeNormal();
+        const FVector TangentY = FVector::CrossProduct(Normal, TangentX);
+
+        FVector Min(TNumericLimits<float>::Max());
+        FVector Max(TNumericLimits<float>::Lowest());
+        float WeightedPlaneDistance = 0.f;
+
+        for (const int32 TriangleIndex : Patch.Triangles)
+        {
+            const int32 *Corners = &Geometry.Indices[TriangleIndex * 3];
+            for (int32 Corner = 0; Corner < 3; ++Corner)
+            {
+                const FVector Position = GetPosition(Corners[Corner]);
+                const FVector Projected(
+                    FVector::DotProduct(Position, TangentX),
+                    FVector::DotProduct(Position, TangentY),
+                    FVector::DotProduct(Position, Normal));
+
+                Min = Min.ComponentMin(Projected);
+                Max = Max.ComponentMax(Projected);
+            }
+
+            WeightedPlaneDistance += FVector::DotProduct(Triangles[TriangleIndex].Centroid, Normal) * Triangles[TriangleIndex].Area;
+        }
+
+        // The box face sits on the average surface plane and the box extends behind it
+        const float PlaneDistance = WeightedPlaneDistance / Patch.Area;
+        const FVector Center =
+            TangentX * (Min.X + Max.X) * 0.5f +
+            TangentY * (Min.Y + Max.Y) * 0.5f +
+            Normal * (PlaneDistance - Settings.PatchThickness * 0.5f);
+
+        FKBoxElem PatchBox(Max.X - Min.X, Max.Y - Min.Y, Settings.PatchThickness);
+        PatchBox.Center = Center;
+        PatchBox.Rotation = FRotationMatrix::MakeFromXY(TangentX, TangentY).Rotator();
+        ProxyGeometry.BoxElems.Add(PatchBox);
+    }
+
+    // Sharp convex edges between two kept patches become ledge capsules, one per patch pair
+    const float MaxLedgeNormalDot = FMath::Cos(FMath::DegreesToRadians(Settings.LedgeMinAngle));
+    TMap<uint64, FProxyLedge> Ledges;
+
+    for (const TPair<uint64, FIntPoint> &Edge : EdgeTriangles)
+    {
+        if (Edge.Value.X == INDEX_NONE || Edge.Value.Y == INDEX_NONE)
+            continue;
+
+        const FProxyTriangle &TriangleA = Triangles[Edge.Value.X];
+        const FProxyTriangle &TriangleB = Triangles[Edge.Value.Y];
+
+        if (TriangleA.Patch == TriangleB.Patch || TriangleA.Patch == INDEX_NONE || TriangleB.Patch == INDEX_NONE)
+            continue;
+        if (!bPatchKept[TriangleA.Patch] || !bPatchKept[TriangleB.Patch])
+            continue;
+        if (FVector::DotProduct(TriangleA.Normal, TriangleB.Normal) > MaxLedgeNormalDot)
+            continue;
+        if (FVector::DotProduct(TriangleB.Centroid - TriangleA.Centroid, TriangleA.Normal) >= 0.f)
+            continue;
+
+        const FVector V0 = GetPosition(int32(Edge.Key >> 32));
+        const FVector V1 = GetPosition(int32(Edge.Key & 0xffffffff));
+        const float EdgeLength = FVector::Dist(V0, V1);
+
+        FProxyLedge &Ledge = Ledges.FindOrAdd(MakeEdgeKey(TriangleA.Patch, TriangleB.Patch));
+        Ledge.Points.Add(V0);
+        Ledge.Points.Add(V1);
+        Ledge.PointSum += V0 + V1;
+        Ledge.Inward = -(Patches[TriangleA.Patch].Normal.GetSafeNormal() + Patches[TriangleB.Patch].Normal.GetSafeNormal()).GetSafeNormal();
+
+        if (EdgeLength > Ledge.LongestEdge)
+        {
+            Ledge.LongestEdge = EdgeLength;
+            Ledge.Direction = (V1 - V0) / EdgeLength;
+        }
+    }
+
+    TArray<FKSphylElem> LedgeCapsules;
+
+    for (const TPair<uint64, FProxyLedge> &LedgePair : Ledges)
+    {
+        const FProxyLedge &Ledge = LedgePair.Value;
+        if (Ledge.Direction.IsNearlyZero())
+            continue;
+
+        const FVector Origin = Ledge.PointSum / Ledge.Points.Num();
+        float MinT = TNumericLimits<float>::Max();
+        float MaxT = TNumericLimits<float>::Lowest();
+
+        for (const FVector &Point : Ledge.Points)
+        {
+            const float T = FVector::DotProduct(Point - Origin, Ledge.Direction);
+            MinT = FMath::Min(MinT, T);
+            MaxT = FMath::Max(MaxT, T);
+        }
+
+        FKSphylElem LedgeCapsule(Settings.LedgeRadius, FMath::Max(MaxT - MinT - Settings.LedgeRadius * 2.f, 0.f));
+        LedgeCapsule.Center = Origin + Ledge.Direction * (MinT + MaxT) * 0.5f + Ledge.Inward * Settings.LedgeRadius;
+        LedgeCapsule.Rotation = FRotationMatrix::MakeFromZ(Ledge.Direction).Rotator();
+        LedgeCapsules.Add(LedgeCapsule);
+    }
+
+    LedgeCapsules.Sort([](const FKSphylElem &A, const FKSphylElem &B) { return A.Length > B.Length; });
+    LedgeCapsules.SetNum(FMath::Min(LedgeCapsules.Num(), Settings.MaxLedges));
+    ProxyGeometry.SphylElems.Append(LedgeCapsules);
+}
@@ -0,0 +1,272 @@
+#include "Components/ClimbContactManifold.h"
+#include "Components/PrimitiveComponent.h"
+
+int32 FClimbContactManifold::SelectMostRelevantHits(const TArray<FHitResult> &Hits, const FVector &ProbeLocation, const FVector &ProbeForward, int32 (&OutHitIndices)[MaxContacts])
+{
+    // Partial insertion sort, only the best MaxContacts hits are ever ordered
+    float BestScores[MaxContacts];
+    int32 NumBest = 0;
+
+    for (int32 HitIndex = 0; HitIndex < Hits.Num(); ++HitIndex)
+    {
+        const FHitResult &Hit = Hits[HitIndex];
+
+        // Surfaces facing the probe and close to it matter most
+        const float Facing = FVector::DotProduct(-Hit.ImpactNormal, ProbeForward);
+        const float Score = Facing * 100.f - FVector::Dist(Hit.ImpactPoint, ProbeLocation);
+
+        if (NumBest == MaxContacts && Score <= BestScores[NumBest - 1])
+            continue;
+
+        int32 InsertIndex = FMath::Min(NumBest, MaxContacts - 1);
+        while (InsertIndex > 0 && BestScores[InsertIndex - 1] < Score)
+        {
+            BestScores[InsertIndex] = BestScores[InsertIndex - 1];
+            OutHitIndices[InsertIndex] = OutHitIndices[InsertIndex - 1];
+            --InsertIndex;
+        }
+
+        BestScores[InsertIndex] = Score;
+        OutHitIndices[InsertIndex] = HitIndex;
+        NumBest = FMath::Min(NumBest + 1, MaxContacts);
+    }
+
+    return NumBest;
+}
+
+void FClimbContactManifold::Update(const TArray<FHitResult> &Hits, const FVector &ProbeLocation, const FVector &ProbeForward)
+{
+    int32 BestHitIndices[MaxContacts];
+    const int32 NumBest = SelectMostRelevantHits(Hits, ProbeLocation, ProbeForward, BestHitIndices);
+
+    FVector PreviousPositions[MaxContacts];
+    uint32 PreviousPrimitiveIds[MaxContacts];
+    uint32 PreviousContactIds[MaxContacts];
+    const int32 NumPrevious = Num;
+
+    for (int32 i = 0; i < NumPrevious; ++i)
+    {
+        PreviousPositions[i] = Positions[i];
+        PreviousPrimitiveIds[i] = PrimitiveIds[i];
+        PreviousContactIds[i] = ContactIds[i];
+    }
+
+    for (int32 i = 0; i < NumBest; ++i)
+    {
+        const FHitResult &Hit = Hits[BestHitIndices[i]];
+        const UPrimitiveComponent *HitComponent = Hit.GetComponent();
+
+        Positions[i] = Hit.ImpactPoint;
+        Normals[i] = Hit.ImpactNormal;
+        PrimitiveIds[i] = HitComponent ? HitComponent->GetUniqueID() : 0;
+    }
+
+    Num = NumBest;
+    CarryContactIds(PreviousPositions, PreviousPrimitiveIds, PreviousContactIds, NumPrevious);
+}
+
+void FClimbContactManifold::UpdateFrom(const FClimbContactManifold &Source)
+{
+    FVector PreviousPositions[MaxContacts];
+    uint32 PreviousPrimitiveIds[MaxContacts];
+    uint32 PreviousContactIds[MaxContacts];
+    const int32 NumPrevious = Num;
+
+    for (int32 i = 0; i < NumPrevious; ++i)
+    {
+        PreviousPositions[i] = Positions[i];
+        PreviousPrimitiveIds[i] = PrimitiveIds[i];
+        PreviousContactIds[i] = ContactIds[i];
+    }
+
+    for (int32 i = 0; i < Source.Num; ++i)
+    {
+        Positions[i] = Source.Positions[i];
+        Normals[i] = Source.Normals[i];
+        PrimitiveIds[i] = Source.PrimitiveIds[i];
+    }
+
+    Num = Source.Num;
+    CarryContactIds(PreviousPositions, PreviousPrimitiveIds, PreviousContactIds, NumPrevious);
+}
+
+void FClimbContactManifold::CarryContactIds(const FVector *PreviousPositions, const uint32 *PreviousPrimitiveIds, const uint32 *PreviousContactIds, int32 NumPrevious)
+{
+    bool bPreviousMatched[MaxContacts] = {};
+
+    for (int32 i = 0; i < Num; ++i)
+    {
+        int32 MatchedIndex = INDEX_NONE;
+        float MatchedDistSquared = FMath::Square(ContactMatchDistance);
+
+        for (int32 PreviousIndex = 0; PreviousIndex < NumPrevious; ++PreviousIndex)
+        {
+            if (bPreviousMatched[PreviousIndex] || PreviousPrimitiveIds[PreviousIndex] != PrimitiveIds[i])
+                continue;
+
+            const float DistSquared = FVector::DistSquared(PreviousPositions[PreviousIndex], Positions[i]);
+            if (DistSquared < MatchedDistSquared)
+            {
+                MatchedDistSquared = DistSquared;
+                MatchedIndex = PreviousIndex;
+            }
+        }
+
+        if (MatchedIndex != INDEX_NONE)
+        {
+            bPreviousMatched[MatchedIndex] = true;
+            ContactIds[i] = PreviousContactIds[MatchedIndex];
+        }
+        else
+        {
+            ContactIds[i] = NextContactId++;
+        }
+    }
+}
+
+void FClimbContactManifold::StoreLocalSpace(const FTransform &BaseTransform)
+{
+    for (int32 i = 0; i < Num; ++i)
+    {
+        if (PrimitiveIds[i] != PrimitiveIds[0])
+            continue;
+
+        LocalPositions[i] = BaseTransform.InverseTransformPosition(Positions[i]);
+        LocalNormals[i] = BaseTransform.InverseTransformVectorNoScale(Normals[i]);
+    }
+}
+
+void FClimbContactManifold::UpdateFromLocalSpace(const FTransform &BaseTransform)
+{
+    int32 NumOnBase = 0;
+
+    for (int32 i = 0; i < Num; ++i)
+    {
+        if (PrimitiveIds[i] != PrimitiveIds[0])
+            continue;
+
+        // Compacted in place, the contacts keep their relevance order
+        Positions[NumOnBase] = BaseTransform.TransformPosition(LocalPositions[i]);
+        Normals[NumOnBase] = BaseTransform.TransformVectorNoScale(LocalNormals[i]);
+        PrimitiveIds[NumOnBase] = PrimitiveIds[i];
+        ContactIds[NumOnBase] = ContactIds[i];
+        LocalPositions[NumOnBase] = LocalPositions[i];
+        LocalNormals[NumOnBase] = LocalNormals[i];
+        ++NumOnBase;
+    }
+
+    Num = NumOnBase;
+}
+
+bool FClimbContactManifold::SpansMultiplePrimitives() const
+{
+    for (int32 i = 1; i < Num; ++i)
+    {
+        if (PrimitiveIds[i] != PrimitiveIds[0])
+            return true;
+    }
+
+    return false;
+}
+
+FVector FClimbContactManifold::GetAverageLocation() const
+{
+    if (IsEmpty())
+        return FVector::ZeroVector;
+
+    FVector Sum = FVector::ZeroVector;
+    for (int32 i = 0; i < Num; ++i)
+    {
+        Sum += Positions[i];
+    }
+
+    return Sum / Num;
+}
+
+FVector FClimbContactManifold::GetAverageNormal() const
+{
+    FVector Sum = FVector::ZeroVector;
+    for (int32 i = 0; i < Num; ++i)
+    {
+        Sum += Normals[i];
+    }
+
+    return Sum.GetSafeNormal();
+}
+
+int32 FClimbContactManifold::FindContactIndexById(uint32 ContactId) const
+{
+    for (int32 i = 0; i < Num; ++i)
+    {
+        if (ContactIds[i] == ContactId)
+            return i;
+    }
+
+    return INDEX_NONE;
+}
+
+bool FClimbContactManifold::FitCorner(FClimbCornerFit &OutCorner, float MinCornerAngle) const
+{
+    OutCorner.Reset();
+
+    if (Num < 2)
+        return false;
+
+    // Seed the planes with the most relevant contact and the one turned furthest from it
+    int32 SecondSeed = INDEX_NONE;
+    float MinDot = FMath::Cos(FMath::DegreesToRadians(MinCornerAngle));
+
+    for (int32 i = 1; i < Num; ++i)
+    {
+        const float Dot = FVector::DotProduct(Normals[i], Normals[0]);
+        if (Dot < MinDot)
+        {
+            MinDot = Dot;
+            SecondSeed = i;
+        }
+    }
+
+    if (SecondSeed == INDEX_NONE)
+        return false;
+
+    FVector NormalSums[2] = {FVector::ZeroVector, FVector::ZeroVector};
+    FVector PointSums[2] = {FVector::ZeroVector, FVector::ZeroVector};
+    int32 Counts[2] = {0, 0};
+
+    for (int32 i = 0; i < Num; ++i)
+    {
+        const int32 Plane = FVector::DotProduct(Normals[i], Normals[0]) >= FVector::DotProduct(Normals[i], Normals[SecondSeed]) ? 0 : 1;
+
+        NormalSums[Plane] += Normals[i];
+        PointSums[Plane] += Positions[i];
+        Counts[Plane]++;
+    }
+
+    for (int32 Plane = 0; Plane < 2; ++Plane)
+    {
+        OutCorner.Normals[Plane] = NormalSums[Plane].GetSafeNormal();
+        OutCorner.Points[Plane] = PointSums[Plane] / Counts[Plane];
+    }
+
+    const FVector EdgeCross = FVector::CrossProduct(OutCorner.Normals[0], OutCorner.Normals[1]);
+    const double EdgeCrossSizeSquared = EdgeCross.SizeSquared();
+    if (EdgeCrossSizeSquared < KINDA_SMALL_NUMBER)
+        return false;
+
+    // Point on both planes, then moved along the edge to the level of the contacts
+    const double PlaneDistances[2] = {
+        FVector::DotProduct(OutCorner.Normals[0], OutCorner.Points[0]),
+        FVector::DotProduct(OutCorner.Normals[1], OutCorner.Points[1])};
+
+    const FVector LinePoint = FVector::CrossProduct(
+        PlaneDistances[0] * OutCorner.Normals[1] - PlaneDistances[1] * OutCorner.Normals[0],
+        EdgeCross) / EdgeCrossSizeSquared;
+
+    OutCorner.EdgeDirection = EdgeCross.GetUnsafeNormal();
+    OutCorner.EdgePoint = LinePoint + OutCorner.EdgeDirection * FVector::DotProduct(GetAverageLocation() - LinePoint, OutCorner.EdgeDirection);
+
+    // The second face lies in front of the first one when they enclose the climber
+    const bool bInner = FVector::DotProduct(OutCorner.Points[1] - OutCorner.Points[0], OutCorner.Normals[0]) > 0.f;
+    OutCorner.Type = bInner ? EClimbCornerType::Inner : EClimbCornerType::Outer;
+    return true;
+}
@@ -0,0 +1,273 @@
+#include "Components/ClimbDistanceFieldUserData.h"
+#include "Components/ClimbMeshGeometry.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "ClimbingSystem.h"
+
+namespace
+{
+    // The dense build grid is temporary, but past this it is cheaper to start at a coarser voxel size
+    constexpr int64 MaxBuildSamples = 64 * 1024 * 1024;
+    constexpr int32 MaxBuildAttempts = 8;
+
+    int32 GetGridIndex(const FIntVector &Coord, const FIntVector &Size)
+    {
+        return (Coord.Z * Size.Y + Coord.Y) * Size.X + Coord.X;
+    }
+}
+
+UClimbDistanceFieldUserData *UClimbDistanceFieldUserData::Get(const UStaticMesh *StaticMesh)
+{
+    if (!StaticMesh)
+        return nullptr;
+
+    return const_cast<UStaticMesh *>(StaticMesh)->GetAssetUserData<UClimbDistanceFieldUserData>();
+}
+
+const UClimbDistanceFieldUserData *UClimbDistanceFieldUserData::Get(const UPrimitiveComponent *Primitive)
+{
+    const UStaticMeshComponent *MeshComponent = Cast<UStaticMeshComponent>(Primitive);
+    if (!MeshComponent || MeshComponent->IsA<UInstancedStaticMeshComponent>())
+        return nullptr;
+
+    const UClimbDistanceFieldUserData *Field = Get(MeshComponent->GetStaticMesh());
+    return Field && !Field->IsEmpty() ? Field : nullptr;
+}
+
+int32 UClimbDistanceFieldUserData::GetFieldBytes() const
+{
+    return BrickTable.Num() * BrickTable.GetTypeSize() + BrickSamples.Num();
+}
+
+void UClimbDistanceFieldUserData::Generate(const UStaticMesh &StaticMesh, const FClimbDistanceFieldBuildSettings &Settings)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+    BrickTable.Empty();
+    BrickSamples.Empty();
+    BrickGridSize = FIntVector::ZeroValue;
+
+    FClimbMeshGeometry Geometry;
+    Geometry.Build(StaticMesh);
+
+    SourceTriangleCount = Geometry.GetNumTriangles();
+    if (SourceTriangleCount == 0)
+        return;
+
+    const FBox3f Bounds(StaticMesh.GetBoundingBox());
+    float AttemptVoxelSize = FMath::Max(Settings.VoxelSize, 1.f);
+
+    for (int32 Attempt = 0; Attempt < MaxBuildAttempts; ++Attempt, AttemptVoxelSize *= 2.f)
+    {
+        if (Build(Geometry, Bounds, AttemptVoxelSize, FMath::Max(Settings.BandVoxels, 1), Settings.MaxBytes))
+            return;
+    }
+
+    BrickTable.Empty();
+    BrickSamples.Empty();
+    BrickGridSize = FIntVector::ZeroValue;
+    UE_LOG(LogClimbing, Warning, TEXT("%s: no distance field fits in %d bytes"), *StaticMesh.GetPathName(), Settings.MaxBytes);
+}
+
+bool UClimbDistanceFieldUserData::Build(const FClimbMeshGeometry &Geometry, const FBox3f &Bounds, float InVoxelSize, int32 BandVoxels, int32 MaxBytes)
+{
+    VoxelSize = InVoxelSize;
+    BandDistance = BandVoxels * VoxelSize;
+    Origin = Bounds.Min - FVector3f(BandDistance);
+
+    const FVector3f PaddedSize = Bounds.GetSize() + FVector3f(BandDistance * 2.f);
+    BrickGridSize = FIntVector(
+        FMath::Max(FMath::CeilToInt(PaddedSize.X / (VoxelSize * BrickCells)), 1),
+        FMath::Max(FMath::CeilToInt(PaddedSize.Y / (VoxelSize * BrickCells)), 1),
+        FMath::Max(FMath::CeilToInt(PaddedSize.Z / (VoxelSize * BrickCells)), 1));
+
+    const int64 NumBricks = int64(BrickGridSize.X) * BrickGridSize.Y * BrickGridSize.Z;
+    if (NumBricks * int64(sizeof(int32)) > MaxBytes)
+        return false;
+
+    const FIntVector SampleGridSize = BrickGridSize * BrickCells + FIntVector(1);
+    const int64 NumSamples = int64(SampleGridSize.X) * SampleGridSize.Y * SampleGridSize.Z;
+    if (NumSamples > MaxBuildSamples)
+        return false;
+
+    // Narrow band only: every triangle writes the samples within the band of it, keeping the closest.
+    // Samples the band never reaches read as outside, climb queries never start deeper inside than that
+    TArray<float> Distances;
+    TArray<float> Alignments;
+    Distances.Init(BandDistance, int32(NumSamples));
+    Alignments.Init(0.f, int32(NumSamples));
+
+    for (int32 TriangleIndex = 0; TriangleIndex < SourceTriangleCount; ++TriangleIndex)
+    {
+        const int32 *Corners = &Geometry.Indices[TriangleIndex * 3];
+        const FVector A(Geometry.Positions[Corners[0]]);
+        const FVector B(Geometry.Positions[Corners[1]]);
+        const FVector C(Geometry.Positions[Corners[2]]);
+
+        FVector Normal = FVector::CrossProduct(B - A, C - A).GetSafeNormal();
+        if (Normal.IsZero())
+            continue;
+
+        const FVector VertexNormal(Geometry.VertexNormals[Corners[0]] + Geometry.VertexNormals[Corners[1]] + Geometry.VertexNormals[Corners[2]]);
+        if (FVector::DotProduct(Normal, VertexNormal) < 0.f)
+        {
+            Normal = -Normal;
+        }
+
+        const FVector3f TriangleMin = FVector3f(A.ComponentMin(B).ComponentMin(C)) - FVector3f(BandDistance) - Origin;
+        const FVector3f TriangleMax = FVector3f(A.ComponentMax(B).ComponentMax(C)) + FVector3f(BandDistance) - Origin;
+
+        const FIntVector MinSample(
+            FMath::Clamp(FMath::CeilToInt(TriangleMin.X / VoxelSize), 0, SampleGridSize.X - 1),
+            FMath::Clamp(FMath::CeilToInt(TriangleMin.Y / VoxelSize), 0, SampleGridSize.Y - 1),
+            FMath::Clamp(FMath::CeilToInt(TriangleMin.Z / VoxelSize), 0, SampleGridSize.Z - 1));
+        const FIntVector MaxSample(
+            FMath::Clamp(FMath::FloorToInt(TriangleMax.X / VoxelSize), 0, SampleGridSize.X - 1),
+            FMath::Clamp(FMath::FloorToInt(TriangleMax.Y / VoxelSize), 0, SampleGridSize.Y - 1),
+            FMath::Clamp(FMath::FloorToInt(TriangleMax.Z / VoxelSize), 0, SampleGridSize.Z - 1));
+
+        for (int32 Z = MinSample.Z; Z <= MaxSample.Z; ++Z)
+        {
+            for (int32 Y = MinSample.Y; Y <= MaxSample.Y; ++Y)
+            {
+                for (int32 X = MinSample.X; X <= MaxSample.X; ++X)
+                {
+                    const FVector Point = FVector(Origin) + FVector(X, Y, Z) * VoxelSize;
+                    const FVector Closest = FMath::ClosestPointOnTriangleToPoint(Point, A, B, C);
+                    const FVector ToPoint = Point - Closest;
+                    const float Distance = ToPoint.Size();
+
+                    const int32 SampleIndex = GetGridIndex(FIntVector(X, Y, Z), SampleGridSize);
+                    const float StoredDistance = FMath::Abs(Distances[SampleIndex]);
+                    if (Distance > StoredDistance + UE_KINDA_SMALL_NUMBER)
+                        continue;
+
+                    // Around edges and corners several triangles are equally close, the one facing the point decides the sign
+                    const float Alignment = Distance > UE_KINDA_SMALL_NUMBER ? FMath::Abs(FVector::DotProduct(ToPoint / Distance, Normal)) : 1.f;
+                    if (Distance > StoredDistance - UE_KINDA_SMALL_NUMBER && Alignment <= Alignments[SampleIndex])
+                        continue;
+
+                    Distances[SampleIndex] = FVector::DotProduct(ToPoint, Normal) >= 0.f ? Distance : -Distance;
+                    Alignments[SampleIndex] = Alignment;
+                }
+            }
+        }
+    }
+
+    BrickTable.Init(INDEX_NONE, int32(NumBricks));
+    BrickSamples.Reset();
+
+    const float QuantizeScale = 127.5f / BandDistance;
+
+    for (int32 BrickZ = 0; BrickZ < BrickGridSize.Z; ++BrickZ)
+    {
+        for (int32 BrickY = 0; BrickY < BrickGridSize.Y; ++BrickY)
+        {
+            for (int32 BrickX = 0; BrickX < BrickGridSize.X; ++BrickX)
+            {
+                const FIntVector FirstSample = FIntVector(BrickX, BrickY, BrickZ) * BrickCells;
+                uint8 Brick[BrickSampleCount];
+                bool bNearSurface = false;
+
+                for (int32 Z = 0; Z < BrickSize; ++Z)
+                {
+                    for (int32 Y = 0; Y < BrickSize; ++Y)
+                    {
+                        for (int32 X = 0; X < BrickSize; ++X)
+                        {
+                            const float Distance = Distances[GetGridIndex(FirstSample + FIntVector(X, Y, Z), SampleGridSize)];
+                            bNearSurface |= FMath::Abs(Distance) < BandDistance;
+                            Brick[GetGridIndex(FIntVector(X, Y, Z), FIntVector(BrickSize))] =
+                                uint8(FMath::Clamp(FMath::RoundToInt((Distance + BandDistance) * QuantizeScale), 0, 255));
+                        }
+                    }
+                }
+
+                if (!bNearSurface)
+                    continue;
+
+                if (BrickTable.Num() * int64(sizeof(int32)) + BrickSamples.Num() + BrickSampleCount > MaxBytes)
+                    return false;
+
+                BrickTable[GetGridIndex(FIntVector(BrickX, BrickY, BrickZ), BrickGridSize)] = BrickSamples.Num() / BrickSampleCount;
+                BrickSamples.Append(Brick, BrickSampleCount);
+            }
+        }
+    }
+
+    BrickSamples.Shrink();
+    return true;
+}
+
+bool UClimbDistanceFieldUserData::Sample(const FVector3f &MeshPosition, float &OutDistance, FVector3f &OutGradient) const
+{
+    const FVector3f GridPosition = (MeshPosition - Origin) / VoxelSize;
+    const FIntVector Cell(FMath::FloorToInt(GridPosition.X), FMath::FloorToInt(GridPosition.Y), FMath::FloorToInt(GridPosition.Z));
+
+    if (Cell.X < 0 || Cell.Y < 0 || Cell.Z < 0)
+        return false;
+
+    const FIntVector BrickCoord(Cell.X / BrickCells, Cell.Y / BrickCells, Cell.Z / BrickCells);
+    if (BrickCoord.X >= BrickGridSize.X || BrickCoord.Y >= BrickGridSize.Y || BrickCoord.Z >= BrickGridSize.Z)
+        return false;
+
+    const int32 Brick = BrickTable[GetGridIndex(BrickCoord, BrickGridSize)];
+    if (Brick == INDEX_NONE)
+        return false;
+
+    // Bricks share border samples, so all eight corners of the cell are in this brick
+    const FIntVector Local = Cell - BrickCoord * BrickCells;
+    const uint8 *Corner = &BrickSamples[Brick * BrickSampleCount + GetGridIndex(Local, FIntVector(BrickSize))];
+    constexpr int32 RowStride = BrickSize;
+    constexpr int32 SliceStride = BrickSize * BrickSize;
+
+    const uint8 LowerFace[4] = {Corner[0], Corner[1], Corner[RowStride], Corner[RowStride + 1]};
+    const uint8 UpperFace[4] = {Corner[SliceStride], Corner[SliceStride + 1], Corner[SliceStride + RowStride], Corner[SliceStride + RowStride + 1]};
+
+    const VectorRegister4Float DequantizeScale = VectorSetFloat1(BandDistance / 127.5f);
+    const VectorRegister4Float DequantizeBias = VectorSetFloat1(-BandDistance);
+    const VectorRegister4Float Lower = VectorMultiplyAdd(VectorLoadByte4(LowerFace), DequantizeScale, DequantizeBias);
+    const VectorRegister4Float Upper = VectorMultiplyAdd(VectorLoadByte4(UpperFace), DequantizeScale, DequantizeBias);
+
+    const float FX = GridPosition.X - Cell.X;
+    const float FY = GridPosition.Y - Cell.Y;
+    const float FZ = GridPosition.Z - Cell.Z;
+
+    // Collapse along Z first, the remaining bilinear weights and their X and Y derivatives are dot products
+    const VectorRegister4Float DeltaZ = VectorSubtract(Upper, Lower);
+    const VectorRegister4Float Face = VectorMultiplyAdd(DeltaZ, VectorSetFloat1(FZ), Lower);
+
+    const VectorRegister4Float Weights = MakeVectorRegisterFloat((1.f - FX) * (1.f - FY), FX * (1.f - FY), (1.f - FX) * FY, FX * FY);
+    const VectorRegister4Float WeightsDX = MakeVectorRegisterFloat(FY - 1.f, 1.f - FY, -FY, FY);
+    const VectorRegister4Float WeightsDY = MakeVectorRegisterFloat(FX - 1.f, -FX, 1.f - FX, FX);
+
+    float GradientX, GradientY, GradientZ;
+    VectorStoreFloat1(VectorDot4(Face, Weights), &OutDistance);
+    VectorStoreFloat1(VectorDot4(Face, WeightsDX), &GradientX);
+    VectorStoreFloat1(VectorDot4(Face, WeightsDY), &GradientY);
+    VectorStoreFloat1(VectorDot4(DeltaZ, Weights), &GradientZ);
+
+    OutGradient = FVector3f(GradientX, GradientY, GradientZ) / VoxelSize;
+
+    // Clamped samples at the band edge have no usable gradient
+    return FMath::Abs(OutDistance) < BandDistance - VoxelSize;
+}
+
+bool UClimbDistanceFieldUserData::SampleWorld(const FTransform &ComponentTransform, const FVector &WorldPosition, float &OutDistance, FVector &OutNormal) const
+{
+    const FVector Scale = ComponentTransform.GetScale3D();
+    if (Scale.GetAbsMin() <= UE_KINDA_SMALL_NUMBER)
+        return false;
+
+    float MeshDistance;
+    FVector3f MeshGradient;
+    if (!Sample(FVector3f(ComponentTransform.InverseTransformPosition(WorldPosition)), MeshDistance, MeshGradient))
+        return false;
+
+    // Scaling stretches distances, the smallest axis keeps them conservative
+    OutDistance = MeshDistance * Scale.GetAbsMin();
+    OutNormal = ComponentTransform.TransformVectorNoScale(FVector(MeshGradient) / Scale).GetSafeNormal();
+
+    return !OutNormal.IsZero();
+}
@@ -0,0 +1,443 @@
+#include "Components/ClimbEffectsSubsystem.h"
+#include "Components/CustomMovementComponent.h"
+#include "Components/AudioComponent.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "Sound/SoundBase.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "Algo/Count.h"
+#include "ClimbingSystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Climb Effects Spawn"), STAT_ClimbEffectsSpawn, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Effect Requests"), STAT_ClimbEffectRequests, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Effects Culled"), STAT_ClimbEffectsCulled, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Effects Over Budget"), STAT_ClimbEffectsOverBudget, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Effects Spawned"), STAT_ClimbEffectsSpawned, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Effect Pool Exhausted"), STAT_ClimbEffectPoolExhausted, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Effect Surface Cache Misses"), STAT_ClimbEffectSurfaceCacheMisses, STATGROUP_Climbing);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Climb Effect Active Audio"), STAT_ClimbEffectActiveAudio, STATGROUP_Climbing);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Climb Effect Active Niagara"), STAT_ClimbEffectActiveNiagara, STATGROUP_Climbing);
+
+namespace
+{
+    constexpr int32 NumEffects = int32(EClimbEffect::Num);
+    constexpr int32 NumSurfaceTypes = int32(SurfaceType_Max);
+
+    int32 GetResolvedEffectIndex(EClimbEffect Effect, EPhysicalSurface SurfaceType)
+    {
+        return int32(Effect) * NumSurfaceTypes + int32(SurfaceType);
+    }
+
+    // Round robin from Next, so the components that finished longest ago are reused first
+    template <typename ComponentType, typename IsBusyType>
+    ComponentType *AcquirePooled(const TArray<ComponentType *> &Pool, int32 &Next, IsBusyType IsBusy)
+    {
+        for (int32 i = 0; i < Pool.Num(); ++i)
+        {
+            const int32 Index = (Next + i) % Pool.Num();
+            if (Pool[Index] && !IsBusy(*Pool[Index]))
+            {
+                Next = (Index + 1) % Pool.Num();
+                return Pool[Index];
+            }
+        }
+        return nullptr;
+    }
+
+    FAutoConsoleCommandWithWorld ReportClimbEffectsCommand(
+        TEXT("Climb.ReportEffects"),
+        TEXT("Logs and resets the climb effect requests, culling, spawns and pool use"),
+        FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld *World)
+        {
+            UClimbEffectsSubsystem *Subsystem = World ? World->GetSubsystem<UClimbEffectsSubsystem>() : nullptr;
+            if (!Subsystem)
+                return;
+
+            FClimbEffectStats &Stats = Subsystem->GetStats();
+            UE_LOG(LogClimbing, Display, TEXT("Climb effects: %d requested, %d culled, %d merged, %d over budget, %d spawned, %d dropped on a full pool"),
+                Stats.NumRequested,
+                Stats.NumCulled,
+                Stats.NumMerged,
+                Stats.NumOverBudget,
+                Stats.NumSpawned,
+                Stats.NumPoolExhausted);
+            UE_LOG(LogClimbing, Display, TEXT("Climb effects: %d surface lookups, %d cache misses, audio pool %d/%d active, Niagara pool %d/%d active"),
+                Stats.NumSurfaceLookups,
+                Stats.NumSurfaceCacheMisses,
+                Subsystem->GetNumActiveAudio(),
+                Subsystem->GetAudioPoolSize(),
+                Subsystem->GetNumActiveNiagara(),
+                Subsystem->GetNiagaraPoolSize());
+
+            Stats = FClimbEffectStats();
+        }));
+}
+
+bool UClimbEffectsSubsystem::ShouldCreateSubsystem(UObject *Outer) const
+{
+    // Climb effects are purely cosmetic
+    const UWorld *World = Cast<UWorld>(Outer);
+    return Super::ShouldCreateSubsystem(Outer) && World && World->IsGameWorld() && !IsRunningDedicatedServer();
+}
+
+void UClimbEffectsSubsystem::OnWorldBeginPlay(UWorld &InWorld)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+    Super::OnWorldBeginPlay(InWorld);
+
+    LoadEffects();
+    CreatePools(InWorld);
+
+    PendingRequests.Reserve(GetDefault<UClimbEffectsSettings>()->MaxSpawnsPerFrame * 2);
+}
+
+void UClimbEffectsSubsystem::Deinitialize()
+{
+    if (PoolActor)
+    {
+        PoolActor->Destroy();
+        PoolActor = nullptr;
+    }
+
+    AudioPool.Reset();
+    NiagaraPool.Reset();
+
+    Super::Deinitialize();
+}
+
+TStatId UClimbEffectsSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UClimbEffectsSubsystem, STATGROUP_Tickables);
+}
+
+void UClimbEffectsSubsystem::LoadEffects()
+{
+    ResolvedEffects.Reset();
+    ResolvedEffects.SetNum(NumEffects * NumSurfaceTypes);
+    LoadedEffectAssets.Reset();
+
+    // Loaded up front, a first use mid climb must not hitch on a synchronous load
+    for (const FClimbSurfaceEffect &Entry : GetDefault<UClimbEffectsSettings>()->Effects)
+    {
+        if (Entry.Effect >= EClimbEffect::Num)
+            continue;
+
+        FResolvedEffect &Resolved = ResolvedEffects[GetResolvedEffectIndex(Entry.Effect, Entry.SurfaceType)];
+        Resolved.Sound = Entry.Sound.LoadSynchronous();
+        Resolved.Niagara = Entry.Niagara.LoadSynchronous();
+
+        if (Resolved.Sound)
+        {
+            LoadedEffectAssets.Add(Resolved.Sound);
+        }
+        if (Resolved.Niagara)
+        {
+            LoadedEffectAssets.Add(Resolved.Niagara);
+        }
+    }
+}
+
+void UClimbEffectsSubsystem::CreatePools(UWorld &InWorld)
+{
+    const UClimbEffectsSettings *Settings = GetDefault<UClimbEffectsSettings>();
+
+    const bool bAnySound = ResolvedEffects.ContainsByPredicate([](const FResolvedEffect &Resolved) { return Resolved.Sound != nullptr; });
+    const bool bAnyNiagara = ResolvedEffects.ContainsByPredicate([](const FResolvedEffect &Resolved) { return Resolved.Niagara != nullptr; });
+
+    if (!bAnySound && !bAnyNiagara)
+        return;
+
+    FActorSpawnParameters SpawnParameters;
+    SpawnParameters.ObjectFlags = RF_Transient;
+    PoolActor = InWorld.SpawnActor<AActor>(SpawnParameters);
+
+    USceneComponent *Root = NewObject<USceneComponent>(PoolActor);
+    PoolActor->SetRootComponent(Root);
+    Root->RegisterComponent();
+
+    // Every component is made once here, spawning an effect only moves and restarts one
+    for (int32 i = 0; bAnySound && i < Settings->AudioPoolSize; ++i)
+    {
+        UAudioComponent *Audio = NewObject<UAudioComponent>(PoolActor);
+        Audio->bAutoActivate = false;
+        Audio->bAutoDestroy = false;
+        Audio->SetUsingAbsoluteLocation(true);
+        Audio->SetupAttachment(Root);
+        Audio->RegisterComponent();
+        AudioPool.Add(Audio);
+    }
+
+    for (int32 i = 0; bAnyNiagara && i < Settings->NiagaraPoolSize; ++i)
+    {
+        UNiagaraComponent *Niagara = NewObject<UNiagaraComponent>(PoolActor);
+        Niagara->SetAutoActivate(false);
+        Niagara->SetAutoDestroy(false);
+        Niagara->SetUsingAbsoluteLocation(true);
+        Niagara->SetUsingAbsoluteRotation(true);
+        Niagara->SetupAttachment(Root);
+        Niagara->RegisterComponent();
+        NiagaraPool.Add(Niagara);
+    }
+}
+
+void UClimbEffectsSubsystem::RegisterClimber(UCustomMovementComponent &Climber)
+{
+    Climber.OnClimbEventDelegate.AddUObject(this, &ThisClass::OnClimbEvent, TWeakObjectPtr<UCustomMovementComponent>(&Climber));
+}
+
+void UClimbEffectsSubsystem::OnClimbEvent(const FClimbEvent &Event, TWeakObjectPtr<UCustomMovementComponent> WeakClimber)
+{
+    const UCustomMovementComponent *Climber = WeakClimber.Get();
+    if (!Climber || !Climber->GetCharacterOwner())
+        return;
+
+    UPrimitiveComponent *Base = Climber->GetCharacterOwner()->GetMovementBase();
+
+    switch (Event.Type)
+    {
+    case EClimbEventType::LedgeReached:
+    case EClimbEventType::ClimbStarted:
+        // Events arrive after the tick, by then a climber that reached the ledge may already hang from it
+        if (Climber->IsHanging() && Climber->GetHangLedge().IsValid())
+        {
+            const FVector GrabLocation = Climber->GetHangLedge().GetPointAtDistance(Climber->GetHangDistance());
+            RequestEffect(EClimbEffect::LedgeGrab, GrabLocation, FVector::UpVector, Base);
+        }
+        else if (Event.Type == EClimbEventType::LedgeReached)
+        {
+            RequestEffect(EClimbEffect::LedgeGrab, Climber->GetClimbableSurfaceLocation(), Climber->GetClimbableSurfaceNormal(), Base);
+        }
+        break;
+    case EClimbEventType::ActionFinished:
+        // The vault ended on the floor, which the movement update after the transition has found
+        if (Event.Montage && Event.Montage == Climber->GetVaultMontage() && Event.Reason != EClimbActionEndReason::Interrupted && Climber->CurrentFloor.bBlockingHit)
+        {
+            const FHitResult &Floor = Climber->CurrentFloor.HitResult;
+            RequestEffect(EClimbEffect::VaultImpact, Floor.ImpactPoint, Floor.ImpactNormal, Floor.GetComponent(), Floor.PhysMaterial.Get());
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+void UClimbEffectsSubsystem::RequestEffect(EClimbEffect Effect, const FVector &Location, const FVector &Normal, UPrimitiveComponent *Surface, const UPhysicalMaterial *HitMaterial)
+{
+    if (Effect >= EClimbEffect::Num)
+        return;
+
+    INC_DWORD_STAT(STAT_ClimbEffectRequests);
+    Stats.NumRequested++;
+
+    const float ViewDistanceSquared = GetViewDistanceSquared(Location);
+    if (ViewDistanceSquared > FMath::Square(GetDefault<UClimbEffectsSettings>()->CullDistance))
+    {
+        INC_DWORD_STAT(STAT_ClimbEffectsCulled);
+        Stats.NumCulled++;
+        return;
+    }
+
+    // Both hands planting on one hold, or several climbers reaching the same ledge, sound as one
+    const float MergeDistanceSquared = FMath::Square(GetDefault<UClimbEffectsSettings>()->MergeDistance);
+    for (const FEffectRequest &Pending : PendingRequests)
+    {
+        if (Pending.Effect == Effect && FVector::DistSquared(Pending.Location, Location) < MergeDistanceSquared)
+        {
+            Stats.NumMerged++;
+            return;
+        }
+    }
+
+    FEffectRequest &Request = PendingRequests.AddDefaulted_GetRef();
+    Request.Effect = Effect;
+    Request.SurfaceType = GetSurfaceType(Surface, HitMaterial);
+    Request.Location = Location;
+    Request.Normal = Normal;
+    Request.ViewDistanceSquared = ViewDistanceSquared;
+}
+
+EPhysicalSurface UClimbEffectsSubsystem::GetSurfaceType(UPrimitiveComponent *Surface, const UPhysicalMaterial *HitMaterial)
+{
+    Stats.NumSurfaceLookups++;
+
+    // The hit carries the material of the face it touched, mesh material and landscape layer included
+    if (HitMaterial)
+    {
+        const EPhysicalSurface SurfaceType = UPhysicalMaterial::DetermineSurfaceType(HitMaterial);
+        if (Surface)
+        {
+            CacheSurfaceType(*Surface, SurfaceType);
+        }
+        return SurfaceType;
+    }
+
+    if (!Surface)
+        return SurfaceType_Default;
+
+    // Requests without a hit, such as limbs planted on a reused climb contact, take the last surface hit on the primitive
+    if (const EPhysicalSurface *Cached = SurfaceTypes.Find(Surface))
+        return *Cached;
+
+    INC_DWORD_STAT(STAT_ClimbEffectSurfaceCacheMisses);
+    Stats.NumSurfaceCacheMisses++;
+
+    const FBodyInstance *BodyInstance = Surface->GetBodyInstance();
+    const EPhysicalSurface SurfaceType = UPhysicalMaterial::DetermineSurfaceType(BodyInstance ? BodyInstance->GetSimplePhysicalMaterial() : nullptr);
+
+    CacheSurfaceType(*Surface, SurfaceType);
+    return SurfaceType;
+}
+
+void UClimbEffectsSubsystem::CacheSurfaceType(UPrimitiveComponent &Surface, EPhysicalSurface SurfaceType)
+{
+    if (SurfaceTypes.Num() >= GetDefault<UClimbEffectsSettings>()->MaxCachedSurfaces && !SurfaceTypes.Contains(&Surface))
+    {
+        SurfaceTypes.Reset();
+    }
+    SurfaceTypes.Add(&Surface, SurfaceType);
+}
+
+float UClimbEffectsSubsystem::GetViewDistanceSquared(const FVector &Location) const
+{
+    float ClosestSquared = MAX_flt;
+    for (const FVector &ViewerLocation : ViewerLocations)
+    {
+        ClosestSquared = FMath::Min(ClosestSquared, float(FVector::DistSquared(ViewerLocation, Location)));
+    }
+    return ClosestSquared;
+}
+
+void UClimbEffectsSubsystem::Tick(float DeltaTime)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+    Super::Tick(DeltaTime);
+
+    SpawnPendingEffects();
+    UpdateViewerLocations();
+
+    SET_DWORD_STAT(STAT_ClimbEffectActiveAudio, GetNumActiveAudio());
+    SET_DWORD_STAT(STAT_ClimbEffectActiveNiagara, GetNumActiveNiagara());
+}
+
+void UClimbEffectsSubsystem::UpdateViewerLocations()
+{
+    ViewerLocations.Reset();
+
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController *PlayerController = It->Get();
+        if (PlayerController && PlayerController->IsLocalController() && PlayerController->PlayerCameraManager)
+        {
+            ViewerLocations.Add(PlayerController->PlayerCameraManager->GetCameraLocation());
+        }
+    }
+}
+
+void UClimbEffectsSubsystem::SpawnPendingEffects()
+{
+    if (PendingRequests.IsEmpty())
+        return;
+
+    SCOPE_CYCLE_COUNTER(STAT_ClimbEffectsSpawn);
+
+    const UClimbEffectsSettings *Settings = GetDefault<UClimbEffectsSettings>();
+
+    // Closest first, the frame budget goes to the effects most likely to be noticed
+    PendingRequests.Sort([](const FEffectRequest &A, const FEffectRequest &B) { return A.ViewDistanceSquared < B.ViewDistanceSquared; });
+
+    int32 NumSpawned = 0;
+    int32 NumSpawnedPerEffect[NumEffects] = {};
+
+    for (const FEffectRequest &Request : PendingRequests)
+    {
+        int32 &NumSpawnedOfEffect = NumSpawnedPerEffect[int32(Request.Effect)];
+        if (NumSpawned >= Settings->MaxSpawnsPerFrame || NumSpawnedOfEffect >= Settings->MaxSpawnsPerEffectPerFrame)
+        {
+            INC_DWORD_STAT(STAT_ClimbEffectsOverBudget);
+            Stats.NumOverBudget++;
+            continue;
+        }
+
+        const FResolvedEffect &Resolved = GetResolvedEffect(Request.Effect, Request.SurfaceType);
+
+        bool bSpawned = false;
+        if (Resolved.Sound)
+        {
+            bSpawned |= PlaySound(Resolved.Sound, Request);
+        }
+        if (Resolved.Niagara)
+        {
+            bSpawned |= PlayNiagara(Resolved.Niagara, Request);
+        }
+
+        if (bSpawned)
+        {
+            INC_DWORD_STAT(STAT_ClimbEffectsSpawned);
+            Stats.NumSpawned++;
+            NumSpawned++;
+            NumSpawnedOfEffect++;
+        }
+    }
+
+    PendingRequests.Reset();
+}
+
+const UClimbEffectsSubsystem::FResolvedEffect &UClimbEffectsSubsystem::GetResolvedEffect(EClimbEffect Effect, EPhysicalSurface SurfaceType) const
+{
+    const FResolvedEffect &Resolved = ResolvedEffects[GetResolvedEffectIndex(Effect, SurfaceType)];
+    if (Resolved.Sound || Resolved.Niagara)
+        return Resolved;
+
+    return ResolvedEffects[GetResolvedEffectIndex(Effect, SurfaceType_Default)];
+}
+
+bool UClimbEffectsSubsystem::PlaySound(USoundBase *Sound, const FEffectRequest &Request)
+{
+    UAudioComponent *Audio = AcquirePooled(AudioPool, NextAudio, [](const UAudioComponent &Component) { return Component.IsPlaying(); });
+    if (!Audio)
+    {
+        INC_DWORD_STAT(STAT_ClimbEffectPoolExhausted);
+        Stats.NumPoolExhausted++;
+        return false;
+    }
+
+    Audio->SetWorldLocation(Request.Location);
+    Audio->SetSound(Sound);
+    Audio->Play();
+    return true;
+}
+
+bool UClimbEffectsSubsystem::PlayNiagara(UNiagaraSystem *System, const FEffectRequest &Request)
+{
+    UNiagaraComponent *Niagara = AcquirePooled(NiagaraPool, NextNiagara, [](const UNiagaraComponent &Component) { return Component.IsActive(); });
+    if (!Niagara)
+    {
+        INC_DWORD_STAT(STAT_ClimbEffectPoolExhausted);
+        Stats.NumPoolExhausted++;
+        return false;
+    }
+
+    if (Niagara->GetAsset() != System)
+    {
+        Niagara->SetAsset(System);
+    }
+    Niagara->SetWorldLocationAndRotation(Request.Location, Request.Normal.Rotation());
+    Niagara->Activate(true);
+    return true;
+}
+
+int32 UClimbEffectsSubsystem::GetNumActiveAudio() const
+{
+    return Algo::CountIf(AudioPool, [](const UAudioComponent *Component) { return Component && Component->IsPlaying(); });
+}
+
+int32 UClimbEffectsSubsystem::GetNumActiveNiagara() const
+{
+    return Algo::CountIf(NiagaraPool, [](const UNiagaraComponent *Component) { return Component && Component->IsActive(); });
+}
@@ -0,0 +1,55 @@
+#include "Components/ClimbEventQueue.h"
+#include "ClimbingSystem.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Events Posted"), STAT_ClimbEventsPosted, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Events Coalesced"), STAT_ClimbEventsCoalesced, STATGROUP_Climbing);
+
+void FClimbEventQueue::Post(const FClimbEvent &Event)
+{
+    INC_DWORD_STAT(STAT_ClimbEventsPosted);
+    Stats.NumPosted++;
+
+    int32 Index = INDEX_NONE;
+
+    switch (Event.Type)
+    {
+    case EClimbEventType::ClimbStarted:
+    case EClimbEventType::ClimbEnded:
+    {
+        // Climb to hang or onto a spline leaves one mode and enters the next, to listeners nothing changed
+        const EClimbEventType Opposite = Event.Type == EClimbEventType::ClimbStarted ? EClimbEventType::ClimbEnded : EClimbEventType::ClimbStarted;
+        Index = Pending.FindLastByPredicate([Opposite](const FClimbEvent &Other) { return Other.Type == Opposite; });
+
+        if (Index != INDEX_NONE)
+        {
+            Pending.RemoveAt(Index);
+            Stats.NumCoalesced += 2;
+            INC_DWORD_STAT_BY(STAT_ClimbEventsCoalesced, 2);
+            return;
+        }
+        break;
+    }
+    case EClimbEventType::LedgeReached:
+    case EClimbEventType::CornerStarted:
+        Index = Pending.FindLastByPredicate([&Event](const FClimbEvent &Other) { return Other.Type == Event.Type; });
+
+        if (Index != INDEX_NONE)
+        {
+            Pending[Index] = Event;
+            Stats.NumCoalesced++;
+            INC_DWORD_STAT(STAT_ClimbEventsCoalesced);
+            return;
+        }
+        break;
+    default:
+        break;
+    }
+
+    Pending.Add(Event);
+}
+
+void FClimbEventQueue::TakePending(FEventArray &OutEvents)
+{
+    OutEvents = MoveTemp(Pending);
+    Pending.Reset();
+}
@@ -0,0 +1,51 @@
+#include "Components/ClimbInputBuffer.h"
+
+void FClimbInputBuffer::Press(EClimbInputAction Action, const FClimbBufferedInput &Input)
+{
+    const int32 Index = int32(Action);
+
+    // A newer press replaces the older one, the player's latest intent wins
+    Pending[Index] = Input;
+    Pending[Index].bPending = true;
+    bPendingBlocked[Index] = false;
+}
+
+bool FClimbInputBuffer::UpdatePending(EClimbInputAction Action, double Time)
+{
+    const int32 Index = int32(Action);
+    FClimbBufferedInput &Input = Pending[Index];
+
+    if (!Input.bPending)
+        return false;
+
+    if (Time - Input.PressTime > Windows[Index])
+    {
+        Input.bPending = false;
+        Latencies[Index].NumExpired++;
+        return false;
+    }
+
+    return true;
+}
+
+FClimbBufferedInput FClimbInputBuffer::Consume(EClimbInputAction Action, uint64 Frame)
+{
+    const int32 Index = int32(Action);
+    FClimbBufferedInput Input = Pending[Index];
+    Pending[Index].bPending = false;
+
+    const int32 Frames = int32(Frame - Input.PressFrame);
+
+    FClimbInputLatency &Latency = Latencies[Index];
+    Latency.NumFired++;
+    Latency.NumBuffered += bPendingBlocked[Index] ? 1 : 0;
+    Latency.TotalFrames += Frames;
+    Latency.MaxFrames = FMath::Max(Latency.MaxFrames, Frames);
+
+    return Input;
+}
+
+void FClimbInputBuffer::MarkBlocked(EClimbInputAction Action)
+{
+    bPendingBlocked[int32(Action)] = true;
+}
@@ -0,0 +1,360 @@
+#include "Components/ClimbLimbIKComponent.h"
+#include "Components/CustomMovementComponent.h"
+#include "Components/ClimbQueryBudgetSubsystem.h"
+#include "Components/ClimbEffectsSubsystem.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "ClimbingSystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Climb Limb IK"), STAT_ClimbLimbIK, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Limb IK Probes"), STAT_ClimbLimbIKProbes, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Limb IK Reused Contacts"), STAT_ClimbLimbIKReusedContacts, STATGROUP_Climbing);
+
+namespace
+{
+    constexpr int32 NumLimbs = int32(EClimbLimb::Num);
+
+    bool IsHand(EClimbLimb Limb)
+    {
+        return Limb == EClimbLimb::LeftHand || Limb == EClimbLimb::RightHand;
+    }
+
+    bool IsLeft(EClimbLimb Limb)
+    {
+        return Limb == EClimbLimb::LeftHand || Limb == EClimbLimb::LeftFoot;
+    }
+}
+
+UClimbLimbIKComponent::UClimbLimbIKComponent()
+{
+    PrimaryComponentTick.bCanEverTick = true;
+    PrimaryComponentTick.TickGroup = TG_PrePhysics;
+
+    LimbProbeDelegate.BindUObject(this, &ThisClass::OnLimbProbeDone);
+}
+
+void UClimbLimbIKComponent::OnRegister()
+{
+    Super::OnRegister();
+
+    if (const ACharacter *OwnerCharacter = Cast<ACharacter>(GetOwner()))
+    {
+        OwnerMesh = OwnerCharacter->GetMesh();
+        CustomMovementComponent = Cast<UCustomMovementComponent>(OwnerCharacter->GetCharacterMovement());
+    }
+}
+
+void UClimbLimbIKComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    // Nothing reads a pose on a dedicated server
+    if (IsNetMode(NM_DedicatedServer))
+    {
+        SetComponentTickEnabled(false);
+        return;
+    }
+
+    QueryBudget = GetWorld()->GetSubsystem<UClimbQueryBudgetSubsystem>();
+    ClimbEffects = GetWorld()->GetSubsystem<UClimbEffectsSubsystem>();
+
+    // Targets follow this frame's climb move, and the mesh evaluates with them
+    if (CustomMovementComponent)
+    {
+        AddTickPrerequisiteComponent(CustomMovementComponent);
+    }
+    if (OwnerMesh)
+    {
+        OwnerMesh->PrimaryComponentTick.AddPrerequisite(this, PrimaryComponentTick);
+    }
+}
+
+void UClimbLimbIKComponent::ReadSnapshot(FClimbLimbIKSnapshot &OutSnapshot) const
+{
+    FReadScopeLock Lock(SnapshotLock);
+    OutSnapshot = Snapshot;
+}
+
+void UClimbLimbIKComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    if (!CustomMovementComponent)
+        return;
+
+    SCOPE_CYCLE_COUNTER(STAT_ClimbLimbIK);
+
+    // Climb actions are fully animated, motion warping already puts the limbs where they belong
+    const bool bFreeOnWall = !CustomMovementComponent->IsClimbActionPlaying();
+    const bool bClimbing = bFreeOnWall && CustomMovementComponent->IsClimbing();
+    const bool bHanging = bFreeOnWall && CustomMovementComponent->IsHanging();
+
+    // Offscreen characters keep their planted limbs without probing
+    const bool bVisible = !OwnerMesh || OwnerMesh->WasRecentlyRendered(0.2f);
+    const bool bProbeFrame = bVisible && (GFrameCounter + GetUniqueID()) % GetProbeInterval() == 0;
+
+    if (bClimbing)
+    {
+        UpdateClimbLimbs(bProbeFrame);
+    }
+    else if (bHanging)
+    {
+        UpdateHangLimbs(bProbeFrame);
+    }
+    else
+    {
+        // Probes still in flight are dropped when they arrive
+        for (FPlantedLimb &Limb : PlantedLimbs)
+        {
+            Limb = FPlantedLimb();
+        }
+    }
+
+    UpdateSnapshot(DeltaTime, bClimbing || bHanging);
+}
+
+int32 UClimbLimbIKComponent::GetProbeInterval() const
+{
+    const FVector Location = GetOwner()->GetActorLocation();
+
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController *PlayerController = It->Get();
+        if (!PlayerController || !PlayerController->IsLocalController() || !PlayerController->PlayerCameraManager)
+            continue;
+
+        if (FVector::DistSquared(PlayerController->PlayerCameraManager->GetCameraLocation(), Location) < FMath::Square(FullRateDistance))
+            return 1;
+    }
+
+    return FMath::Max(DistantProbeInterval, 1);
+}
+
+FVector UClimbLimbIKComponent::GetNominalLimbLocation(EClimbLimb Limb, const FVector &SurfaceLocation, const FVector &SurfaceNormal) const
+{
+    const FVector Up = FVector::VectorPlaneProject(GetOwner()->GetActorUpVector(), SurfaceNormal).GetSafeNormal();
+    const FVector Right = FVector::CrossProduct(SurfaceNormal, Up);
+
+    const FVector &Offset = IsHand(Limb) ? HandOffset : FootOffset;
+    const float Side = IsLeft(Limb) ? -1.f : 1.f;
+
+    const FVector OnSurface = FVector::PointPlaneProject(GetOwner()->GetActorLocation(), SurfaceLocation, SurfaceNormal);
+    return OnSurface + Right * Offset.Y * Side + Up * Offset.Z;
+}
+
+void UClimbLimbIKComponent::PlantLimb(FPlantedLimb &Limb, const FVector &Location, const FVector &Normal, UPrimitiveComponent *Base, const UPhysicalMaterial *HitMaterial)
+{
+    // Hanging hands are planted every frame as they slide along the ledge, only a new hold is an effect
+    FVector PreviousLocation;
+    FVector PreviousNormal;
+    const bool bNewHold = !GetPlantedLocation(Limb, PreviousLocation, PreviousNormal) || FVector::DistSquared(PreviousLocation, Location) >= FMath::Square(ReplantDistance);
+
+    if (bNewHold && ClimbEffects)
+    {
+        const EClimbLimb LimbType = EClimbLimb(&Limb - PlantedLimbs);
+        ClimbEffects->RequestEffect(IsHand(LimbType) ? EClimbEffect::HandPlant : EClimbEffect::FootScuff, Location, Normal, Base, HitMaterial);
+    }
+
+    Limb.Base = Base;
+    Limb.bOnBase = Base != nullptr;
+    Limb.bPlanted = true;
+
+    // Kept on the primitive, so limbs move with it between probes
+    if (Base)
+    {
+        const FTransform &BaseTransform = Base->GetComponentTransform();
+        Limb.Location = BaseTransform.InverseTransformPosition(Location);
+        Limb.Normal = BaseTransform.InverseTransformVectorNoScale(Normal);
+    }
+    else
+    {
+        Limb.Location = Location;
+        Limb.Normal = Normal;
+    }
+}
+
+bool UClimbLimbIKComponent::GetPlantedLocation(const FPlantedLimb &Limb, FVector &OutLocation, FVector &OutNormal) const
+{
+    if (!Limb.bPlanted)
+        return false;
+
+    if (!Limb.bOnBase)
+    {
+        OutLocation = Limb.Location;
+        OutNormal = Limb.Normal;
+        return true;
+    }
+
+    const UPrimitiveComponent *Base = Limb.Base.Get();
+    if (!Base)
+        return false;
+
+    const FTransform &BaseTransform = Base->GetComponentTransform();
+    OutLocation = BaseTransform.TransformPosition(Limb.Location);
+    OutNormal = BaseTransform.TransformVectorNoScale(Limb.Normal);
+    return true;
+}
+
+bool UClimbLimbIKComponent::TryReuseClimbContact(const FVector &NominalLocation, const FVector &SurfaceNormal, FVector &OutLocation, FVector &OutNormal) const
+{
+    const FClimbContactManifold &Contacts = CustomMovementComponent->GetClimbContacts();
+
+    for (int32 i = 0; i < Contacts.Num; ++i)
+    {
+        const FVector AlongSurface = FVector::VectorPlaneProject(Contacts.Positions[i] - NominalLocation, SurfaceNormal);
+
+        if (AlongSurface.SizeSquared() < FMath::Square(ContactReuseRadius))
+        {
+            OutLocation = Contacts.Positions[i];
+            OutNormal = Contacts.Normals[i];
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void UClimbLimbIKComponent::UpdateClimbLimbs(bool bProbeFrame)
+{
+    const FVector SurfaceNormal = CustomMovementComponent->GetClimbableSurfaceNormal();
+    if (SurfaceNormal.IsNearlyZero())
+        return;
+
+    const FVector SurfaceLocation = CustomMovementComponent->GetClimbableSurfaceLocation();
+
+    for (int32 Index = 0; Index < NumLimbs; ++Index)
+    {
+        UpdateWallLimb(EClimbLimb(Index), SurfaceLocation, SurfaceNormal, bProbeFrame, true);
+    }
+}
+
+void UClimbLimbIKComponent::UpdateHangLimbs(bool bProbeFrame)
+{
+    const FClimbLedgeSegment &Ledge = CustomMovementComponent->GetHangLedge();
+    if (!Ledge.IsValid())
+        return;
+
+    const float HangDistance = CustomMovementComponent->GetHangDistance();
+    UPrimitiveComponent *Base = CustomMovementComponent->GetCharacterOwner()->GetMovementBase();
+
+    // Hands hold the ledge, the hang segment already is their target
+    for (const EClimbLimb Hand : {EClimbLimb::LeftHand, EClimbLimb::RightHand})
+    {
+        const float Side = IsLeft(Hand) ? -1.f : 1.f;
+        PlantLimb(PlantedLimbs[int32(Hand)], Ledge.GetPointAtDistance(HangDistance + Side * HandOffset.Y), FVector::UpVector, Base);
+    }
+
+    // The hang does not sweep for contacts, so feet always probe the wall
+    const FVector EdgePoint = Ledge.GetPointAtDistance(HangDistance);
+    UpdateWallLimb(EClimbLimb::LeftFoot, EdgePoint, Ledge.WallNormal, bProbeFrame, false);
+    UpdateWallLimb(EClimbLimb::RightFoot, EdgePoint, Ledge.WallNormal, bProbeFrame, false);
+}
+
+void UClimbLimbIKComponent::UpdateWallLimb(EClimbLimb Limb, const FVector &SurfaceLocation, const FVector &SurfaceNormal, bool bProbeFrame, bool bReuseClimbContacts)
+{
+    FPlantedLimb &Planted = PlantedLimbs[int32(Limb)];
+    const FVector NominalLocation = GetNominalLimbLocation(Limb, SurfaceLocation, SurfaceNormal);
+
+    FVector Location;
+    FVector Normal;
+
+    if (GetPlantedLocation(Planted, Location, Normal) && FVector::DistSquared(Location, NominalLocation) < FMath::Square(ReplantDistance))
+        return;
+
+    if (bReuseClimbContacts && TryReuseClimbContact(NominalLocation, SurfaceNormal, Location, Normal))
+    {
+        INC_DWORD_STAT(STAT_ClimbLimbIKReusedContacts);
+        PlantLimb(Planted, Location, Normal, CustomMovementComponent->GetCharacterOwner()->GetMovementBase());
+        return;
+    }
+
+    // A drifted limb stays where it is until the next probe frame of this character, or the one after when the budget is spent
+    if (bProbeFrame && !Planted.bProbePending && (!QueryBudget || QueryBudget->TryAcquire(EClimbQueryPriority::Speculative, 1, TNumericLimits<double>::Max())))
+    {
+        ProbeLimb(Limb, NominalLocation, SurfaceNormal);
+    }
+}
+
+void UClimbLimbIKComponent::ProbeLimb(EClimbLimb Limb, const FVector &NominalLocation, const FVector &SurfaceNormal)
+{
+    INC_DWORD_STAT(STAT_ClimbLimbIKProbes);
+
+    PlantedLimbs[int32(Limb)].bProbePending = true;
+
+    const FVector Start = NominalLocation + SurfaceNormal * ProbeDepth;
+    const FVector End = NominalLocation - SurfaceNormal * ProbeDepth;
+
+    // Hand plant and foot scuff effects take their surface type from the face the probe touched
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ClimbLimbIK), false, GetOwner());
+    QueryParams.bReturnPhysicalMaterial = true;
+
+    // Async traces issued this frame run together on worker threads, the results arrive at the start of the next frame
+    GetWorld()->AsyncLineTraceByObjectType(
+        EAsyncTraceType::Single,
+        Start,
+        End,
+        CustomMovementComponent->GetClimbObjectQueryParams(),
+        QueryParams,
+        &LimbProbeDelegate,
+        uint32(Limb));
+}
+
+void UClimbLimbIKComponent::OnLimbProbeDone(const FTraceHandle &Handle, FTraceDatum &Datum)
+{
+    if (Datum.UserData >= uint32(NumLimbs))
+        return;
+
+    FPlantedLimb &Planted = PlantedLimbs[Datum.UserData];
+
+    // The climb ended while the probe was in flight
+    if (!Planted.bProbePending)
+        return;
+
+    Planted.bProbePending = false;
+
+    const FHitResult *Hit = Datum.OutHits.IsEmpty() ? nullptr : &Datum.OutHits[0];
+
+    if (Hit && Hit->bBlockingHit && !Hit->bStartPenetrating)
+    {
+        PlantLimb(Planted, Hit->ImpactPoint, Hit->ImpactNormal, Hit->GetComponent(), Hit->PhysMaterial.Get());
+    }
+    else
+    {
+        // Nothing to hold here, the limb blends back to the animated pose
+        Planted.bPlanted = false;
+    }
+}
+
+void UClimbLimbIKComponent::UpdateSnapshot(float DeltaTime, bool bActive)
+{
+    for (int32 Index = 0; Index < NumLimbs; ++Index)
+    {
+        FClimbLimbIKTarget &Target = Targets[Index];
+
+        FVector Location;
+        FVector Normal;
+        const bool bPlanted = bActive && GetPlantedLocation(PlantedLimbs[Index], Location, Normal);
+
+        if (bPlanted)
+        {
+            // Coming from the animated pose there is no previous target to blend from
+            const bool bSnap = Target.Alpha <= UE_KINDA_SMALL_NUMBER;
+            Target.Location = bSnap ? Location : FMath::VInterpTo(Target.Location, Location, DeltaTime, LimbMoveSpeed);
+            Target.Normal = bSnap ? Normal : FMath::VInterpTo(Target.Normal, Normal, DeltaTime, LimbMoveSpeed).GetSafeNormal();
+        }
+
+        Target.Alpha = FMath::FInterpTo(Target.Alpha, bPlanted ? 1.f : 0.f, DeltaTime, AlphaBlendSpeed);
+    }
+
+    FWriteScopeLock Lock(SnapshotLock);
+
+    for (int32 Index = 0; Index < NumLimbs; ++Index)
+    {
+        Snapshot.Limbs[Index] = Targets[Index];
+    }
+}
@@ -0,0 +1,64 @@
+#include "Components/ClimbMeshGeometry.h"
+#include "Engine/StaticMesh.h"
+#include "StaticMeshResources.h"
+
+void FClimbMeshGeometry::Build(const UStaticMesh &StaticMesh)
+{
+    const FStaticMeshRenderData *RenderData = StaticMesh.GetRenderData();
+    if (!RenderData || RenderData->LODResources.IsEmpty())
+        return;
+
+    const FStaticMeshLODResources &LOD = RenderData->LODResources[0];
+    const FPositionVertexBuffer &PositionBuffer = LOD.VertexBuffers.PositionVertexBuffer;
+    const FStaticMeshVertexBuffer &VertexBuffer = LOD.VertexBuffers.StaticMeshVertexBuffer;
+    const FIndexArrayView IndexView = LOD.IndexBuffer.GetArrayView();
+
+    // Render vertices are split along UV and normal seams, weld them back so edges are shared
+    TMap<FIntVector, int32> WeldedIndexByPosition;
+    TArray<int32> WeldedIndices;
+    WeldedIndices.SetNumUninitialized(PositionBuffer.GetNumVertices());
+
+    for (uint32 VertexIndex = 0; VertexIndex < PositionBuffer.GetNumVertices(); ++VertexIndex)
+    {
+        const FVector3f &Position = PositionBuffer.VertexPosition(VertexIndex);
+        const FIntVector Key(
+            FMath::RoundToInt(Position.X * 10.f),
+            FMath::RoundToInt(Position.Y * 10.f),
+            FMath::RoundToInt(Position.Z * 10.f));
+
+        const FVector3f VertexNormal(VertexBuffer.VertexTangentZ(VertexIndex));
+
+        if (const int32 *ExistingIndex = WeldedIndexByPosition.Find(Key))
+        {
+            WeldedIndices[VertexIndex] = *ExistingIndex;
+            VertexNormals[*ExistingIndex] += VertexNormal;
+        }
+        else
+        {
+            const int32 NewIndex = Positions.Add(Position);
+            VertexNormals.Add(VertexNormal);
+            WeldedIndexByPosition.Add(Key, NewIndex);
+            WeldedIndices[VertexIndex] = NewIndex;
+        }
+    }
+
+    for (FVector3f &VertexNormal : VertexNormals)
+    {
+        VertexNormal = VertexNormal.GetSafeNormal();
+    }
+
+    Indices.Reserve(IndexView.Num());
+    for (int32 i = 0; i + 2 < IndexView.Num(); i += 3)
+    {
+        const int32 I0 = WeldedIndices[IndexView[i]];
+        const int32 I1 = WeldedIndices[IndexView[i + 1]];
+        const int32 I2 = WeldedIndices[IndexView[i + 2]];
+
+        if (I0 == I1 || I1 == I2 || I0 == I2)
+            continue;
+
+        Indices.Add(I0);
+        Indices.Add(I1);
+        Indices.Add(I2);
+    }
+}
@@ -0,0 +1,235 @@
+#include "Components/ClimbQueryBudgetSubsystem.h"
+#include "Camera/PlayerCameraManager.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "ClimbingSystem.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Queries Granted"), STAT_ClimbQueriesGranted, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Queries Deferred"), STAT_ClimbQueriesDeferred, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Queries Overdue"), STAT_ClimbQueriesOverdue, STATGROUP_Climbing);
+
+namespace
+{
+    TAutoConsoleVariable<int32> CVarClimbQueryBudget(
+        TEXT("Climb.QueryBudget"),
+        256,
+        TEXT("Climb scene queries per frame for the whole world, 0 for no limit"));
+
+    TAutoConsoleVariable<float> CVarClimbQueryBudgetNearAIDistance(
+        TEXT("Climb.QueryBudget.NearAIDistance"),
+        2500.f,
+        TEXT("AI climbers closer than this to a viewer get the near AI share of the climb query budget"));
+
+    TAutoConsoleVariable<bool> CVarClimbQueryBudgetLogFrames(
+        TEXT("Climb.QueryBudget.LogFrames"),
+        false,
+        TEXT("Log every frame in which climb queries were deferred"));
+
+    // Share of the budget each priority may fill, LocalPlayer is never refused and only counts against the others
+    constexpr float PriorityShares[int32(EClimbQueryPriority::Num)] = {1.f, 0.75f, 0.5f, 0.25f};
+
+    const TCHAR *GetPriorityName(int32 Priority)
+    {
+        static const TCHAR *Names[int32(EClimbQueryPriority::Num)] = {TEXT("LocalPlayer"), TEXT("NearAI"), TEXT("FarAI"), TEXT("Speculative")};
+        return Names[Priority];
+    }
+
+    FAutoConsoleCommandWithWorld ReportClimbQueryBudgetCommand(
+        TEXT("Climb.ReportQueryBudget"),
+        TEXT("Logs climb query budget use and deferred queries per priority over the last frames"),
+        FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld *World)
+        {
+            if (const UClimbQueryBudgetSubsystem *Subsystem = World ? World->GetSubsystem<UClimbQueryBudgetSubsystem>() : nullptr)
+            {
+                Subsystem->LogReport();
+            }
+        }));
+}
+
+int32 FClimbQueryBudgetFrame::GetNumGranted() const
+{
+    int32 Sum = 0;
+    for (const int32 Count : Granted)
+    {
+        Sum += Count;
+    }
+    return Sum;
+}
+
+int32 FClimbQueryBudgetFrame::GetNumDeferred() const
+{
+    int32 Sum = 0;
+    for (const int32 Count : Deferred)
+    {
+        Sum += Count;
+    }
+    return Sum;
+}
+
+bool UClimbQueryBudgetSubsystem::ShouldCreateSubsystem(UObject *Outer) const
+{
+    const UWorld *World = Cast<UWorld>(Outer);
+    return Super::ShouldCreateSubsystem(Outer) && World && World->IsGameWorld();
+}
+
+void UClimbQueryBudgetSubsystem::BeginFrame()
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+    if (CurrentFrame.FrameNumber != 0)
+    {
+        HistoryHead = (HistoryHead + 1) % HistoryFrames;
+        HistoryNum = FMath::Min(HistoryNum + 1, HistoryFrames);
+        History[HistoryHead] = CurrentFrame;
+
+        if (CVarClimbQueryBudgetLogFrames.GetValueOnGameThread() && CurrentFrame.GetNumDeferred() > 0)
+        {
+            UE_LOG(LogClimbing, Display, TEXT("Climb queries frame %llu: %d / %d used, %d deferred (%d player, %d near AI, %d far AI, %d speculative), %d overdue"),
+                CurrentFrame.FrameNumber,
+                CurrentFrame.GetNumGranted(),
+                CurrentFrame.Budget,
+                CurrentFrame.GetNumDeferred(),
+                CurrentFrame.Deferred[int32(EClimbQueryPriority::LocalPlayer)],
+                CurrentFrame.Deferred[int32(EClimbQueryPriority::NearAI)],
+                CurrentFrame.Deferred[int32(EClimbQueryPriority::FarAI)],
+                CurrentFrame.Deferred[int32(EClimbQueryPriority::Speculative)],
+                CurrentFrame.Overdue);
+        }
+    }
+
+    CurrentFrame = FClimbQueryBudgetFrame();
+    CurrentFrame.FrameNumber = GFrameCounter;
+    CurrentFrame.Budget = CVarClimbQueryBudget.GetValueOnGameThread();
+
+    ViewerLocations.Reset();
+    const UWorld *World = GetWorld();
+
+    for (FConstPlayerControllerIterator It = World->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController *PlayerController = It->Get();
+        if (!PlayerController)
+            continue;
+
+        if (PlayerController->IsLocalController() && PlayerController->PlayerCameraManager)
+        {
+            ViewerLocations.Add(PlayerController->PlayerCameraManager->GetCameraLocation());
+        }
+        else if (const APawn *Pawn = PlayerController->GetPawn())
+        {
+            ViewerLocations.Add(Pawn->GetActorLocation());
+        }
+    }
+}
+
+bool UClimbQueryBudgetSubsystem::TryAcquire(EClimbQueryPriority Priority, int32 NumQueries, double RequiredByTime)
+{
+    // Climbers move before the frame is over, so the first request of a frame closes the previous one
+    if (CurrentFrame.FrameNumber != GFrameCounter)
+    {
+        BeginFrame();
+    }
+
+    const int32 PriorityIndex = int32(Priority);
+    const int32 Used = CurrentFrame.GetNumGranted();
+    const int32 Budget = CurrentFrame.Budget;
+
+    // Player movement is never held back by the budget, its queries only leave less of it to the other priorities.
+    // No other priority and no overdue probe goes past the budget itself
+    bool bGranted = Budget <= 0 || Priority == EClimbQueryPriority::LocalPlayer;
+    if (!bGranted)
+    {
+        bGranted = Used + NumQueries <= FMath::FloorToInt(Budget * PriorityShares[PriorityIndex]);
+
+        if (!bGranted && RequiredByTime <= GetWorld()->GetTimeSeconds() && Used + NumQueries <= Budget)
+        {
+            bGranted = true;
+            CurrentFrame.Overdue += NumQueries;
+            INC_DWORD_STAT_BY(STAT_ClimbQueriesOverdue, NumQueries);
+        }
+    }
+
+    if (bGranted)
+    {
+        CurrentFrame.Granted[PriorityIndex] += NumQueries;
+        INC_DWORD_STAT_BY(STAT_ClimbQueriesGranted, NumQueries);
+    }
+    else
+    {
+        CurrentFrame.Deferred[PriorityIndex] += NumQueries;
+        INC_DWORD_STAT_BY(STAT_ClimbQueriesDeferred, NumQueries);
+    }
+
+    return bGranted;
+}
+
+EClimbQueryPriority UClimbQueryBudgetSubsystem::GetPriority(const APawn &Pawn)
+{
+    if (Pawn.IsPlayerControlled())
+        return EClimbQueryPriority::LocalPlayer;
+
+    if (CurrentFrame.FrameNumber != GFrameCounter)
+    {
+        BeginFrame();
+    }
+
+    const FVector Location = Pawn.GetActorLocation();
+    const float NearDistanceSquared = FMath::Square(CVarClimbQueryBudgetNearAIDistance.GetValueOnGameThread());
+
+    for (const FVector &ViewerLocation : ViewerLocations)
+    {
+        if (FVector::DistSquared(ViewerLocation, Location) < NearDistanceSquared)
+            return EClimbQueryPriority::NearAI;
+    }
+
+    return EClimbQueryPriority::FarAI;
+}
+
+void UClimbQueryBudgetSubsystem::LogReport() const
+{
+    if (HistoryNum == 0)
+    {
+        UE_LOG(LogClimbing, Display, TEXT("No climb queries requested yet"));
+        return;
+    }
+
+    int64 TotalGranted = 0;
+    int32 PeakGranted = 0;
+    int32 FramesDeferring = 0;
+    int64 TotalOverdue = 0;
+    int64 Granted[int32(EClimbQueryPriority::Num)] = {};
+    int64 Deferred[int32(EClimbQueryPriority::Num)] = {};
+
+    for (int32 i = 0; i < HistoryNum; ++i)
+    {
+        const FClimbQueryBudgetFrame &Frame = History[(HistoryHead - i + HistoryFrames) % HistoryFrames];
+        const int32 FrameGranted = Frame.GetNumGranted();
+
+        TotalGranted += FrameGranted;
+        PeakGranted = FMath::Max(PeakGranted, FrameGranted);
+        FramesDeferring += Frame.GetNumDeferred() > 0 ? 1 : 0;
+        TotalOverdue += Frame.Overdue;
+
+        for (int32 Priority = 0; Priority < int32(EClimbQueryPriority::Num); ++Priority)
+        {
+            Granted[Priority] += Frame.Granted[Priority];
+            Deferred[Priority] += Frame.Deferred[Priority];
+        }
+    }
+
+    UE_LOG(LogClimbing, Display, TEXT("Climb queries over %d frames: budget %d, %.1f average, %d peak, %d frames deferring, %lld overdue"),
+        HistoryNum,
+        CVarClimbQueryBudget.GetValueOnGameThread(),
+        double(TotalGranted) / HistoryNum,
+        PeakGranted,
+        FramesDeferring,
+        TotalOverdue);
+
+    for (int32 Priority = 0; Priority < int32(EClimbQueryPriority::Num); ++Priority)
+    {
+        UE_LOG(LogClimbing, Display, TEXT("  %s: %.1f granted, %.1f deferred per frame"),
+            GetPriorityName(Priority),
+            double(Granted[Priority]) / HistoryNum,
+            double(Deferred[Priority]) / HistoryNum);
+    }
+}
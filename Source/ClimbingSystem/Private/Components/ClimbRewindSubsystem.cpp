@@ -0,0 +1,324 @@
+#include "Components/ClimbRewindSubsystem.h"
+#include "Components/PrimitiveComponent.h"
+#include "GameFramework/Pawn.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "ClimbingSystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Climb Rewind Record"), STAT_ClimbRewindRecord, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("Climb Rewind Query"), STAT_ClimbRewindQuery, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Rewound Component Queries"), STAT_ClimbRewoundComponentQueries, STATGROUP_Climbing);
+DECLARE_DWORD_ACCUMULATOR_STAT(TEXT("Climb Rewind Tracked Primitives"), STAT_ClimbRewindTrackedPrimitives, STATGROUP_Climbing);
+
+namespace
+{
+    TAutoConsoleVariable<float> CVarClimbRewindMaxTime(
+        TEXT("Climb.Rewind.MaxTime"),
+        0.4f,
+        TEXT("Seconds a client climb request can be rewound, also limited by the length of the recorded history"));
+
+    TAutoConsoleVariable<int32> CVarClimbRewindMaxQueriesPerTick(
+        TEXT("Climb.Rewind.MaxQueriesPerTick"),
+        64,
+        TEXT("Rewound component queries per tick, climb requests validated after that run against the present geometry"));
+
+    // Primitives that moved less than this since the rewind time are queried as they are now
+    constexpr float RewindTolerance = 0.1f;
+
+    void MoveHitToRewindTime(FHitResult &Hit, const FTransform &NowToThen)
+    {
+        Hit.Location = NowToThen.TransformPosition(Hit.Location);
+        Hit.ImpactPoint = NowToThen.TransformPosition(Hit.ImpactPoint);
+        Hit.TraceStart = NowToThen.TransformPosition(Hit.TraceStart);
+        Hit.TraceEnd = NowToThen.TransformPosition(Hit.TraceEnd);
+        Hit.Normal = NowToThen.TransformVectorNoScale(Hit.Normal);
+        Hit.ImpactNormal = NowToThen.TransformVectorNoScale(Hit.ImpactNormal);
+    }
+
+    FBox MakeQueryBounds(const FVector &Start, const FVector &End, float Extent)
+    {
+        return FBox(FVector::Min(Start, End), FVector::Max(Start, End)).ExpandBy(Extent);
+    }
+}
+
+void FClimbRewindTrack::Record(double Time, const FTransform &Transform)
+{
+    Head = (Head + 1) % NumSamples;
+    Num = FMath::Min(Num + 1, NumSamples);
+
+    FSample &Sample = Samples[Head];
+    Sample.Time = Time;
+    Sample.Location = Transform.GetLocation();
+    Sample.Rotation = Transform.GetRotation();
+}
+
+bool FClimbRewindTrack::GetTransformAt(double Time, const FVector &Scale, FTransform &OutTransform) const
+{
+    if (Num == 0)
+        return false;
+
+    const FSample *Newer = nullptr;
+    const FSample *Older = nullptr;
+
+    for (int32 i = 0; i < Num; ++i)
+    {
+        const FSample &Sample = Samples[(Head - i + NumSamples) % NumSamples];
+        if (Sample.Time <= Time)
+        {
+            Older = &Sample;
+            break;
+        }
+        Newer = &Sample;
+    }
+
+    // Before the oldest or after the newest sample
+    if (!Older)
+    {
+        Older = Newer;
+    }
+    if (!Newer)
+    {
+        Newer = Older;
+    }
+
+    const double Span = Newer->Time - Older->Time;
+    const float Alpha = Span > 0.0 ? float((Time - Older->Time) / Span) : 0.f;
+
+    OutTransform = FTransform(FQuat::Slerp(Older->Rotation, Newer->Rotation, Alpha), FMath::Lerp(Older->Location, Newer->Location, Alpha), Scale);
+    return true;
+}
+
+bool UClimbRewindSubsystem::ShouldCreateSubsystem(UObject *Outer) const
+{
+    const UWorld *World = Cast<UWorld>(Outer);
+    return Super::ShouldCreateSubsystem(Outer) && World && World->IsGameWorld();
+}
+
+void UClimbRewindSubsystem::Initialize(FSubsystemCollectionBase &Collection)
+{
+    Super::Initialize(Collection);
+
+    LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UClimbRewindSubsystem::OnLevelAddedToWorld);
+    ActorSpawnedHandle = GetWorld()->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UClimbRewindSubsystem::OnActorSpawned));
+}
+
+void UClimbRewindSubsystem::Deinitialize()
+{
+    FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+    GetWorld()->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+    Tracks.Reset();
+
+    Super::Deinitialize();
+}
+
+void UClimbRewindSubsystem::OnWorldBeginPlay(UWorld &InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+
+    // Only the server validates climb requests
+    bRecording = InWorld.GetNetMode() != NM_Client;
+    if (!bRecording)
+        return;
+
+    for (ULevel *Level : InWorld.GetLevels())
+    {
+        if (Level && Level->bIsVisible)
+        {
+            OnLevelAddedToWorld(Level, &InWorld);
+        }
+    }
+}
+
+void UClimbRewindSubsystem::OnLevelAddedToWorld(ULevel *Level, UWorld *World)
+{
+    if (World != GetWorld() || !Level || !bRecording)
+        return;
+
+    for (const AActor *Actor : Level->Actors)
+    {
+        if (Actor)
+        {
+            TrackActor(*Actor);
+        }
+    }
+}
+
+void UClimbRewindSubsystem::OnActorSpawned(AActor *Actor)
+{
+    if (Actor && bRecording)
+    {
+        TrackActor(*Actor);
+    }
+}
+
+void UClimbRewindSubsystem::TrackActor(const AActor &Actor)
+{
+    // Clients only see the server's movement of replicated actors, and characters are not climbed
+    if (!Actor.GetIsReplicated() || Actor.IsA<APawn>())
+        return;
+
+    TInlineComponentArray<UPrimitiveComponent *> Primitives(&Actor);
+
+    for (UPrimitiveComponent *Primitive : Primitives)
+    {
+        if (Primitive->Mobility == EComponentMobility::Movable && Primitive->IsQueryCollisionEnabled())
+        {
+            TrackPrimitive(Primitive);
+        }
+    }
+}
+
+void UClimbRewindSubsystem::TrackPrimitive(UPrimitiveComponent *Primitive)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+    if (!Primitive || GetWorld()->GetNetMode() == NM_Client)
+        return;
+
+    const bool bTracked = Tracks.ContainsByPredicate([Primitive](const FClimbRewindTrack &Track) { return Track.Primitive == Primitive; });
+    if (bTracked)
+        return;
+
+    Tracks.AddDefaulted_GetRef().Primitive = Primitive;
+}
+
+void UClimbRewindSubsystem::Tick(float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    NumQueriesThisTick = 0;
+
+    if (!bRecording)
+        return;
+
+    SCOPE_CYCLE_COUNTER(STAT_ClimbRewindRecord);
+
+    const double Time = GetWorld()->GetTimeSeconds();
+
+    for (int32 i = Tracks.Num() - 1; i >= 0; --i)
+    {
+        const UPrimitiveComponent *Primitive = Tracks[i].Primitive.Get();
+        if (!Primitive)
+        {
+            Tracks.RemoveAtSwap(i);
+            continue;
+        }
+
+        Tracks[i].Record(Time, Primitive->GetComponentTransform());
+    }
+
+    SET_DWORD_STAT(STAT_ClimbRewindTrackedPrimitives, Tracks.Num());
+}
+
+TStatId UClimbRewindSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UClimbRewindSubsystem, STATGROUP_Climbing);
+}
+
+bool UClimbRewindSubsystem::HasQueryBudget() const
+{
+    return bRecording && NumQueriesThisTick < CVarClimbRewindMaxQueriesPerTick.GetValueOnGameThread();
+}
+
+double UClimbRewindSubsystem::ClampRewindTime(double Time) const
+{
+    const double Now = GetWorld()->GetTimeSeconds();
+    return FMath::Clamp(Time, Now - CVarClimbRewindMaxTime.GetValueOnGameThread(), Now);
+}
+
+void UClimbRewindSubsystem::GatherRewoundPrimitives(double Time, const FCollisionObjectQueryParams &ObjectParams, const UPrimitiveComponent *ExcludedPrimitive,
+    FCollisionQueryParams &OutWorldParams, TArray<FRewoundPrimitive, TInlineAllocator<8>> &OutRewound) const
+{
+    for (const FClimbRewindTrack &Track : Tracks)
+    {
+        UPrimitiveComponent *Primitive = Track.Primitive.Get();
+        if (!Primitive || Primitive == ExcludedPrimitive)
+            continue;
+
+        if (!(ObjectParams.GetQueryBitfield() & ECC_TO_BITFIELD(Primitive->GetCollisionObjectType())))
+            continue;
+
+        const FTransform &Now = Primitive->GetComponentTransform();
+        FTransform Then;
+
+        if (!Track.GetTransformAt(Time, Now.GetScale3D(), Then) || Then.Equals(Now, RewindTolerance))
+            continue;
+
+        OutWorldParams.AddIgnoredComponent(Primitive);
+        OutRewound.Add({Primitive, Now.Inverse() * Then});
+    }
+}
+
+void UClimbRewindSubsystem::SweepMultiAtTime(TArray<FHitResult> &OutHits, const FVector &Start, const FVector &End, const FQuat &Rotation, const FCollisionShape &Shape,
+    const FCollisionObjectQueryParams &ObjectParams, const FCollisionQueryParams &Params, double Time, const UPrimitiveComponent *ExcludedPrimitive)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ClimbRewindQuery);
+
+    FCollisionQueryParams WorldParams = Params;
+    TArray<FRewoundPrimitive, TInlineAllocator<8>> Rewound;
+    GatherRewoundPrimitives(Time, ObjectParams, ExcludedPrimitive, WorldParams, Rewound);
+
+    GetWorld()->SweepMultiByObjectType(OutHits, Start, End, Rotation, ObjectParams, Shape, WorldParams);
+
+    if (Rewound.IsEmpty())
+        return;
+
+    const FBox QueryBounds = MakeQueryBounds(Start, End, Shape.GetExtent().GetMax());
+
+    for (const FRewoundPrimitive &Entry : Rewound)
+    {
+        if (!Entry.Primitive->Bounds.GetBox().TransformBy(Entry.NowToThen).Intersect(QueryBounds))
+            continue;
+
+        NumQueriesThisTick++;
+        INC_DWORD_STAT(STAT_ClimbRewoundComponentQueries);
+
+        // Moving the query by the primitive's motion since then is the same as moving the primitive back
+        const FTransform ThenToNow = Entry.NowToThen.Inverse();
+        FHitResult Hit;
+
+        if (Entry.Primitive->SweepComponent(Hit, ThenToNow.TransformPosition(Start), ThenToNow.TransformPosition(End), ThenToNow.GetRotation() * Rotation, Shape, Params.bTraceComplex))
+        {
+            MoveHitToRewindTime(Hit, Entry.NowToThen);
+            OutHits.Add(Hit);
+        }
+    }
+
+    OutHits.Sort([](const FHitResult &A, const FHitResult &B) { return A.Time < B.Time; });
+}
+
+FHitResult UClimbRewindSubsystem::LineTraceSingleAtTime(const FVector &Start, const FVector &End,
+    const FCollisionObjectQueryParams &ObjectParams, const FCollisionQueryParams &Params, double Time, const UPrimitiveComponent *ExcludedPrimitive)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ClimbRewindQuery);
+
+    FCollisionQueryParams WorldParams = Params;
+    TArray<FRewoundPrimitive, TInlineAllocator<8>> Rewound;
+    GatherRewoundPrimitives(Time, ObjectParams, ExcludedPrimitive, WorldParams, Rewound);
+
+    FHitResult Result;
+    GetWorld()->LineTraceSingleByObjectType(Result, Start, End, ObjectParams, WorldParams);
+
+    const FBox QueryBounds = MakeQueryBounds(Start, End, 0.f);
+
+    for (const FRewoundPrimitive &Entry : Rewound)
+    {
+        if (!Entry.Primitive->Bounds.GetBox().TransformBy(Entry.NowToThen).Intersect(QueryBounds))
+            continue;
+
+        NumQueriesThisTick++;
+        INC_DWORD_STAT(STAT_ClimbRewoundComponentQueries);
+
+        const FTransform ThenToNow = Entry.NowToThen.Inverse();
+        FHitResult Hit;
+
+        if (Entry.Primitive->LineTraceComponent(Hit, ThenToNow.TransformPosition(Start), ThenToNow.TransformPosition(End), Params) &&
+            (!Result.bBlockingHit || Hit.Time < Result.Time))
+        {
+            MoveHitToRewindTime(Hit, Entry.NowToThen);
+            Result = Hit;
+        }
+    }
+
+    return Result;
+}
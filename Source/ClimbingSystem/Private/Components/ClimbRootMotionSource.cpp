@@ -0,0 +1,247 @@
+#include "Components/ClimbRootMotionSource.h"
+#include "Animation/AnimMontage.h"
+#include "AnimNotifyState_MotionWarping.h"
+#include "RootMotionModifier.h"
+#include "GameFramework/Character.h"
+#include "Components/CustomMovementComponent.h"
+#include "Engine/NetSerialization.h"
+#include "ClimbingSystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Climb Path Prepare Root Motion"), STAT_ClimbPathPrepareRootMotion, STATGROUP_Climbing);
+
+namespace
+{
+    FVector SampleUniformPath(const TArray<FVector> &Path, float Duration, float Time)
+    {
+        const float SamplePosition = FMath::Clamp(Time / Duration, 0.f, 1.f) * (Path.Num() - 1);
+        const int32 SampleIndex = FMath::Min(FMath::FloorToInt(SamplePosition), Path.Num() - 2);
+        return FMath::Lerp(Path[SampleIndex], Path[SampleIndex + 1], SamplePosition - SampleIndex);
+    }
+
+    // The same precision NetSerialize sends, so the server moves along exactly the path its clients rebuild
+    void SerializeStartTransform(FArchive &Ar, FVector &Location, FQuat &Rotation, bool &bOutSuccess)
+    {
+        bOutSuccess &= SerializePackedVector<100, 30>(Location, Ar);
+
+        FRotator Rotator = Rotation.Rotator();
+        Rotator.SerializeCompressedShort(Ar);
+        Rotation = Rotator.Quaternion();
+    }
+
+    void QuantizeStartTransform(FVector &Location, FQuat &Rotation)
+    {
+        Location = FVector(
+            FMath::RoundToDouble(Location.X * 100.0) / 100.0,
+            FMath::RoundToDouble(Location.Y * 100.0) / 100.0,
+            FMath::RoundToDouble(Location.Z * 100.0) / 100.0);
+
+        FRotator Rotator = Rotation.Rotator();
+        Rotator = FRotator(
+            FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(Rotator.Pitch)),
+            FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(Rotator.Yaw)),
+            FRotator::DecompressAxisFromShort(FRotator::CompressAxisToShort(Rotator.Roll)));
+        Rotation = Rotator.Quaternion();
+    }
+}
+
+FClimbRootMotionBake FClimbRootMotionBake::Bake(const UAnimMontage &Montage, const FQuat &MeshToActorRotation)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+    FClimbRootMotionBake Result;
+    Result.Duration = Montage.GetPlayLength();
+
+    if (Result.Duration <= UE_SMALL_NUMBER)
+        return Result;
+
+    const int32 NumSamples = FMath::Max(2, FMath::CeilToInt(Result.Duration * SampleRate) + 1);
+    Result.Path.Reserve(NumSamples);
+
+    for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+    {
+        const float Time = Result.Duration * SampleIndex / (NumSamples - 1);
+        const FTransform RootMotion = Montage.ExtractRootMotionFromTrackRange(0.f, Time);
+        Result.Path.Add(MeshToActorRotation.RotateVector(RootMotion.GetTranslation()));
+    }
+
+    for (const FAnimNotifyEvent &NotifyEvent : Montage.Notifies)
+    {
+        const UAnimNotifyState_MotionWarping *WarpingNotify = Cast<UAnimNotifyState_MotionWarping>(NotifyEvent.NotifyStateClass);
+        const URootMotionModifier_Warp *WarpModifier = WarpingNotify ? Cast<URootMotionModifier_Warp>(WarpingNotify->RootMotionModifier) : nullptr;
+
+        if (WarpModifier)
+        {
+            Result.WarpTargetTimes.Emplace(WarpModifier->WarpTargetName, NotifyEvent.GetEndTriggerTime());
+        }
+    }
+
+    Result.WarpTargetTimes.Sort([](const TPair<FName, float> &A, const TPair<FName, float> &B)
+    {
+        return A.Value < B.Value;
+    });
+
+    return Result;
+}
+
+FVector FClimbRootMotionBake::SamplePath(float Time) const
+{
+    return SampleUniformPath(Path, Duration, Time);
+}
+
+FRootMotionSource_ClimbPath::FRootMotionSource_ClimbPath()
+{
+    AccumulateMode = ERootMotionAccumulateMode::Override;
+    FinishVelocityParams.Mode = ERootMotionFinishVelocityMode::SetVelocity;
+    FinishVelocityParams.SetVelocity = FVector::ZeroVector;
+}
+
+void FRootMotionSource_ClimbPath::Initialize(UAnimMontage &InMontage, const FClimbRootMotionBake &Bake, const FTransform &StartTransform, const TMap<FName, FVector> &WarpTargets)
+{
+    Montage = &InMontage;
+    Duration = Bake.Duration;
+    StartLocation = StartTransform.GetLocation();
+    StartRotation = StartTransform.GetRotation();
+    QuantizeStartTransform(StartLocation, StartRotation);
+    Path = Bake.Path;
+
+    CorrectionTimes.Reset();
+    Corrections.Reset();
+
+    for (const TPair<FName, float> &WarpTargetTime : Bake.WarpTargetTimes)
+    {
+        const FVector *WarpTarget = WarpTargets.Find(WarpTargetTime.Key);
+        if (!WarpTarget)
+            continue;
+
+        const FVector UnwarpedLocation = StartLocation + StartRotation.RotateVector(Bake.SamplePath(WarpTargetTime.Value));
+        CorrectionTimes.Add(WarpTargetTime.Value);
+        Corrections.Add(*WarpTarget - UnwarpedLocation);
+    }
+}
+
+FVector FRootMotionSource_ClimbPath::GetWorldLocationAtTime(float Time) const
+{
+    if (Path.Num() < 2 || Duration <= UE_SMALL_NUMBER)
+        return StartLocation;
+
+    const FVector LocalLocation = SampleUniformPath(Path, Duration, Time);
+
+    // Piecewise linear correction, zero at the start and held after the last warp target
+    FVector Correction = FVector::ZeroVector;
+    float PreviousTime = 0.f;
+    FVector PreviousCorrection = FVector::ZeroVector;
+
+    for (int32 i = 0; i < CorrectionTimes.Num(); ++i)
+    {
+        if (Time <= CorrectionTimes[i])
+        {
+            const float Alpha = (Time - PreviousTime) / FMath::Max(CorrectionTimes[i] - PreviousTime, UE_SMALL_NUMBER);
+            Correction = FMath::Lerp(PreviousCorrection, Corrections[i], FMath::Clamp(Alpha, 0.f, 1.f));
+            break;
+        }
+
+        PreviousTime = CorrectionTimes[i];
+        PreviousCorrection = Corrections[i];
+        Correction = Corrections[i];
+    }
+
+    return StartLocation + StartRotation.RotateVector(LocalLocation) + Correction;
+}
+
+FRootMotionSource *FRootMotionSource_ClimbPath::Clone() const
+{
+    return new FRootMotionSource_ClimbPath(*this);
+}
+
+bool FRootMotionSource_ClimbPath::Matches(const FRootMotionSource *Other) const
+{
+    if (!FRootMotionSource::Matches(Other))
+        return false;
+
+    const FRootMotionSource_ClimbPath *OtherCast = static_cast<const FRootMotionSource_ClimbPath *>(Other);
+
+    return Montage == OtherCast->Montage &&
+           StartLocation.Equals(OtherCast->StartLocation, 1.f);
+}
+
+bool FRootMotionSource_ClimbPath::MatchesAndHasSameState(const FRootMotionSource *Other) const
+{
+    return FRootMotionSource::MatchesAndHasSameState(Other) && Matches(Other);
+}
+
+bool FRootMotionSource_ClimbPath::UpdateStateFrom(const FRootMotionSource *SourceToTakeStateFrom, bool bMarkForSimulatedCatchup)
+{
+    return FRootMotionSource::UpdateStateFrom(SourceToTakeStateFrom, bMarkForSimulatedCatchup);
+}
+
+void FRootMotionSource_ClimbPath::PrepareRootMotion(float SimulationTime, float MovementTickTime, const ACharacter &Character, const UCharacterMovementComponent &MoveComponent)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ClimbPathPrepareRootMotion);
+
+    RootMotionParams.Clear();
+
+    if (Path.Num() < 2 && Montage)
+    {
+        // Replicated without its path, the character's cached bake is the one the server moved along
+        const UCustomMovementComponent *ClimbMovement = Cast<UCustomMovementComponent>(&MoveComponent);
+        const FClimbRootMotionBake *Bake = ClimbMovement ? ClimbMovement->FindClimbRootMotionBake(Montage) : nullptr;
+        Path = Bake ? Bake->Path : FClimbRootMotionBake::Bake(*Montage, Character.GetBaseRotationOffset()).Path;
+    }
+
+    if (Duration > UE_SMALL_NUMBER && MovementTickTime > UE_SMALL_NUMBER)
+    {
+        const FVector TargetLocation = GetWorldLocationAtTime(GetTime() + SimulationTime);
+        const FVector Force = (TargetLocation - Character.GetActorLocation()) / MovementTickTime;
+        RootMotionParams.Set(FTransform(Force));
+    }
+
+    SetTime(GetTime() + SimulationTime);
+}
+
+bool FRootMotionSource_ClimbPath::NetSerialize(FArchive &Ar, UPackageMap *Map, bool &bOutSuccess)
+{
+    if (!FRootMotionSource::NetSerialize(Ar, Map, bOutSuccess))
+        return false;
+
+    UObject *MontageObject = Montage;
+    Ar << MontageObject;
+
+    bOutSuccess = true;
+    SerializeStartTransform(Ar, StartLocation, StartRotation, bOutSuccess);
+
+    // One entry per warp target the action uses, usually one or two
+    uint8 NumCorrections = uint8(FMath::Min(Corrections.Num(), 255));
+    Ar << NumCorrections;
+
+    if (Ar.IsLoading())
+    {
+        Montage = Cast<UAnimMontage>(MontageObject);
+        Path.Reset();
+        CorrectionTimes.SetNum(NumCorrections);
+        Corrections.SetNum(NumCorrections);
+    }
+
+    for (int32 i = 0; i < NumCorrections; ++i)
+    {
+        Ar << CorrectionTimes[i];
+        bOutSuccess &= SerializePackedVector<10, 24>(Corrections[i], Ar);
+    }
+
+    return true;
+}
+
+UScriptStruct *FRootMotionSource_ClimbPath::GetScriptStruct() const
+{
+    return FRootMotionSource_ClimbPath::StaticStruct();
+}
+
+FString FRootMotionSource_ClimbPath::ToSimpleString() const
+{
+    return FString::Printf(TEXT("[ID:%u]FRootMotionSource_ClimbPath %s"), LocalID, *InstanceName.GetPlainNameString());
+}
+
+void FRootMotionSource_ClimbPath::AddReferencedObjects(class FReferenceCollector &Collector)
+{
+    FRootMotionSource::AddReferencedObjects(Collector);
+    Collector.AddReferencedObject(Montage);
+}
@@ -0,0 +1,265 @@
+#include "Components/ClimbSplineComponent.h"
+#include "Components/ClimbSplineSubsystem.h"
+#include "Engine/World.h"
+#include "ClimbingSystem.h"
+
+namespace
+{
+    // Upright where the path allows, along the path where it runs straight toward or away from the climber
+    FQuat MakeClimberRotation(const FVector &Forward, const FVector &Tangent)
+    {
+        const FVector Up = FMath::Abs(Forward.Z) < 0.9f ? FVector::UpVector : Tangent;
+        return FRotationMatrix::MakeFromXZ(Forward, Up).ToQuat();
+    }
+
+    FTransform MakeStepOffTransform(const FTransform &EndTransform, const FVector &ExitOffset)
+    {
+        return FTransform(FRotator(0.f, EndTransform.Rotator().Yaw, 0.f), EndTransform.TransformPosition(ExitOffset));
+    }
+}
+
+UClimbSplineComponent::UClimbSplineComponent()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UClimbSplineComponent::UpdateSpline()
+{
+    Super::UpdateSpline();
+
+    BuildClimbFrames();
+}
+
+void UClimbSplineComponent::OnRegister()
+{
+    Super::OnRegister();
+
+    BuildClimbFrames();
+
+    if (UClimbSplineSubsystem *Subsystem = GetWorld() ? GetWorld()->GetSubsystem<UClimbSplineSubsystem>() : nullptr)
+    {
+        Subsystem->Register(*this);
+    }
+}
+
+void UClimbSplineComponent::OnUnregister()
+{
+    if (UClimbSplineSubsystem *Subsystem = GetWorld() ? GetWorld()->GetSubsystem<UClimbSplineSubsystem>() : nullptr)
+    {
+        Subsystem->Unregister(*this);
+    }
+
+    Super::OnUnregister();
+}
+
+void UClimbSplineComponent::BuildClimbFrames()
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+    ClimbFrames.Reset();
+    FrameBounds = FBox(ForceInit);
+    PathLength = 0.f;
+
+    const float SplineLength = GetSplineLength();
+    if (SplineLength <= KINDA_SMALL_NUMBER)
+        return;
+
+    const FTransform Bottom = GetClimberTransformAtSplineDistance(0.f);
+    const FTransform Top = GetClimberTransformAtSplineDistance(SplineLength);
+    const FTransform BottomStepOff = MakeStepOffTransform(Bottom, BottomExitOffset);
+    const FTransform TopStepOff = MakeStepOffTransform(Top, TopExitOffset);
+
+    const float BottomExitLength = BottomExit == EClimbSplineExit::StepOff ? FVector::Dist(Bottom.GetLocation(), BottomStepOff.GetLocation()) : 0.f;
+    const float TopExitLength = TopExit == EClimbSplineExit::StepOff ? FVector::Dist(Top.GetLocation(), TopStepOff.GetLocation()) : 0.f;
+
+    ClimbStartDistance = BottomExitLength;
+    ClimbEndDistance = BottomExitLength + SplineLength;
+    PathLength = ClimbEndDistance + TopExitLength;
+
+    const int32 NumFrames = FMath::Max(2, FMath::CeilToInt(PathLength / FMath::Max(FrameSpacing, 1.f)) + 1);
+    FrameStep = PathLength / (NumFrames - 1);
+    ClimbFrames.SetNumUninitialized(NumFrames);
+
+    for (int32 i = 0; i < NumFrames; ++i)
+    {
+        const float Distance = i * FrameStep;
+
+        FTransform Transform;
+        FVector InputAxis;
+
+        // Step-off segments are climbed with up input toward the top end, whichever way they lead
+        if (Distance < ClimbStartDistance)
+        {
+            Transform.Blend(BottomStepOff, Bottom, Distance / BottomExitLength);
+            InputAxis = Transform.GetRotation().GetUpVector();
+        }
+        else if (Distance > ClimbEndDistance)
+        {
+            Transform.Blend(Top, TopStepOff, (Distance - ClimbEndDistance) / TopExitLength);
+            InputAxis = Transform.GetRotation().GetUpVector();
+        }
+        else
+        {
+            const float SplineDistance = FMath::Min(Distance - ClimbStartDistance, SplineLength);
+            Transform = GetClimberTransformAtSplineDistance(SplineDistance);
+            InputAxis = GetDirectionAtDistanceAlongSpline(SplineDistance, ESplineCoordinateSpace::Local);
+        }
+
+        FClimbSplineFrame &Frame = ClimbFrames[i];
+        Frame.Location = FVector3f(Transform.GetLocation());
+        Frame.Rotation = FQuat4f(Transform.GetRotation());
+        Frame.InputAxis = FVector3f(InputAxis);
+
+        FrameBounds += Transform.GetLocation();
+    }
+}
+
+FTransform UClimbSplineComponent::GetClimberTransformAtSplineDistance(float SplineDistance) const
+{
+    const FVector Location = GetLocationAtDistanceAlongSpline(SplineDistance, ESplineCoordinateSpace::Local);
+    const FVector Tangent = GetDirectionAtDistanceAlongSpline(SplineDistance, ESplineCoordinateSpace::Local);
+    const FVector Up = GetUpVectorAtDistanceAlongSpline(SplineDistance, ESplineCoordinateSpace::Local);
+
+    return FTransform(MakeClimberRotation(-Up, Tangent), Location + Up * ClimberOffset);
+}
+
+void UClimbSplineComponent::GetFrameAtDistance(float Distance, int32 &OutIndex, float &OutAlpha) const
+{
+    const float FramePosition = FMath::Clamp(Distance, 0.f, PathLength) / FrameStep;
+
+    OutIndex = FMath::Min(FMath::FloorToInt(FramePosition), ClimbFrames.Num() - 2);
+    OutAlpha = FramePosition - OutIndex;
+}
+
+FTransform UClimbSplineComponent::GetClimberTransformAtDistance(float Distance) const
+{
+    int32 Index;
+    float Alpha;
+    GetFrameAtDistance(Distance, Index, Alpha);
+
+    const FClimbSplineFrame &From = ClimbFrames[Index];
+    const FClimbSplineFrame &To = ClimbFrames[Index + 1];
+
+    const FTransform &ComponentTransform = GetComponentTransform();
+
+    return FTransform(
+        ComponentTransform.GetRotation() * FQuat(FQuat4f::Slerp(From.Rotation, To.Rotation, Alpha)),
+        ComponentTransform.TransformPosition(FVector(FMath::Lerp(From.Location, To.Location, Alpha))));
+}
+
+FVector UClimbSplineComponent::GetInputAxisAtDistance(float Distance) const
+{
+    int32 Index;
+    float Alpha;
+    GetFrameAtDistance(Distance, Index, Alpha);
+
+    const FVector3f InputAxis = FMath::Lerp(ClimbFrames[Index].InputAxis, ClimbFrames[Index + 1].InputAxis, Alpha);
+    return GetComponentTransform().TransformVectorNoScale(FVector(InputAxis)).GetSafeNormal();
+}
+
+bool UClimbSplineComponent::FindEntryDistance(const FVector &Location, float &OutDistance, float &OutDistanceSquared) const
+{
+    if (!HasClimbFrames())
+        return false;
+
+    const FTransform &ComponentTransform = GetComponentTransform();
+    if (!FrameBounds.TransformBy(ComponentTransform).ExpandBy(EntryRadius).IsInsideOrOn(Location))
+        return false;
+
+    // Frames are in component space, compare there
+    const FVector3f LocalLocation = FVector3f(ComponentTransform.InverseTransformPosition(Location));
+    const float LocalRadius = EntryRadius / FMath::Max(ComponentTransform.GetMaximumAxisScale(), KINDA_SMALL_NUMBER);
+
+    int32 BestIndex = INDEX_NONE;
+    float BestDistanceSquared = FMath::Square(LocalRadius);
+
+    for (int32 i = 0; i < ClimbFrames.Num(); ++i)
+    {
+        const float DistanceSquared = FVector3f::DistSquared(ClimbFrames[i].Location, LocalLocation);
+        if (DistanceSquared <= BestDistanceSquared)
+        {
+            BestIndex = i;
+            BestDistanceSquared = DistanceSquared;
+        }
+    }
+
+    if (BestIndex == INDEX_NONE)
+        return false;
+
+    OutDistance = BestIndex * FrameStep;
+    OutDistanceSquared = BestDistanceSquared;
+    return true;
+}
+
+float UClimbSplineComponent::FindNearestDistance(const FVector &Location, float NearDistance) const
+{
+    if (!HasClimbFrames())
+        return NearDistance;
+
+    const FVector3f LocalLocation = FVector3f(GetComponentTransform().InverseTransformPosition(Location));
+
+    // A climber moves a few frames per tick at most, walk downhill from where it was instead of testing every frame
+    int32 Index = FMath::Clamp(FMath::RoundToInt(NearDistance / FrameStep), 0, ClimbFrames.Num() - 1);
+    float IndexDistanceSquared = FVector3f::DistSquared(ClimbFrames[Index].Location, LocalLocation);
+
+    for (const int32 Step : {-1, 1})
+    {
+        while (ClimbFrames.IsValidIndex(Index + Step))
+        {
+            const float DistanceSquared = FVector3f::DistSquared(ClimbFrames[Index + Step].Location, LocalLocation);
+            if (DistanceSquared >= IndexDistanceSquared)
+                break;
+
+            Index += Step;
+            IndexDistanceSquared = DistanceSquared;
+        }
+    }
+
+    // Between the closest frame and whichever neighbour the location is past
+    float BestDistance = Index * FrameStep;
+    float BestDistanceSquared = IndexDistanceSquared;
+
+    for (const int32 Neighbour : {Index - 1, Index + 1})
+    {
+        if (!ClimbFrames.IsValidIndex(Neighbour))
+            continue;
+
+        const FVector3f &From = ClimbFrames[Index].Location;
+        const FVector3f Segment = ClimbFrames[Neighbour].Location - From;
+        const float Alpha = FMath::Clamp(FVector3f::DotProduct(LocalLocation - From, Segment) / FMath::Max(Segment.SizeSquared(), KINDA_SMALL_NUMBER), 0.f, 1.f);
+        const float DistanceSquared = FVector3f::DistSquared(From + Segment * Alpha, LocalLocation);
+
+        if (DistanceSquared < BestDistanceSquared)
+        {
+            BestDistance = (Index + (Neighbour - Index) * Alpha) * FrameStep;
+            BestDistanceSquared = DistanceSquared;
+        }
+    }
+
+    return BestDistance;
+}
+
+bool UClimbSplineComponent::FindWallClimbEntryDistance(const FVector &Location, const FVector &Direction, float &OutDistance) const
+{
+    if (!HasClimbFrames())
+        return false;
+
+    for (const bool bTop : {false, true})
+    {
+        if (GetExit(bTop) != EClimbSplineExit::WallClimb)
+            continue;
+
+        const float EndDistance = bTop ? ClimbEndDistance : ClimbStartDistance;
+        const FVector OntoPath = GetInputAxisAtDistance(EndDistance) * (bTop ? -1.f : 1.f);
+
+        if (FVector::DotProduct(Direction, OntoPath) <= 0.f)
+            continue;
+        if (FVector::DistSquared(GetClimberTransformAtDistance(EndDistance).GetLocation(), Location) > FMath::Square(EntryRadius))
+            continue;
+
+        OutDistance = EndDistance;
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,53 @@
+#include "Components/ClimbSplineSubsystem.h"
+#include "Components/ClimbSplineComponent.h"
+#include "Engine/World.h"
+
+bool UClimbSplineSubsystem::ShouldCreateSubsystem(UObject *Outer) const
+{
+    const UWorld *World = Cast<UWorld>(Outer);
+    return Super::ShouldCreateSubsystem(Outer) && World && World->IsGameWorld();
+}
+
+void UClimbSplineSubsystem::Register(UClimbSplineComponent &Spline)
+{
+    Splines.AddUnique(&Spline);
+}
+
+void UClimbSplineSubsystem::Unregister(UClimbSplineComponent &Spline)
+{
+    Splines.RemoveSwap(&Spline);
+}
+
+UClimbSplineComponent *UClimbSplineSubsystem::FindEntry(const FVector &Location, float &OutDistance) const
+{
+    UClimbSplineComponent *BestSpline = nullptr;
+    float BestDistanceSquared = MAX_flt;
+
+    for (const TWeakObjectPtr<UClimbSplineComponent> &WeakSpline : Splines)
+    {
+        UClimbSplineComponent *Spline = WeakSpline.Get();
+
+        float Distance;
+        float DistanceSquared;
+        if (!Spline || !Spline->FindEntryDistance(Location, Distance, DistanceSquared) || DistanceSquared >= BestDistanceSquared)
+            continue;
+
+        BestSpline = Spline;
+        BestDistanceSquared = DistanceSquared;
+        OutDistance = Distance;
+    }
+
+    return BestSpline;
+}
+
+UClimbSplineComponent *UClimbSplineSubsystem::FindWallClimbEntry(const FVector &Location, const FVector &Direction, float &OutDistance) const
+{
+    for (const TWeakObjectPtr<UClimbSplineComponent> &WeakSpline : Splines)
+    {
+        UClimbSplineComponent *Spline = WeakSpline.Get();
+        if (Spline && Spline->FindWallClimbEntryDistance(Location, Direction, OutDistance))
+            return Spline;
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,134 @@
+#include "Components/ClimbSpringArmComponent.h"
+#include "Components/CustomMovementComponent.h"
+#include "GameFramework/Character.h"
+#include "Engine/World.h"
+#include "ClimbingSystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Climb Camera Arm"), STAT_ClimbCameraArm, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Camera Occlusion Probes"), STAT_ClimbCameraOcclusionProbes, STATGROUP_Climbing);
+
+UClimbSpringArmComponent::UClimbSpringArmComponent()
+{
+    ClimbFraming = FClimbCameraFraming(300.f, FVector(0.f, 40.f, 0.f), 120.f, 40.f);
+    HangFraming = FClimbCameraFraming(350.f, FVector(0.f, 0.f, 30.f), 160.f, 60.f);
+}
+
+void UClimbSpringArmComponent::OnRegister()
+{
+    Super::OnRegister();
+
+    if (const ACharacter *OwnerCharacter = Cast<ACharacter>(GetOwner()))
+    {
+        CustomMovementComponent = Cast<UCustomMovementComponent>(OwnerCharacter->GetCharacterMovement());
+    }
+}
+
+void UClimbSpringArmComponent::UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+    SCOPE_CYCLE_COUNTER(STAT_ClimbCameraArm);
+
+    const FClimbCameraFraming &Framing = GetCurrentFraming();
+    const bool bOnWall = &Framing != &GroundFraming;
+
+    if (!bFramingInitialized)
+    {
+        BlendedFramingArmLength = Framing.ArmLength;
+        BlendedSocketOffset = Framing.SocketOffset;
+        BlendedWallOffset = Framing.WallOffset;
+        BlendedHeightOffset = Framing.HeightOffset;
+        CurrentArmLength = Framing.ArmLength;
+        bFramingInitialized = true;
+    }
+    else
+    {
+        BlendedFramingArmLength = FMath::FInterpTo(BlendedFramingArmLength, Framing.ArmLength, DeltaTime, FramingBlendSpeed);
+        BlendedSocketOffset = FMath::VInterpTo(BlendedSocketOffset, Framing.SocketOffset, DeltaTime, FramingBlendSpeed);
+        BlendedWallOffset = FMath::FInterpTo(BlendedWallOffset, Framing.WallOffset, DeltaTime, FramingBlendSpeed);
+        BlendedHeightOffset = FMath::FInterpTo(BlendedHeightOffset, Framing.HeightOffset, DeltaTime, FramingBlendSpeed);
+    }
+
+    // The last wall normal is kept after leaving the wall, while the wall offset blends out
+    if (bOnWall)
+    {
+        const FVector WallNormal = CustomMovementComponent->GetClimbableSurfaceNormal();
+        SmoothedWallNormal = SmoothedWallNormal.IsZero()
+                                 ? WallNormal
+                                 : FMath::VInterpTo(SmoothedWallNormal, WallNormal, DeltaTime, WallNormalBlendSpeed).GetSafeNormal();
+    }
+
+    SocketOffset = BlendedSocketOffset;
+    TargetOffset = SmoothedWallNormal * BlendedWallOffset + FVector::UpVector * BlendedHeightOffset;
+
+    const FRotator DesiredRotation = GetTargetRotation();
+    if (!bDoTrace)
+    {
+        OccludedArmLength = TNumericLimits<float>::Max();
+    }
+    else if (!bOnWall || ShouldProbeOcclusion(DesiredRotation, GetComponentLocation() + TargetOffset))
+    {
+        ProbeOcclusion(DesiredRotation);
+    }
+
+    const float DesiredArmLength = FMath::Min(BlendedFramingArmLength, OccludedArmLength);
+    const float ArmInterpSpeed = DesiredArmLength < CurrentArmLength ? OcclusionPullInSpeed : OcclusionEaseOutSpeed;
+    CurrentArmLength = FMath::FInterpTo(CurrentArmLength, DesiredArmLength, DeltaTime, ArmInterpSpeed);
+    TargetArmLength = CurrentArmLength;
+
+    // Occlusion was handled above, at the reduced rate on a wall, so the stock per frame probe stays off
+    Super::UpdateDesiredArmLocation(false, bDoLocationLag, bDoRotationLag, DeltaTime);
+}
+
+const FClimbCameraFraming &UClimbSpringArmComponent::GetCurrentFraming() const
+{
+    if (!CustomMovementComponent)
+        return GroundFraming;
+
+    if (CustomMovementComponent->IsHanging())
+        return HangFraming;
+
+    if (CustomMovementComponent->IsClimbing() || CustomMovementComponent->IsClimbingSpline())
+        return ClimbFraming;
+
+    return GroundFraming;
+}
+
+bool UClimbSpringArmComponent::ShouldProbeOcclusion(const FRotator &DesiredRotation, const FVector &ArmOrigin) const
+{
+    if (LastProbeFrame == 0)
+        return true;
+
+    if (FVector::DistSquared(ArmOrigin, LastProbeOrigin) > FMath::Square(OcclusionReprobeDistance))
+        return true;
+
+    const float TurnedDegrees = FMath::RadiansToDegrees(DesiredRotation.Quaternion().AngularDistance(LastProbeRotation.Quaternion()));
+    if (TurnedDegrees > OcclusionReprobeAngle)
+        return true;
+
+    const uint64 Interval = FMath::Max(OcclusionProbeInterval, 1);
+    return (GFrameCounter + GetUniqueID()) % Interval == 0;
+}
+
+void UClimbSpringArmComponent::ProbeOcclusion(const FRotator &DesiredRotation)
+{
+    INC_DWORD_STAT(STAT_ClimbCameraOcclusionProbes);
+
+    const FVector ArmOrigin = GetComponentLocation() + TargetOffset;
+
+    LastProbeFrame = GFrameCounter;
+    LastProbeRotation = DesiredRotation;
+    LastProbeOrigin = ArmOrigin;
+    const FVector ArmEnd = ArmOrigin - DesiredRotation.Vector() * BlendedFramingArmLength + FRotationMatrix(DesiredRotation).TransformVector(SocketOffset);
+
+    FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ClimbSpringArm), false, GetOwner());
+    FHitResult Hit;
+
+    if (GetWorld()->SweepSingleByChannel(Hit, ArmOrigin, ArmEnd, FQuat::Identity, ProbeChannel, FCollisionShape::MakeSphere(ProbeSize), QueryParams))
+    {
+        OccludedArmLength = Hit.Time * BlendedFramingArmLength;
+    }
+    else
+    {
+        OccludedArmLength = TNumericLimits<float>::Max();
+    }
+}
@@ -1,15 +1,290 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "../../Public/Components/CustomMovementComponent.h"
+#include "../../Public/Components/ClimbSurfaceRules.h"
+#include "../../Public/Components/CustomMovementModes.h"
+#include "../../Public/Components/ClimbAsyncPhysicsSubsystem.h"
+#include "../../Public/Components/ClimbRewindSubsystem.h"
+#include "../../Public/Components/ClimbDistanceFieldUserData.h"
+#include "../../Public/Components/ClimbQueryBudgetSubsystem.h"
+#include "../../Public/Components/ClimbSplineComponent.h"
+#include "../../Public/Components/ClimbSplineSubsystem.h"
+#include "../../Public/Components/ClimbEffectsSubsystem.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "../../ClimbingSystemCharacter.h"
 #include "MotionWarpingComponent.h"
 #include "../../DebugHelper.h"
+#include "../../ClimbingSystem.h"
+#include "../../ClimbAllocAudit.h"
 #include "Components/CapsuleComponent.h"
+#include "EngineUtils.h"
+#include "Animation/AnimMontage.h"
+#include "Engine/OverlapResult.h"
+#include "Engine/World.h"
+#include "Containers/Ticker.h"
+#include "GameFramework/GameStateBase.h"
+#include "GameFramework/PlayerState.h"
+
+DECLARE_CYCLE_STAT(TEXT("Climb Apply Root Motion Source"), STAT_ClimbApplyRootMotionSource, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("Climb Phys"), STAT_ClimbPhys, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("Climb Spline Phys"), STAT_ClimbSplinePhys, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("Climb Apply Async Physics"), STAT_ClimbApplyAsyncPhysics, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("Climb Ledge Grab"), STAT_ClimbLedgeGrab, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Ledge Grab Candidate Refreshes"), STAT_ClimbLedgeGrabCandidateRefreshes, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Ledge Grab Precise Checks"), STAT_ClimbLedgeGrabPreciseChecks, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Start Rejections"), STAT_ClimbStartRejections, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Start Unrewound Queries"), STAT_ClimbStartUnrewoundQueries, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Distance Field Probes"), STAT_ClimbDistanceFieldProbes, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Corner Transitions"), STAT_ClimbCornerTransitions, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("Climb Contextual Action"), STAT_ClimbContextualAction, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Contextual Action Evaluations"), STAT_ClimbContextualActionEvaluations, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Presses From Contextual Action"), STAT_ClimbPressesFromContextualAction, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("Climb Event Dispatch"), STAT_ClimbEventDispatch, STATGROUP_Climbing);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Climb Events Dispatched"), STAT_ClimbEventsDispatched, STATGROUP_Climbing);
+
+namespace
+{
+    const FCollisionQueryParams &GetClimbTraceQueryParams()
+    {
+        // Matches what the Kismet trace wrappers used to pass
+        static FCollisionQueryParams Params = []
+        {
+            FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(ClimbTrace), false);
+            QueryParams.bReturnPhysicalMaterial = true;
+            return QueryParams;
+        }();
+        return Params;
+    }
+
+    // Proximity trace, CanStartClimbing, CanClimbDownLedge and CanStartVaulting
+    constexpr int32 ContextualActionQueryCount = 1 + 2 + 2 + ClimbSurfaceRules::VaultTraceCount;
+
+    TAutoConsoleVariable<bool> CVarClimbCancelWindows(
+        TEXT("Climb.CancelWindows"),
+        true,
+        TEXT("Let climb montage cancel windows cut actions short. Turn off to measure chains without them"));
+
+    TAutoConsoleVariable<bool> CVarClimbDeferEvents(
+        TEXT("Climb.DeferEvents"),
+        true,
+        TEXT("Dispatch climb events and capsule overlap updates at the end of the movement tick. Turn off to measure them inside the movement step"));
+
+    // Sweep output is only needed until the manifold has consumed it, so all climbers share one buffer
+    TArray<FHitResult> &GetClimbSweepScratchHits()
+    {
+        check(IsInGameThread());
+        static TArray<FHitResult> ScratchHits;
+        ScratchHits.Reset();
+        return ScratchHits;
+    }
+
+    FAutoConsoleCommandWithWorld ReportClimbContactMemoryCommand(
+        TEXT("Climb.ReportContactMemory"),
+        TEXT("Logs the climb contact memory per climber, as stored FHitResult arrays and as a contact manifold"),
+        FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld *World)
+        {
+            for (TObjectIterator<UCustomMovementComponent> It; It; ++It)
+            {
+                if (It->GetWorld() != World)
+                    continue;
+
+                const int32 NumHits = It->GetLastClimbSweepHitCount();
+                UE_LOG(LogClimbing, Display, TEXT("%s: %d sweep hits, FHitResult array %d bytes (%d per hit), contact manifold %d bytes"),
+                    *GetNameSafe(It->GetOwner()),
+                    NumHits,
+                    int32(sizeof(TArray<FHitResult>) + NumHits * sizeof(FHitResult)),
+                    int32(sizeof(FHitResult)),
+                    int32(sizeof(FClimbContactManifold)));
+            }
+        }));
+
+    FAutoConsoleCommandWithWorld ReportClimbInputLatencyCommand(
+        TEXT("Climb.ReportInputLatency"),
+        TEXT("Logs press to action latency of the buffered climb actions per climber, in frames"),
+        FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld *World)
+        {
+            for (TObjectIterator<UCustomMovementComponent> It; It; ++It)
+            {
+                if (It->GetWorld() != World)
+                    continue;
+
+                for (const EClimbInputAction Action : {EClimbInputAction::Climb, EClimbInputAction::Hop})
+                {
+                    const FClimbInputLatency &Latency = It->GetClimbInputBuffer().GetLatency(Action);
+                    UE_LOG(LogClimbing, Display, TEXT("%s %s: %d fired (%d buffered), %d expired, %.2f frames average, %d frames max"),
+                        *GetNameSafe(It->GetOwner()),
+                        Action == EClimbInputAction::Climb ? TEXT("Climb") : TEXT("Hop"),
+                        Latency.NumFired,
+                        Latency.NumBuffered,
+                        Latency.NumExpired,
+                        Latency.GetAverageFrames(),
+                        Latency.MaxFrames);
+                }
+            }
+        }));
+
+    FAutoConsoleCommandWithWorld ReportClimbActionChainsCommand(
+        TEXT("Climb.ReportActionChains"),
+        TEXT("Logs and resets the timing of chained climb actions per climber, compare with Climb.CancelWindows on and off"),
+        FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld *World)
+        {
+            for (TObjectIterator<UCustomMovementComponent> It; It; ++It)
+            {
+                if (It->GetWorld() != World)
+                    continue;
+
+                FClimbActionChainStats &Stats = It->GetClimbActionChainStats();
+                UE_LOG(LogClimbing, Display, TEXT("%s: %d actions, %d cancelled (%.2f s of montage skipped), %d chains, %.3f s average start to start, %.3f s average gap"),
+                    *GetNameSafe(It->GetOwner()),
+                    Stats.NumActions,
+                    Stats.NumCancelled,
+                    Stats.TotalTimeSaved,
+                    Stats.NumChains,
+                    Stats.NumChains > 0 ? Stats.TotalChainStartToStart / Stats.NumChains : 0.0,
+                    Stats.NumChains > 0 ? Stats.TotalChainGap / Stats.NumChains : 0.0);
+
+                Stats = FClimbActionChainStats();
+            }
+        }));
+
+    FAutoConsoleCommandWithWorld ReportClimbEventsCommand(
+        TEXT("Climb.ReportEvents"),
+        TEXT("Logs and resets the climb event and capsule overlap work per climber, compare with Climb.DeferEvents on and off"),
+        FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld *World)
+        {
+            for (TObjectIterator<UCustomMovementComponent> It; It; ++It)
+            {
+                if (It->GetWorld() != World)
+                    continue;
+
+                FClimbEventStats &Stats = It->GetClimbEventStats();
+                UE_LOG(LogClimbing, Display, TEXT("%s: %d events posted, %d coalesced, %d dispatched after the tick (%.3f ms), %d inside the movement step (%.3f ms), %d capsule resizes, %d overlap updates (%d inside the movement step)"),
+                    *GetNameSafe(It->GetOwner()),
+                    Stats.NumPosted,
+                    Stats.NumCoalesced,
+                    Stats.NumDispatched,
+                    FPlatformTime::ToMilliseconds64(Stats.DispatchCycles),
+                    Stats.NumDispatchedInStep,
+                    FPlatformTime::ToMilliseconds64(Stats.InStepDispatchCycles),
+                    Stats.NumCapsuleResizes,
+                    Stats.NumOverlapUpdates,
+                    Stats.NumOverlapUpdatesInStep);
+
+                Stats = FClimbEventStats();
+            }
+        }));
+
+    // Game thread time with the climbers' meshes ticking, then with them off, as on a dedicated server with procedural root motion
+    struct FServerMeshTickMeasurement
+    {
+        TWeakObjectPtr<UWorld> World;
+        TArray<TPair<TWeakObjectPtr<USkeletalMeshComponent>, bool>> Meshes;
+        float PhaseSeconds = 0.f;
+        double PhaseEndTime = 0.0;
+        uint64 PhaseStartFrame = 0;
+        int32 Phase = 0;
+        int32 NumFrames[2] = {};
+        double GameThreadTimeSum[2] = {};
+        int32 NumClimbing = 0;
+        FTSTicker::FDelegateHandle TickerHandle;
+    };
+
+    FServerMeshTickMeasurement ServerMeshTickMeasurement;
+
+    void SetMeasuredMeshesTickEnabled(bool bEnabled)
+    {
+        for (const TPair<TWeakObjectPtr<USkeletalMeshComponent>, bool> &Mesh : ServerMeshTickMeasurement.Meshes)
+        {
+            if (USkeletalMeshComponent *MeshComponent = Mesh.Key.Get())
+            {
+                MeshComponent->SetComponentTickEnabled(bEnabled);
+            }
+        }
+    }
+
+    bool TickServerMeshTickMeasurement(float DeltaTime)
+    {
+        FServerMeshTickMeasurement &Measurement = ServerMeshTickMeasurement;
+        const UWorld *World = Measurement.World.Get();
+
+        if (World)
+        {
+            // GGameThreadTime is the last full frame, so the first frame of each phase still ran under the previous one
+            if (GFrameCounter <= Measurement.PhaseStartFrame + 1)
+                return true;
+
+            Measurement.NumFrames[Measurement.Phase]++;
+            Measurement.GameThreadTimeSum[Measurement.Phase] += FPlatformTime::ToMilliseconds(GGameThreadTime);
+
+            if (World->GetRealTimeSeconds() < Measurement.PhaseEndTime)
+                return true;
+
+            if (Measurement.Phase == 0)
+            {
+                Measurement.Phase = 1;
+                Measurement.PhaseEndTime = World->GetRealTimeSeconds() + Measurement.PhaseSeconds;
+                Measurement.PhaseStartFrame = GFrameCounter;
+                SetMeasuredMeshesTickEnabled(false);
+                return true;
+            }
+
+            const double WithMeshTick = Measurement.GameThreadTimeSum[0] / FMath::Max(Measurement.NumFrames[0], 1);
+            const double WithoutMeshTick = Measurement.GameThreadTimeSum[1] / FMath::Max(Measurement.NumFrames[1], 1);
+            UE_LOG(LogClimbing, Display, TEXT("Server mesh tick: %d characters (%d climbing), game thread %.3f ms with mesh ticks and %.3f ms without, %.3f ms saved per character"),
+                Measurement.Meshes.Num(),
+                Measurement.NumClimbing,
+                WithMeshTick,
+                WithoutMeshTick,
+                (WithMeshTick - WithoutMeshTick) / FMath::Max(Measurement.Meshes.Num(), 1));
+        }
+
+        for (const TPair<TWeakObjectPtr<USkeletalMeshComponent>, bool> &Mesh : Measurement.Meshes)
+        {
+            if (USkeletalMeshComponent *MeshComponent = Mesh.Key.Get())
+            {
+                MeshComponent->SetComponentTickEnabled(Mesh.Value);
+            }
+        }
+
+        Measurement = FServerMeshTickMeasurement();
+        return false;
+    }
+
+    FAutoConsoleCommandWithWorldAndArgs MeasureServerMeshTickCommand(
+        TEXT("Climb.MeasureServerMeshTick"),
+        TEXT("Climb.MeasureServerMeshTick [Seconds=10]: logs the game thread time per character saved by not ticking the climbing characters' meshes, run it on the server"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+        {
+            if (!World || ServerMeshTickMeasurement.TickerHandle.IsValid())
+                return;
+
+            FServerMeshTickMeasurement &Measurement = ServerMeshTickMeasurement;
+            Measurement.World = World;
+            Measurement.PhaseSeconds = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 10.f;
+            Measurement.PhaseEndTime = World->GetRealTimeSeconds() + Measurement.PhaseSeconds;
+            Measurement.PhaseStartFrame = GFrameCounter;
+
+            for (TActorIterator<ACharacter> It(World); It; ++It)
+            {
+                const UCustomMovementComponent *MovementComponent = Cast<UCustomMovementComponent>(It->GetCharacterMovement());
+                USkeletalMeshComponent *MeshComponent = It->GetMesh();
+                if (!MovementComponent || !MeshComponent)
+                    continue;
+
+                Measurement.Meshes.Emplace(MeshComponent, MeshComponent->IsComponentTickEnabled());
+                Measurement.NumClimbing += MovementComponent->IsClimbing() ? 1 : 0;
+            }
+
+            SetMeasuredMeshesTickEnabled(true);
+            Measurement.TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&TickServerMeshTickMeasurement));
+        }));
+}
 
 void UCustomMovementComponent::BeginPlay()
 {
+    LLM_SCOPE_BYTAG(Climbing);
+
     Super::BeginPlay();
 
     OwningPlayerAnimInstance = CharacterOwner->GetMesh()->GetAnimInstance();
@@ -18,37 +293,108 @@ void UCustomMovementComponent::BeginPlay()
     {
         OwningPlayerAnimInstance->OnMontageEnded.AddDynamic(this, &UCustomMovementComponent::OnClimbMontageEnded);
         OwningPlayerAnimInstance->OnMontageBlendingOut.AddDynamic(this, &UCustomMovementComponent::OnClimbMontageEnded);
+
+        // Montages are cosmetic only, the root motion sources move the character
+        if (ShouldUseProceduralRootMotion())
+        {
+            OwningPlayerAnimInstance->SetRootMotionMode(ERootMotionMode::IgnoreRootMotion);
+        }
     }
 
     OwningPlayerCharacter = Cast<AClimbingSystemCharacter>(CharacterOwner);
+    ClimbRewind = GetWorld()->GetSubsystem<UClimbRewindSubsystem>();
+    ClimbQueryBudget = GetWorld()->GetSubsystem<UClimbQueryBudgetSubsystem>();
+    ClimbSplines = GetWorld()->GetSubsystem<UClimbSplineSubsystem>();
+
+    if (UClimbEffectsSubsystem *ClimbEffects = GetWorld()->GetSubsystem<UClimbEffectsSubsystem>())
+    {
+        ClimbEffects->RegisterClimber(*this);
+
+        // Floor sweeps run with the capsule's collision params, this makes them report the landing surface of a vault
+        CharacterOwner->GetCapsuleComponent()->bReturnMaterialOnMove = true;
+    }
+
+    ClimbInputBuffer.Windows[int32(EClimbInputAction::Climb)] = ClimbInputBufferWindow;
+    ClimbInputBuffer.Windows[int32(EClimbInputAction::Hop)] = HopInputBufferWindow;
+
+    ClimbQueryObjectTypes = ClimbableSurfaceTraceTypes;
+    if (bUseClimbCollisionProxies)
+    {
+        ClimbQueryObjectTypes = {UEngineTypes::ConvertToObjectType(ECC_ClimbProxy)};
+    }
+    ClimbObjectQueryParams = FCollisionObjectQueryParams(ClimbQueryObjectTypes);
+
+    if (ShouldUseProceduralRootMotion())
+    {
+        for (const UAnimMontage *Montage : {IdleToClimbMontage, ClimbToTopMontage, ClimbDownLedgeMontage, VaultMontage, HopUpMontage, HopDownMontage})
+        {
+            GetClimbRootMotionBake(Montage);
+        }
+
+        if (bDisableMeshTickOnDedicatedServer && IsNetMode(NM_DedicatedServer))
+        {
+            CharacterOwner->GetMesh()->SetComponentTickEnabled(false);
+        }
+    }
+}
+
+void UCustomMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    ReleaseAsyncClimber();
+
+    Super::EndPlay(EndPlayReason);
 }
 
 void UCustomMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction)
 {
+    LLM_SCOPE_BYTAG(Climbing);
+
+#if CLIMB_ALLOC_AUDIT
+    ClimbAllocAudit::BeginTick();
+#endif
+
+    ApplyEndedClimbMontage();
+
     Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    TickClimbRootMotionSource();
+    UpdateClimbLocomotionCancel();
+    ProcessClimbInputBuffer();
+    UpdateAirborneLedgeGrab();
+    UpdateContextualAction();
+    DispatchClimbEvents();
+
+    // The first ticks of a climb grow the shared buffers, they are not steady state
+    SteadyClimbTicks = IsClimbing() && !IsClimbActionPlaying() ? SteadyClimbTicks + 1 : 0;
+
+#if CLIMB_ALLOC_AUDIT
+    ClimbAllocAudit::EndTick(*this, SteadyClimbTicks > ClimbAllocAudit::SteadyStateWarmupTicks);
+#endif
 }
 
 void UCustomMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode)
 {
-    if (IsClimbing())
+    if (PreviousMovementMode == MOVE_Custom)
     {
-        bOrientRotationToMovement = false;
-        CharacterOwner->GetCapsuleComponent()->SetCapsuleHalfHeight(48.f);
-        OnEnterClimbStateDelegate.ExecuteIfBound();
+        FCustomMovementModes::Visit(PreviousCustomMode, [this](auto Mode)
+        {
+            decltype(Mode)::OnExit(*this);
+        });
     }
 
-    if (PreviousMovementMode == MOVE_Custom && PreviousCustomMode == ECustomMovementMode::MOVE_Climb)
+    if (MovementMode == MOVE_Custom)
     {
-        bOrientRotationToMovement = true;
-        CharacterOwner->GetCapsuleComponent()->SetCapsuleHalfHeight(96.f);
-
-        // Reset pitch and roll
-        const FRotator DirtyRotation = UpdatedComponent->GetComponentRotation();
-        const FRotator CleanStandRotation = FRotator(0.f, DirtyRotation.Yaw, 0.f);
-        UpdatedComponent->SetRelativeRotation(CleanStandRotation);
+        FCustomMovementModes::Visit(CustomMovementMode, [this](auto Mode)
+        {
+            decltype(Mode)::OnEnter(*this);
+        });
+    }
 
-        StopMovementImmediately();
-        OnExitClimbStateDelegate.ExecuteIfBound();
+    if (MovementMode == MOVE_Falling)
+    {
+        // Candidates from an earlier fall are likely far away now
+        LedgeGrabCandidatesTime = -1.0;
+        LedgeGrabRetryTime = -1.0;
     }
 
     Super::OnMovementModeChanged(PreviousMovementMode, PreviousCustomMode);
@@ -56,36 +402,48 @@ void UCustomMovementComponent::OnMovementModeChanged(EMovementMode PreviousMovem
 
 void UCustomMovementComponent::PhysCustom(float deltaTime, int32 Iterations)
 {
-    if (IsClimbing())
+    LLM_SCOPE_BYTAG(Climbing);
+    CLIMB_ALLOC_AUDIT_SCOPE(PhysCustom);
+
+    FCustomMovementModes::Visit(CustomMovementMode, [this, deltaTime, Iterations](auto Mode)
     {
-        PhysClimb(deltaTime, Iterations);
-    }
+        using TMode = decltype(Mode);
+
+        RunProbes(TMode::RequiredProbes);
+        TMode::PhysStep(*this, deltaTime, Iterations);
+    });
 
     Super::PhysCustom(deltaTime, Iterations);
 }
 
 float UCustomMovementComponent::GetMaxSpeed() const
 {
-    if (IsClimbing())
-    {
-        return MaxClimbSpeed;
-    }
-    else
+    float MaxModeSpeed = 0.f;
+
+    if (MovementMode == MOVE_Custom && FCustomMovementModes::Visit(CustomMovementMode, [this, &MaxModeSpeed](auto Mode)
+        {
+            MaxModeSpeed = decltype(Mode)::GetMaxSpeed(*this);
+        }))
     {
-        return Super::GetMaxSpeed();
+        return MaxModeSpeed;
     }
+
+    return Super::GetMaxSpeed();
 }
 
 float UCustomMovementComponent::GetMaxAcceleration() const
 {
-    if (IsClimbing())
-    {
-        return MaxClimbAcceleration;
-    }
-    else
+    float MaxModeAcceleration = 0.f;
+
+    if (MovementMode == MOVE_Custom && FCustomMovementModes::Visit(CustomMovementMode, [this, &MaxModeAcceleration](auto Mode)
+        {
+            MaxModeAcceleration = decltype(Mode)::GetMaxAcceleration(*this);
+        }))
     {
-        return Super::GetMaxAcceleration();
+        return MaxModeAcceleration;
     }
+
+    return Super::GetMaxAcceleration();
 }
 
 FVector UCustomMovementComponent::ConstrainAnimRootMotionVelocity(const FVector &RootMotionVelocity, const FVector &CurrentVelocity) const
@@ -103,62 +461,250 @@ FVector UCustomMovementComponent::ConstrainAnimRootMotionVelocity(const FVector
     }
 }
 
-#pragma region ClimbTraces
-TArray<FHitResult> UCustomMovementComponent::DoCapsuleTraceMultiByObject(const FVector &Start, const FVector &End, bool bShowDebugShape, bool bDrawPersistentShapes)
+#pragma region ModeSupport
+void UCustomMovementComponent::RunProbes(EClimbProbe Probes)
 {
-    TArray<FHitResult> OutCapsuleTraceHitResults;
+    CLIMB_ALLOC_AUDIT_SCOPE(RunProbes);
 
-    EDrawDebugTrace::Type DebugTraceType = EDrawDebugTrace::None;
-    if (bShowDebugShape)
+    // The physics thread climb step runs its own surface queries, and a corner turn follows the plane pair it started from
+    if (EnumHasAnyFlags(Probes, EClimbProbe::SurfaceContacts) && !ShouldRunClimbOnPhysicsThread() && !ClimbCornerTransition.IsActive())
     {
-        DebugTraceType = EDrawDebugTrace::ForOneFrame;
-
-        if (bDrawPersistentShapes)
+        // Contacts follow a moving primitive on their own, only sweep again when the climber moved on it
+        if (CanReuseClimbContacts())
         {
-            DebugTraceType = EDrawDebugTrace::Persistent;
+            ClimbContacts.UpdateFromLocalSpace(ClimbContactBase->GetComponentTransform());
+            ProcessClimbableSurfaceInfo();
         }
+        else if (!TrackClimbableSurfaceWithDistanceField())
+        {
+            // Over the query budget the contacts stay where they were on the climbed primitive
+            if (ClimbContacts.IsEmpty() || AcquireClimbQueries(1, LastClimbSurfaceQueryTime))
+            {
+                GetClimbableSurfaces();
+                LastClimbSurfaceQueryTime = GetWorld()->GetTimeSeconds();
+            }
+            else if (ClimbContactBase.IsValid() && !ClimbContacts.SpansMultiplePrimitives())
+            {
+                ClimbContacts.UpdateFromLocalSpace(ClimbContactBase->GetComponentTransform());
+            }
+
+            ProcessClimbableSurfaceInfo();
+        }
+
+        UpdateClimbMovementBase();
     }
 
-    UKismetSystemLibrary::CapsuleTraceMultiForObjects(
-        this,
-        Start,
-        End,
-        ClimbCapsuleTraceRadius,
-        ClimbCapsuleTraceHalfHeight,
-        ClimbableSurfaceTraceTypes,
-        false,
-        TArray<AActor *>(),
-        DebugTraceType,
-        OutCapsuleTraceHitResults,
-        false);
+    if (EnumHasAnyFlags(Probes, EClimbProbe::LedgeValidation))
+    {
+        ProbeHangLedge();
+    }
+}
+
+void UCustomMovementComponent::SetCharacterCapsuleHalfHeight(float HalfHeight)
+{
+    UCapsuleComponent *Capsule = CharacterOwner->GetCapsuleComponent();
+    if (Capsule->GetUnscaledCapsuleHalfHeight() == HalfHeight)
+        return;
+
+    FClimbEventStats &Stats = ClimbEvents.Stats;
+    Stats.NumCapsuleResizes++;
+
+    // Mode changes run inside the movement step, one overlap update after the tick covers every resize of the frame
+    if (CVarClimbDeferEvents.GetValueOnGameThread())
+    {
+        Capsule->SetCapsuleHalfHeight(HalfHeight, false);
+        bCapsuleOverlapsPending = true;
+        return;
+    }
 
-    return OutCapsuleTraceHitResults;
+    Capsule->SetCapsuleHalfHeight(HalfHeight);
+    Stats.NumOverlapUpdates++;
+    Stats.NumOverlapUpdatesInStep++;
 }
 
-FHitResult UCustomMovementComponent::DoLineTraceSingleByObject(const FVector &Start, const FVector &End, bool bShowDebugShape, bool bDrawPersistentShapes)
+void UCustomMovementComponent::ResetPitchAndRoll()
 {
-    FHitResult OutHit;
+    const FRotator DirtyRotation = UpdatedComponent->GetComponentRotation();
+    const FRotator CleanStandRotation = FRotator(0.f, DirtyRotation.Yaw, 0.f);
+    UpdatedComponent->SetRelativeRotation(CleanStandRotation);
+}
+#pragma endregion
 
-    EDrawDebugTrace::Type DebugTraceType = EDrawDebugTrace::None;
-    if (bShowDebugShape)
+#pragma region ClimbBase
+bool UCustomMovementComponent::CanReuseClimbContacts() const
+{
+    const UPrimitiveComponent *Base = ClimbContactBase.Get();
+    if (!Base || ClimbContacts.IsEmpty())
+        return false;
+
+    // Only the contacts on the base follow it, a corner between two meshes needs the sweep to keep both faces
+    if (ClimbContacts.SpansMultiplePrimitives())
+        return false;
+
+    const FTransform RelativeTransform = UpdatedComponent->GetComponentTransform().GetRelativeTransform(Base->GetComponentTransform());
+
+    return FVector::DistSquared(RelativeTransform.GetLocation(), ClimbSweepRelativeTransform.GetLocation()) < FMath::Square(ClimbReprobeDistance) &&
+           RelativeTransform.GetRotation().AngularDistance(ClimbSweepRelativeTransform.GetRotation()) < FMath::DegreesToRadians(ClimbReprobeAngle);
+}
+
+void UCustomMovementComponent::UpdateClimbMovementBase()
+{
+    // Based movement carries the climber along with a moving primitive before the climb step runs
+    UPrimitiveComponent *NewBase = IsClimbing() ? ClimbContactBase.Get() : nullptr;
+
+    if (NewBase != CharacterOwner->GetMovementBase())
+    {
+        SetBase(NewBase);
+    }
+}
+
+bool UCustomMovementComponent::SampleClimbDistanceField(FVector &OutSurfaceLocation, FVector &OutSurfaceNormal) const
+{
+    const UPrimitiveComponent *Base = ClimbContactBase.Get();
+    const UClimbDistanceFieldUserData *DistanceField = bUseClimbDistanceFields ? UClimbDistanceFieldUserData::Get(Base) : nullptr;
+    if (!DistanceField)
+        return false;
+
+    const FVector ProbeLocation = UpdatedComponent->GetComponentLocation() + UpdatedComponent->GetForwardVector() * ClimbSurfaceRules::SurfaceSweepForwardOffset;
+
+    float Distance;
+    FVector Normal;
+    if (!DistanceField->SampleWorld(Base->GetComponentTransform(), ProbeLocation, Distance, Normal))
+        return false;
+
+    OutSurfaceLocation = ProbeLocation - Normal * Distance;
+    OutSurfaceNormal = Normal;
+    return true;
+}
+
+bool UCustomMovementComponent::TrackClimbableSurfaceWithDistanceField()
+{
+    // The field only knows the climbed mesh, a periodic sweep catches other primitives and the move onto them.
+    // At a corner it blends both faces, so the sweep and the plane fit take over there, as they do for contacts on other meshes
+    if (ClimbRewindTime >= 0.0 || DistanceFieldProbesSinceSweep >= ClimbDistanceFieldSweepInterval || ClimbContacts.IsEmpty() || ClimbCorner.IsCorner() ||
+        ClimbContacts.SpansMultiplePrimitives())
+    {
+        DistanceFieldProbesSinceSweep = 0;
+        return false;
+    }
+
+    FVector SurfaceLocation;
+    FVector SurfaceNormal;
+    if (!SampleClimbDistanceField(SurfaceLocation, SurfaceNormal) || !ClimbSurfaceRules::IsClimbableSurfaceNormal(SurfaceNormal))
+    {
+        DistanceFieldProbesSinceSweep = 0;
+        return false;
+    }
+
+    INC_DWORD_STAT(STAT_ClimbDistanceFieldProbes);
+    DistanceFieldProbesSinceSweep++;
+    CurrentClimbableSurfaceLocation = SurfaceLocation;
+    CurrentClimbableSurfaceNormal = SurfaceNormal;
+    RefreshClimbContactsFromDistanceField();
+    return true;
+}
+
+void UCustomMovementComponent::RefreshClimbContactsFromDistanceField()
+{
+    const UPrimitiveComponent *Base = ClimbContactBase.Get();
+    const UClimbDistanceFieldUserData *DistanceField = UClimbDistanceFieldUserData::Get(Base);
+    if (!DistanceField)
+        return;
+
+    const FTransform &BaseTransform = Base->GetComponentTransform();
+    ClimbContacts.UpdateFromLocalSpace(BaseTransform);
+
+    // Carried along by the climber's move since the sweep, then put back on the surface, each contact keeps its ID
+    const FVector ClimberOffset = UpdatedComponent->GetComponentLocation() - BaseTransform.TransformPosition(ClimbSweepRelativeTransform.GetLocation());
+
+    for (int32 i = 0; i < ClimbContacts.Num; ++i)
     {
-        DebugTraceType = EDrawDebugTrace::ForOneFrame;
+        const FVector Position = ClimbContacts.Positions[i] + ClimberOffset;
 
-        if (bDrawPersistentShapes)
+        float Distance;
+        FVector Normal;
+        if (DistanceField->SampleWorld(BaseTransform, Position, Distance, Normal))
         {
-            DebugTraceType = EDrawDebugTrace::Persistent;
+            ClimbContacts.Positions[i] = Position - Normal * Distance;
+            ClimbContacts.Normals[i] = Normal;
         }
     }
+}
+#pragma endregion
+
+#pragma region ClimbTraces
+void UCustomMovementComponent::DoCapsuleTraceMultiByObject(const FVector &Start, const FVector &End, TArray<FHitResult> &OutCapsuleTraceHitResults, bool bShowDebugShape, bool bDrawPersistentShapes)
+{
+    CLIMB_ALLOC_AUDIT_SCOPE(DoCapsuleTraceMultiByObject);
+
+    if (bShowDebugShape)
+    {
+        UKismetSystemLibrary::CapsuleTraceMultiForObjects(
+            this,
+            Start,
+            End,
+            ClimbCapsuleTraceRadius,
+            ClimbCapsuleTraceHalfHeight,
+            ClimbQueryObjectTypes,
+            false,
+            TArray<AActor *>(),
+            bDrawPersistentShapes ? EDrawDebugTrace::Persistent : EDrawDebugTrace::ForOneFrame,
+            OutCapsuleTraceHitResults,
+            false);
+        return;
+    }
 
-    UKismetSystemLibrary::LineTraceSingleForObjects(
-        this,
+    if (ShouldRewindClimbQuery())
+    {
+        ClimbRewind->SweepMultiAtTime(
+            OutCapsuleTraceHitResults,
+            Start,
+            End,
+            FQuat::Identity,
+            FCollisionShape::MakeCapsule(ClimbCapsuleTraceRadius, ClimbCapsuleTraceHalfHeight),
+            ClimbObjectQueryParams,
+            GetClimbTraceQueryParams(),
+            ClimbRewindTime,
+            CharacterOwner->GetMovementBase());
+        return;
+    }
+
+    // Same query as the Kismet wrapper, which rebuilds the object type list on the heap every call
+    GetWorld()->SweepMultiByObjectType(
+        OutCapsuleTraceHitResults,
         Start,
         End,
-        ClimbableSurfaceTraceTypes,
-        false,
-        TArray<AActor *>(),
-        DebugTraceType, OutHit,
-        false);
+        FQuat::Identity,
+        ClimbObjectQueryParams,
+        FCollisionShape::MakeCapsule(ClimbCapsuleTraceRadius, ClimbCapsuleTraceHalfHeight),
+        GetClimbTraceQueryParams());
+}
+
+FHitResult UCustomMovementComponent::DoLineTraceSingleByObject(const FVector &Start, const FVector &End, bool bShowDebugShape, bool bDrawPersistentShapes)
+{
+    CLIMB_ALLOC_AUDIT_SCOPE(DoLineTraceSingleByObject);
+
+    FHitResult OutHit;
+
+    if (bShowDebugShape)
+    {
+        UKismetSystemLibrary::LineTraceSingleForObjects(
+            this,
+            Start,
+            End,
+            ClimbQueryObjectTypes,
+            false,
+            TArray<AActor *>(),
+            bDrawPersistentShapes ? EDrawDebugTrace::Persistent : EDrawDebugTrace::ForOneFrame,
+            OutHit,
+            false);
+        return OutHit;
+    }
+
+    if (ShouldRewindClimbQuery())
+        return ClimbRewind->LineTraceSingleAtTime(Start, End, ClimbObjectQueryParams, GetClimbTraceQueryParams(), ClimbRewindTime, CharacterOwner->GetMovementBase());
+
+    GetWorld()->LineTraceSingleByObjectType(OutHit, Start, End, ClimbObjectQueryParams, GetClimbTraceQueryParams());
 
     return OutHit;
 }
@@ -170,17 +716,29 @@ void UCustomMovementComponent::ToggleClimbing(bool bAttemptClimbing)
 {
     if (bAttemptClimbing)
     {
-        if (CanStartClimbing())
+        if (IsFalling())
         {
-            PlayClimbMontage(IdleToClimbMontage);
+            if (TryStartSplineClimbing())
+            {
+                SendClimbStartToServer(EClimbStartAction::ClimbSpline);
+            }
+            else if (TryStartHanging())
+            {
+                SendClimbStartToServer(EClimbStartAction::Hang);
+            }
         }
-        else if (CanClimbDownLedge())
+        else if (IsContextualActionCacheValid())
         {
-            PlayClimbMontage(ClimbDownLedgeMontage);
+            // Evaluated in the background, the press itself runs no queries
+            INC_DWORD_STAT(STAT_ClimbPressesFromContextualAction);
+            StartContextualAction(ContextualAction.Action, ContextualAction.VaultStartPosition, ContextualAction.VaultLandPosition);
         }
         else
         {
-            TryStartVaulting();
+            FVector VaultStartPosition;
+            FVector VaultLandPosition;
+            const EClimbContextualAction Action = EvaluateContextualAction(true, VaultStartPosition, VaultLandPosition);
+            StartContextualAction(Action, VaultStartPosition, VaultLandPosition);
         }
     }
 
@@ -190,25 +748,12 @@ void UCustomMovementComponent::ToggleClimbing(bool bAttemptClimbing)
     }
 }
 
-void UCustomMovementComponent::TryStartVaulting()
-{
-    FVector VaultStartPosition;
-    FVector VaultLandPosition;
-
-    if (CanStartVaulting(VaultStartPosition, VaultLandPosition))
-    {
-        SetMotionWarpTarget(FName("VaultStartPoint"), VaultStartPosition);
-        SetMotionWarpTarget(FName("VaultEndPoint"), VaultLandPosition);
-
-        StartClimbing();
-        PlayClimbMontage(VaultMontage);
-    }
-}
-
 bool UCustomMovementComponent::CanStartVaulting(FVector &OutVaultStartPosition, FVector &OutVaultLandPosition)
 {
     if (IsFalling())
         return false;
+    if (!AcquireClimbQueries(ClimbSurfaceRules::VaultTraceCount, GetWorld()->GetTimeSeconds()))
+        return false;
 
     OutVaultStartPosition = FVector::ZeroVector;
     OutVaultLandPosition = FVector::ZeroVector;
@@ -218,12 +763,12 @@ bool UCustomMovementComponent::CanStartVaulting(FVector &OutVaultStartPosition,
     const FVector UpVector = UpdatedComponent->GetUpVector();
     const FVector DownVector = -UpdatedComponent->GetUpVector();
 
-    for (int32 i = 0; i < 5; i++)
+    for (int32 i = 0; i < ClimbSurfaceRules::VaultTraceCount; i++)
     {
-        const FVector Start = ComponentLocation + UpVector * 100.f +
-                              ComponentForward * 100.f * (i + 1);
+        const FVector Start = ComponentLocation + UpVector * ClimbSurfaceRules::VaultTraceHeight +
+                              ComponentForward * ClimbSurfaceRules::VaultTraceStep * (i + 1);
 
-        const FVector End = Start + DownVector * 100.f * (i + 1);
+        const FVector End = Start + DownVector * ClimbSurfaceRules::VaultTraceStep * (i + 1);
 
         FHitResult VaultTraceHit = DoLineTraceSingleByObject(Start, End);
 
@@ -252,18 +797,20 @@ bool UCustomMovementComponent::CanClimbDownLedge()
 {
     if (IsFalling())
         return false;
+    if (!AcquireClimbQueries(2, GetWorld()->GetTimeSeconds()))
+        return false;
 
     const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
     const FVector ComponentForward = UpdatedComponent->GetForwardVector();
     const FVector DownVector = -UpdatedComponent->GetUpVector();
 
     const FVector WalkableSurfaceTraceStart = ComponentLocation + ComponentForward * ClimbDownWalkableSurfaceTraceOffset;
-    const FVector WalkableSurfaceTraceEnd = WalkableSurfaceTraceStart + DownVector * 100.f;
+    const FVector WalkableSurfaceTraceEnd = WalkableSurfaceTraceStart + DownVector * ClimbSurfaceRules::ClimbDownWalkableTraceDepth;
 
-    FHitResult WalkableSurfaceHit = DoLineTraceSingleByObject(WalkableSurfaceTraceStart, WalkableSurfaceTraceEnd, true);
+    FHitResult WalkableSurfaceHit = DoLineTraceSingleByObject(WalkableSurfaceTraceStart, WalkableSurfaceTraceEnd);
 
     const FVector LedgeTraceStart = WalkableSurfaceHit.TraceStart + ComponentForward * ClimbDownLedgeTraceOffset;
-    const FVector LedgeTraceEnd = LedgeTraceStart + DownVector * 300.f;
+    const FVector LedgeTraceEnd = LedgeTraceStart + DownVector * ClimbSurfaceRules::ClimbDownLedgeTraceDepth;
 
     FHitResult LedgeTraceHit = DoLineTraceSingleByObject(LedgeTraceStart, LedgeTraceEnd);
 
@@ -279,12 +826,22 @@ bool UCustomMovementComponent::CanStartClimbing()
 {
     if (IsFalling())
         return false;
-    ClimbableSurfacesTracedResults = GetClimbableSurfaces();
-    if (ClimbableSurfacesTracedResults.IsEmpty())
+    if (!AcquireClimbQueries(2, GetWorld()->GetTimeSeconds()))
+        return false;
+    if (GetClimbableSurfaces().IsEmpty())
+        return false;
+    if (!TraceFromEyeHeight(ClimbSurfaceRules::EyeHeightTraceDistance).bBlockingHit)
         return false;
-    if (!TraceFromEyeHeight(100.f).bBlockingHit)
+
+    return true;
+}
+
+bool UCustomMovementComponent::TryStartClimbingImmediately()
+{
+    if (GetClimbableSurfaces().IsEmpty())
         return false;
 
+    StartClimbing();
     return true;
 }
 
@@ -295,7 +852,7 @@ void UCustomMovementComponent::StartClimbing()
 
 void UCustomMovementComponent::StopClimbing()
 {
-    if (IsClimbing())
+    if (IsClimbing() || IsHanging() || IsClimbingSpline())
     {
         SetMovementMode(MOVE_Falling);
     }
@@ -307,19 +864,21 @@ void UCustomMovementComponent::StopClimbing()
 
 bool UCustomMovementComponent::CheckHasReachedLedge()
 {
-    FHitResult LedgetHitResult = TraceFromEyeHeight(100.f, 50.f);
+    CLIMB_ALLOC_AUDIT_SCOPE(CheckHasReachedLedge);
+
+    FHitResult LedgetHitResult = TraceFromEyeHeight(ClimbSurfaceRules::EyeHeightTraceDistance, ClimbSurfaceRules::LedgeTraceStartOffset);
 
     if (!LedgetHitResult.bBlockingHit)
     {
         const FVector WalkableSurfaceTraceStart = LedgetHitResult.TraceEnd;
 
         const FVector DownVector = -UpdatedComponent->GetUpVector();
-        const FVector WalkableSurfaceTraceEnd = WalkableSurfaceTraceStart + DownVector * 100.f;
+        const FVector WalkableSurfaceTraceEnd = WalkableSurfaceTraceStart + DownVector * ClimbSurfaceRules::LedgeWalkableTraceDepth;
 
         FHitResult WalkabkeSurfaceHitResult =
             DoLineTraceSingleByObject(WalkableSurfaceTraceStart, WalkableSurfaceTraceEnd);
 
-        if (WalkabkeSurfaceHitResult.bBlockingHit && GetUnrotatedClimbVelocity().Z > 10.f)
+        if (WalkabkeSurfaceHitResult.bBlockingHit && GetUnrotatedClimbVelocity().Z > ClimbSurfaceRules::MinClimbUpLedgeSpeed)
         {
             return true;
         }
@@ -333,17 +892,64 @@ bool UCustomMovementComponent::IsClimbing() const
     return MovementMode == MOVE_Custom && CustomMovementMode == ECustomMovementMode::MOVE_Climb;
 }
 
+bool UCustomMovementComponent::IsHanging() const
+{
+    return MovementMode == MOVE_Custom && CustomMovementMode == ECustomMovementMode::MOVE_Hang;
+}
+
+bool UCustomMovementComponent::IsClimbingSpline() const
+{
+    return MovementMode == MOVE_Custom && CustomMovementMode == ECustomMovementMode::MOVE_SplineClimb;
+}
+
+bool UCustomMovementComponent::IsClimbActionPlaying() const
+{
+    // Cleared when the action's transition runs, the montage may still be blending out after that
+    return ActiveClimbActionMontage != nullptr;
+}
+
+EClimbPhase UCustomMovementComponent::GetClimbPhase() const
+{
+    if (IsClimbActionPlaying())
+        return EClimbPhase::Traversal;
+
+    if (IsClimbing() || IsClimbingSpline())
+        return Velocity.IsNearlyZero(1.f) ? EClimbPhase::ClimbingIdle : EClimbPhase::ClimbingMoving;
+
+    if (IsHanging())
+        return EClimbPhase::Hanging;
+
+    return IsFalling() ? EClimbPhase::Falling : EClimbPhase::Grounded;
+}
+
 void UCustomMovementComponent::PhysClimb(float deltaTime, int32 Iterations)
 {
+    CLIMB_ALLOC_AUDIT_SCOPE(PhysClimb);
+    SCOPE_CYCLE_COUNTER(STAT_ClimbPhys);
+
     if (deltaTime < MIN_TICK_TIME)
     {
         return;
     }
 
-    GetClimbableSurfaces();
-    ProcessClimbableSurfaceInfo();
+    // Physics thread results submitted before this game thread move would pull the climber back
+    LastAppliedAsyncClimbSerial = LastSubmittedAsyncClimbSerial;
+
+    // Turning a corner follows the plane pair it started from, without the floor and ledge checks
+    if (ClimbCornerTransition.IsActive() || TryStartClimbCornerTransition())
+    {
+        PhysClimbCorner(deltaTime);
+        return;
+    }
+
+    // The floor and ledge checks wait for query budget, their answer rarely changes from one frame to the next
+    const bool bRunStepQueries = AcquireClimbQueries(3, LastClimbStepQueryTime);
+    if (bRunStepQueries)
+    {
+        LastClimbStepQueryTime = GetWorld()->GetTimeSeconds();
+    }
 
-    if (ShouldStopClimbing() || CheckHasReachedFloor())
+    if (ShouldStopClimbing() || (bRunStepQueries && CheckHasReachedFloor()))
     {
         StopClimbing();
     }
@@ -378,55 +984,66 @@ void UCustomMovementComponent::PhysClimb(float deltaTime, int32 Iterations)
 
     SnapMovementToClimbableSurfaces(deltaTime);
 
-    if (CheckHasReachedLedge())
+    if (TryEnterClimbSplineFromWall())
+        return;
+
+    const bool bRemoteClimber = IsServerForRemoteClimber();
+
+    if ((bHangBeforeClimbingUp || !bRemoteClimber) && bRunStepQueries && CheckHasReachedLedge())
     {
+        PostClimbEvent(EClimbEventType::LedgeReached);
+
+        if (bHangBeforeClimbingUp && TryStartHanging())
+            return;
+
+        // A remote client reports climbing up the ledge itself, the server only validates that
+        if (bRemoteClimber)
+            return;
+
         PlayClimbMontage(ClimbToTopMontage);
+        SendClimbStartToServer(EClimbStartAction::ClimbUpLedge);
     }
 }
 
 void UCustomMovementComponent::ProcessClimbableSurfaceInfo()
 {
-    CurrentClimbableSurfaceLocation = FVector::ZeroVector;
-    CurrentClimbableSurfaceNormal = FVector::ZeroVector;
+    // Averaging both faces of a corner gives a diagonal normal, climb the face in front instead
+    if (ClimbContacts.FitCorner(ClimbCorner, ClimbCornerMinAngle) &&
+        ClimbSurfaceRules::IsClimbableSurfaceNormal(ClimbCorner.Normals[0]) &&
+        ClimbSurfaceRules::IsClimbableSurfaceNormal(ClimbCorner.Normals[1]))
+    {
+        const int32 Facing = ClimbCorner.GetFacingPlane(UpdatedComponent->GetForwardVector());
 
-    if (ClimbableSurfacesTracedResults.IsEmpty())
+        CurrentClimbableSurfaceLocation = ClimbCorner.Points[Facing];
+        CurrentClimbableSurfaceNormal = ClimbCorner.Normals[Facing];
         return;
-
-    for (const FHitResult &TracedHitResult : ClimbableSurfacesTracedResults)
-    {
-        CurrentClimbableSurfaceLocation += TracedHitResult.ImpactPoint;
-        CurrentClimbableSurfaceNormal += TracedHitResult.ImpactNormal;
     }
 
-    CurrentClimbableSurfaceLocation /= ClimbableSurfacesTracedResults.Num();
-    CurrentClimbableSurfaceNormal = CurrentClimbableSurfaceNormal.GetSafeNormal();
+    ClimbCorner.Reset();
+    CurrentClimbableSurfaceLocation = ClimbContacts.GetAverageLocation();
+    CurrentClimbableSurfaceNormal = ClimbContacts.GetAverageNormal();
 }
 
 bool UCustomMovementComponent::ShouldStopClimbing()
 {
-    if (ClimbableSurfacesTracedResults.IsEmpty())
-        return true;
-
-    const float DotResult = FVector::DotProduct(CurrentClimbableSurfaceNormal, FVector::UpVector);
-    const float DegreeDiff = FMath::RadiansToDegrees(FMath::Acos(DotResult));
-
-    if (DegreeDiff <= 60.f)
-    {
+    if (ClimbContacts.IsEmpty())
         return true;
-    }
 
-    return false;
+    return !ClimbSurfaceRules::IsClimbableSurfaceNormal(CurrentClimbableSurfaceNormal);
 }
 
 bool UCustomMovementComponent::CheckHasReachedFloor()
 {
+    CLIMB_ALLOC_AUDIT_SCOPE(CheckHasReachedFloor);
+
     const FVector DownVector = -UpdatedComponent->GetUpVector();
-    const FVector StartOffset = DownVector * 50.f;
+    const FVector StartOffset = DownVector * ClimbSurfaceRules::FloorTraceStartOffset;
 
     const FVector Start = UpdatedComponent->GetComponentLocation() + StartOffset;
     const FVector End = Start + DownVector;
 
-    TArray<FHitResult> PossibleFloorHits = DoCapsuleTraceMultiByObject(Start, End);
+    TArray<FHitResult> &PossibleFloorHits = GetClimbSweepScratchHits();
+    DoCapsuleTraceMultiByObject(Start, End, PossibleFloorHits);
 
     if (PossibleFloorHits.IsEmpty())
         return false;
@@ -434,8 +1051,8 @@ bool UCustomMovementComponent::CheckHasReachedFloor()
     for (const FHitResult &PossibleFloorHit : PossibleFloorHits)
     {
         const bool bFloorReached =
-            FVector::Parallel(-PossibleFloorHit.ImpactNormal, FVector::UpVector) &&
-            GetUnrotatedClimbVelocity().Z < -10.f;
+            ClimbSurfaceRules::IsFloorSurfaceNormal(PossibleFloorHit.ImpactNormal) &&
+            GetUnrotatedClimbVelocity().Z < -ClimbSurfaceRules::MinReachFloorSpeed;
 
         if (bFloorReached)
         {
@@ -462,13 +1079,27 @@ FQuat UCustomMovementComponent::GetClimbRotation(float DeltaTime)
 
 void UCustomMovementComponent::SnapMovementToClimbableSurfaces(float DeltaTime)
 {
+    // The snap is a sweep too, over the query budget the climber holds its distance to the wall for a step
+    if (!AcquireClimbQueries(1, LastClimbSnapQueryTime))
+        return;
+
+    LastClimbSnapQueryTime = GetWorld()->GetTimeSeconds();
+
     const FVector ComponentForward = UpdatedComponent->GetForwardVector();
     const FVector ComponentLocation = UpdatedComponent->GetComponentLocation();
 
+    // The distance field answers for where the climber is after this step's move, not where it was probed
+    FVector SurfaceLocation = CurrentClimbableSurfaceLocation;
+    FVector SurfaceNormal = CurrentClimbableSurfaceNormal;
+    if (!ClimbCorner.IsCorner())
+    {
+        SampleClimbDistanceField(SurfaceLocation, SurfaceNormal);
+    }
+
     const FVector ProjectedCharacterToSurface =
-        (CurrentClimbableSurfaceLocation - ComponentLocation).ProjectOnTo(ComponentForward);
+        (SurfaceLocation - ComponentLocation).ProjectOnTo(ComponentForward);
 
-    const FVector SnapVector = -CurrentClimbableSurfaceNormal * ProjectedCharacterToSurface.Length();
+    const FVector SnapVector = -SurfaceNormal * ProjectedCharacterToSurface.Length();
 
     UpdatedComponent->MoveComponent(
         SnapVector * DeltaTime * MaxClimbSpeed,
@@ -476,13 +1107,41 @@ void UCustomMovementComponent::SnapMovementToClimbableSurfaces(float DeltaTime)
         true);
 }
 
-TArray<FHitResult> UCustomMovementComponent::GetClimbableSurfaces()
+const FClimbContactManifold &UCustomMovementComponent::GetClimbableSurfaces()
 {
-    const FVector &StartOffset = UpdatedComponent->GetForwardVector() * 30.f;
+    CLIMB_ALLOC_AUDIT_SCOPE(GetClimbableSurfaces);
+
+    const FVector &StartOffset = UpdatedComponent->GetForwardVector() * ClimbSurfaceRules::SurfaceSweepForwardOffset;
     const FVector &Start = UpdatedComponent->GetComponentLocation() + StartOffset;
     const FVector &End = Start + UpdatedComponent->GetForwardVector();
-    ClimbableSurfacesTracedResults = DoCapsuleTraceMultiByObject(Start, End);
-    return ClimbableSurfacesTracedResults;
+
+    TArray<FHitResult> &SweepHits = GetClimbSweepScratchHits();
+    DoCapsuleTraceMultiByObject(Start, End, SweepHits);
+
+    LastClimbSweepHitCount = SweepHits.Num();
+    ClimbContacts.Update(SweepHits, UpdatedComponent->GetComponentLocation(), UpdatedComponent->GetForwardVector());
+
+    ClimbContactBase = nullptr;
+    if (!ClimbContacts.IsEmpty())
+    {
+        for (const FHitResult &Hit : SweepHits)
+        {
+            if (Hit.GetComponent() && Hit.GetComponent()->GetUniqueID() == ClimbContacts.PrimitiveIds[0])
+            {
+                ClimbContactBase = Hit.GetComponent();
+                break;
+            }
+        }
+    }
+
+    if (const UPrimitiveComponent *Base = ClimbContactBase.Get())
+    {
+        const FTransform &BaseTransform = Base->GetComponentTransform();
+        ClimbContacts.StoreLocalSpace(BaseTransform);
+        ClimbSweepRelativeTransform = UpdatedComponent->GetComponentTransform().GetRelativeTransform(BaseTransform);
+    }
+
+    return ClimbContacts;
 }
 
 FHitResult UCustomMovementComponent::TraceFromEyeHeight(float TraceDistance, float TraceStartOffset, bool bShowDebugShape, bool bDrawPersistantShapes)
@@ -497,18 +1156,107 @@ FHitResult UCustomMovementComponent::TraceFromEyeHeight(float TraceDistance, flo
 
 void UCustomMovementComponent::PlayClimbMontage(UAnimMontage *MontageToPlay)
 {
+    CLIMB_ALLOC_AUDIT_SCOPE(PlayClimbMontage);
+
     if (!MontageToPlay)
         return;
+    if (IsClimbActionPlaying())
+        return;
+
+    if (ShouldUseProceduralRootMotion())
+    {
+        // A montage without a path already ended its action, there is nothing left to show
+        if (!ApplyClimbRootMotionSource(MontageToPlay))
+            return;
+
+        if (OwningPlayerAnimInstance && CharacterOwner->GetMesh()->IsComponentTickEnabled())
+        {
+            OwningPlayerAnimInstance->Montage_Play(MontageToPlay);
+        }
+        return;
+    }
+
     if (!OwningPlayerAnimInstance)
         return;
-    if (OwningPlayerAnimInstance->IsAnyMontagePlaying())
+
+    if (OwningPlayerAnimInstance->Montage_Play(MontageToPlay) > 0.f)
+    {
+        BeginClimbAction(MontageToPlay);
+    }
+}
+
+bool UCustomMovementComponent::ShouldUseProceduralRootMotion() const
+{
+    // Every peer has to agree, a server on root motion sources and clients on montage root motion would correct every action
+    return bUseProceduralRootMotion;
+}
+
+const FClimbRootMotionBake &UCustomMovementComponent::GetClimbRootMotionBake(const UAnimMontage *Montage)
+{
+    static const FClimbRootMotionBake EmptyBake;
+
+    if (!Montage)
+        return EmptyBake;
+
+    if (const FClimbRootMotionBake *Bake = ClimbRootMotionBakes.Find(Montage))
+        return *Bake;
+
+    return ClimbRootMotionBakes.Add(Montage, FClimbRootMotionBake::Bake(*Montage, CharacterOwner->GetBaseRotationOffset()));
+}
+
+bool UCustomMovementComponent::ApplyClimbRootMotionSource(UAnimMontage *Montage)
+{
+    SCOPE_CYCLE_COUNTER(STAT_ClimbApplyRootMotionSource);
+
+    const FClimbRootMotionBake &Bake = GetClimbRootMotionBake(Montage);
+
+    if (!Bake.IsValid())
+    {
+        // Nothing to move along, finish the action right away so the state still advances
+        HandleClimbActionEnded(Montage);
+        return false;
+    }
+
+    TSharedPtr<FRootMotionSource_ClimbPath> ClimbPathSource = MakeShared<FRootMotionSource_ClimbPath>();
+    ClimbPathSource->InstanceName = Montage->GetFName();
+    ClimbPathSource->Initialize(*Montage, Bake, UpdatedComponent->GetComponentTransform(), ClimbWarpTargets);
+
+    ActiveClimbRootMotionSourceID = ApplyRootMotionSource(ClimbPathSource);
+    BeginClimbAction(Montage);
+    return true;
+}
+
+void UCustomMovementComponent::TickClimbRootMotionSource()
+{
+    if (!ActiveClimbActionMontage || ActiveClimbRootMotionSourceID == (uint16)ERootMotionSourceID::Invalid)
+        return;
+
+    // Finished sources are removed by the movement update, which is our cue to advance the climb state
+    if (GetRootMotionSourceByID(ActiveClimbRootMotionSourceID).IsValid())
         return;
 
-    OwningPlayerAnimInstance->Montage_Play(MontageToPlay);
+    FinishClimbAction(EClimbActionEndReason::Completed);
 }
 
 void UCustomMovementComponent::OnClimbMontageEnded(UAnimMontage *Montage, bool bInterrupted)
 {
+    // With procedural root motion the montage is cosmetic, the root motion source ending drives the state
+    if (ShouldUseProceduralRootMotion())
+        return;
+
+    // Bound to both blending out and ended, whichever comes first for the active action is its one transition
+    if (Montage != ActiveClimbActionMontage || EndedClimbMontage)
+        return;
+
+    // Called from inside the anim update, the movement mode change waits for the next movement tick
+    EndedClimbMontage = Montage;
+    bEndedClimbMontageInterrupted = bInterrupted;
+}
+
+void UCustomMovementComponent::HandleClimbActionEnded(UAnimMontage *Montage)
+{
+    ClimbWarpTargets.Reset();
+
     if (Montage == IdleToClimbMontage || Montage == ClimbDownLedgeMontage)
     {
         StartClimbing();
@@ -525,14 +1273,32 @@ void UCustomMovementComponent::RequestHopping()
     const FVector UnrotatedLastInputVector =
         UKismetMathLibrary::Quat_UnrotateVector(UpdatedComponent->GetComponentQuat(), GetLastInputVector());
 
-    const float DotResult =
-        FVector::DotProduct(UnrotatedLastInputVector.GetSafeNormal(), FVector::UpVector);
+    FClimbBufferedInput Input;
+    Input.PressFrame = GFrameCounter;
+    Input.PressTime = GetWorld()->GetTimeSeconds();
+    Input.VerticalInput = FVector::DotProduct(UnrotatedLastInputVector.GetSafeNormal(), FVector::UpVector);
+
+    ClimbInputBuffer.Press(EClimbInputAction::Hop, Input);
+    ProcessClimbInputBuffer();
+}
+
+void UCustomMovementComponent::ExecuteHop(float VerticalInput)
+{
+    // Ladders and pipes are climbed along their path only
+    if (IsClimbingSpline())
+        return;
+
+    if (IsHanging())
+    {
+        HandleHangHop(VerticalInput);
+        return;
+    }
 
-    if (DotResult >= 0.9f)
+    if (VerticalInput >= 0.9f)
     {
         HandleHopUp();
     }
-    else if (DotResult <= -0.9f)
+    else if (VerticalInput <= -0.9f)
     {
         HandleHopDown();
     }
@@ -540,6 +1306,10 @@ void UCustomMovementComponent::RequestHopping()
 
 void UCustomMovementComponent::SetMotionWarpTarget(const FName &InWarpTargetName, const FVector &InTargetPosition)
 {
+    CLIMB_ALLOC_AUDIT_SCOPE(SetMotionWarpTarget);
+
+    ClimbWarpTargets.Add(InWarpTargetName, InTargetPosition);
+
     if (!OwningPlayerCharacter)
         return;
 
@@ -562,6 +1332,9 @@ void UCustomMovementComponent::HandleHopUp()
 
 bool UCustomMovementComponent::CheckCanHopUp(FVector &OutHopUpTargetPosition)
 {
+    if (!AcquireClimbQueries(2, GetWorld()->GetTimeSeconds()))
+        return false;
+
     FHitResult HopUpHit = TraceFromEyeHeight(100.f, -10.f);
     FHitResult SaftyLedgeHit = TraceFromEyeHeight(100.f, 150.f);
 
@@ -589,6 +1362,9 @@ void UCustomMovementComponent::HandleHopDown()
 
 bool UCustomMovementComponent::CheckCanHopDown(FVector &OutHopDownTargetPosition)
 {
+    if (!AcquireClimbQueries(1, GetWorld()->GetTimeSeconds()))
+        return false;
+
     FHitResult HopDownHit = TraceFromEyeHeight(100.f, -300.f);
 
     if (HopDownHit.bBlockingHit)
@@ -606,3 +1382,1287 @@ FVector UCustomMovementComponent::GetUnrotatedClimbVelocity() const
     return UKismetMathLibrary::Quat_UnrotateVector(UpdatedComponent->GetComponentQuat(), Velocity);
 }
 #pragma endregion
+
+#pragma region Corners
+bool UCustomMovementComponent::TryStartClimbCornerTransition()
+{
+    if (!ClimbCorner.IsCorner() || IsClimbActionPlaying() || HasAnimRootMotion() || CurrentRootMotion.HasOverrideVelocity())
+        return false;
+
+    const int32 Facing = ClimbCorner.GetFacingPlane(UpdatedComponent->GetForwardVector());
+    const FVector &FromNormal = ClimbCorner.Normals[Facing];
+    const FVector &ToNormal = ClimbCorner.Normals[1 - Facing];
+    const bool bInner = ClimbCorner.Type == EClimbCornerType::Inner;
+
+    // Toward an outer edge the climber moves the way the other face looks, into an inner corner against it
+    const FVector MoveDirection = Acceleration.GetSafeNormal();
+    if (FVector::DotProduct(MoveDirection, bInner ? -ToNormal : ToNormal) < 0.5f)
+        return false;
+
+    const float NormalsDot = FVector::DotProduct(FromNormal, ToNormal);
+    if (bInner && NormalsDot < -0.9f)
+        return false;
+
+    const FVector Location = UpdatedComponent->GetComponentLocation();
+    const FVector EdgePoint = ClimbCorner.EdgePoint + ClimbCorner.EdgeDirection * FVector::DotProduct(Location - ClimbCorner.EdgePoint, ClimbCorner.EdgeDirection);
+    const float StandOff = FVector::DotProduct(Location - ClimbCorner.Points[Facing], FromNormal);
+
+    // Inner corners pivot where the climber is as far from both faces as from the first one
+    const FVector TurnStart = bInner
+        ? EdgePoint + (FromNormal + ToNormal) * StandOff / (1.f + NormalsDot)
+        : EdgePoint + FromNormal * StandOff;
+
+    if (StandOff <= 0.f || FVector::Dist(Location, TurnStart) > ClimbCornerTriggerDistance)
+        return false;
+
+    const float TurnAngle = FMath::Acos(FMath::Clamp(NormalsDot, -1.f, 1.f));
+    const float PathLength = FVector::Dist(Location, TurnStart) + (bInner ? 0.f : TurnAngle * StandOff);
+
+    const FTransform BaseTransform = GetClimbCornerBaseTransform();
+
+    ClimbCornerTransition.Type = ClimbCorner.Type;
+    ClimbCornerTransition.EdgePoint = BaseTransform.InverseTransformPosition(EdgePoint);
+    ClimbCornerTransition.FromNormal = BaseTransform.InverseTransformVector(FromNormal);
+    ClimbCornerTransition.ToNormal = BaseTransform.InverseTransformVector(ToNormal);
+    ClimbCornerTransition.StartLocation = BaseTransform.InverseTransformPosition(Location);
+    ClimbCornerTransition.TurnStart = BaseTransform.InverseTransformPosition(TurnStart);
+    ClimbCornerTransition.StandOff = StandOff;
+    ClimbCornerTransition.Alpha = 0.f;
+    ClimbCornerTransition.Duration = FMath::Max(PathLength / MaxClimbSpeed, ClimbCornerMinTurnTime);
+
+    INC_DWORD_STAT(STAT_ClimbCornerTransitions);
+    PostClimbEvent(EClimbEventType::CornerStarted);
+    return true;
+}
+
+void UCustomMovementComponent::PhysClimbCorner(float deltaTime)
+{
+    CLIMB_ALLOC_AUDIT_SCOPE(PhysClimbCorner);
+
+    FClimbCornerTransition &Turn = ClimbCornerTransition;
+    Turn.Alpha = FMath::Min(Turn.Alpha + deltaTime / Turn.Duration, 1.f);
+
+    const FQuat NormalRotation = FQuat::Slerp(FQuat::Identity, FQuat::FindBetweenNormals(Turn.FromNormal, Turn.ToNormal), Turn.Alpha);
+    const FVector Normal = NormalRotation.RotateVector(Turn.FromNormal);
+
+    // Wrapping orbits the edge while the offset to the turn start fades out, an inner corner turns on the spot
+    const FVector Location = Turn.Type == EClimbCornerType::Inner
+        ? FMath::Lerp(Turn.StartLocation, Turn.TurnStart, Turn.Alpha)
+        : Turn.EdgePoint + Normal * Turn.StandOff + (Turn.StartLocation - Turn.TurnStart) * (1.f - Turn.Alpha);
+
+    const FTransform BaseTransform = GetClimbCornerBaseTransform();
+    const FVector WorldNormal = BaseTransform.TransformVector(Normal);
+    const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+
+    FHitResult Hit(1.f);
+    SafeMoveUpdatedComponent(BaseTransform.TransformPosition(Location) - OldLocation, FRotationMatrix::MakeFromX(-WorldNormal).ToQuat(), true, Hit);
+
+    Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / deltaTime;
+    CurrentClimbableSurfaceNormal = WorldNormal;
+    CurrentClimbableSurfaceLocation = UpdatedComponent->GetComponentLocation() - WorldNormal * Turn.StandOff;
+
+    // Done or blocked, the next probe sweeps again from the face the climber ended up on
+    if (Turn.Alpha >= 1.f || Hit.Time < 1.f)
+    {
+        ClimbCornerTransition = FClimbCornerTransition();
+        ClimbCorner.Reset();
+        ClimbContacts.Reset();
+    }
+}
+
+FTransform UCustomMovementComponent::GetClimbCornerBaseTransform() const
+{
+    const UPrimitiveComponent *Base = ClimbContactBase.Get();
+    if (!Base)
+        return FTransform::Identity;
+
+    // Rigid, so the stand off and the turn keep their size on a scaled primitive
+    FTransform BaseTransform = Base->GetComponentTransform();
+    BaseTransform.RemoveScaling();
+    return BaseTransform;
+}
+#pragma endregion
+
+#pragma region HangCore
+bool UCustomMovementComponent::TryStartHanging(bool bSpeculative)
+{
+    // The wall, the ledge top, the clearance above it and the walk along the edge to each side
+    if (!AcquireClimbQueries(3 + 2 * HangFitSamples, GetWorld()->GetTimeSeconds(), bSpeculative))
+        return false;
+
+    FClimbLedgeSegment Ledge;
+    if (!FitLedgeSegment(Ledge))
+        return false;
+
+    StartHanging(Ledge);
+    return true;
+}
+
+void UCustomMovementComponent::StartHanging(const FClimbLedgeSegment &Ledge)
+{
+    HangLedge = Ledge;
+    HangDistance = FMath::Clamp(HangLedge.GetDistanceAlong(UpdatedComponent->GetComponentLocation()), 0.f, HangLedge.GetLength());
+    HangBlockedSign = 0.f;
+    bHangLedgeLost = false;
+
+    StopMovementImmediately();
+    SetMovementMode(MOVE_Custom, ECustomMovementMode::MOVE_Hang);
+}
+
+bool UCustomMovementComponent::FitLedgeSegment(FClimbLedgeSegment &OutLedge)
+{
+    const FHitResult WallHit = TraceFromEyeHeight(ClimbSurfaceRules::EyeHeightTraceDistance);
+
+    if (!WallHit.bBlockingHit || !ClimbSurfaceRules::IsClimbableSurfaceNormal(WallHit.ImpactNormal))
+        return false;
+
+    const FVector WallNormal = FVector(WallHit.ImpactNormal.X, WallHit.ImpactNormal.Y, 0.f).GetSafeNormal();
+    const FVector Right = FVector::CrossProduct(WallNormal, FVector::UpVector);
+
+    FVector Center;
+    if (!TraceLedgeTop(WallHit.ImpactPoint, WallNormal, HangLedgeSearchHeight, HangLedgeSearchHeight, Center))
+        return false;
+
+    // The top trace may have started inside the wall, make sure there is open space above the ledge
+    const FVector ClearanceStart = Center + WallNormal * HangWallOffset + FVector::UpVector * HangLedgeHeightTolerance;
+    if (DoLineTraceSingleByObject(ClearanceStart, ClearanceStart - WallNormal * (HangWallOffset + HangLedgeInset)).bBlockingHit)
+        return false;
+
+    // Follow the edge to each side once, the hang itself only validates one point per tick
+    FVector Endpoints[2] = {Center, Center};
+
+    for (int32 Side = 0; Side < 2; ++Side)
+    {
+        const FVector Step = Right * (Side == 0 ? -HangFitStep : HangFitStep);
+
+        for (int32 i = 0; i < HangFitSamples; ++i)
+        {
+            FVector LedgeTop;
+            if (!TraceLedgeTop(Endpoints[Side] + Step, WallNormal, HangLedgeHeightTolerance, HangLedgeHeightTolerance, LedgeTop))
+                break;
+
+            Endpoints[Side] = LedgeTop;
+        }
+    }
+
+    OutLedge.WallNormal = WallNormal;
+    OutLedge.SetEndpoints(Endpoints[0], Endpoints[1], Right);
+    return true;
+}
+
+bool UCustomMovementComponent::TraceLedgeTop(const FVector &EdgePoint, const FVector &WallNormal, float SearchAbove, float SearchBelow, FVector &OutLedgeTop)
+{
+    const FVector Start = EdgePoint - WallNormal * HangLedgeInset + FVector::UpVector * SearchAbove;
+    const FVector End = Start - FVector::UpVector * (SearchAbove + SearchBelow);
+
+    const FHitResult TopHit = DoLineTraceSingleByObject(Start, End);
+
+    if (!TopHit.bBlockingHit || TopHit.bStartPenetrating || !IsWalkable(TopHit))
+        return false;
+
+    OutLedgeTop = FVector(EdgePoint.X, EdgePoint.Y, TopHit.ImpactPoint.Z);
+    return true;
+}
+
+void UCustomMovementComponent::ProbeHangLedge()
+{
+    if (!HangLedge.IsValid() || HasAnimRootMotion() || CurrentRootMotion.HasOverrideVelocity())
+        return;
+
+    // Over the query budget the hang keeps the last probe's answer
+    if (!AcquireClimbQueries(1, LastHangLedgeQueryTime))
+        return;
+
+    LastHangLedgeQueryTime = GetWorld()->GetTimeSeconds();
+
+    // Validate where the hands are heading, or where they are when holding still
+    const float MoveSign = FMath::Sign(FVector::DotProduct(Velocity, HangLedge.GetDirection()));
+    const float ProbeDistance = HangDistance + MoveSign * HangLedgeLookAhead;
+    const FVector EdgePoint = HangLedge.GetPointAtDistance(ProbeDistance);
+
+    FVector LedgeTop;
+    const bool bFoundLedge = TraceLedgeTop(EdgePoint, HangLedge.WallNormal, HangLedgeHeightTolerance, HangLedgeHeightTolerance, LedgeTop);
+
+    HangBlockedSign = 0.f;
+    bHangLedgeLost = false;
+
+    if (!bFoundLedge)
+    {
+        if (MoveSign == 0.f)
+        {
+            bHangLedgeLost = true;
+        }
+        else
+        {
+            HangBlockedSign = MoveSign;
+        }
+        return;
+    }
+
+    // Found ledge past a known end, grow the segment instead of refitting it
+    if (ProbeDistance > HangLedge.GetLength())
+    {
+        HangLedge.SetEndpoints(HangLedge.Start, LedgeTop, HangLedge.GetDirection());
+    }
+    else if (ProbeDistance < 0.f)
+    {
+        HangLedge.SetEndpoints(LedgeTop, HangLedge.End, HangLedge.GetDirection());
+        HangDistance -= ProbeDistance;
+    }
+}
+
+void UCustomMovementComponent::PhysHang(float deltaTime, int32 Iterations)
+{
+    CLIMB_ALLOC_AUDIT_SCOPE(PhysHang);
+
+    if (deltaTime < MIN_TICK_TIME)
+    {
+        return;
+    }
+
+    if (bHangLedgeLost)
+    {
+        StopClimbing();
+        return;
+    }
+
+    RestorePreAdditiveRootMotionVelocity();
+
+    // Climbing up onto the ledge, root motion owns the movement
+    if (HasAnimRootMotion() || CurrentRootMotion.HasOverrideVelocity())
+    {
+        ApplyRootMotionToVelocity(deltaTime);
+
+        FHitResult Hit(1.f);
+        SafeMoveUpdatedComponent(Velocity * deltaTime, UpdatedComponent->GetComponentQuat(), true, Hit);
+        return;
+    }
+
+    CalcVelocity(deltaTime, 0.f, true, MaxBreakClimbDeceleration);
+
+    float ShimmySpeed = FVector::DotProduct(Velocity, HangLedge.GetDirection());
+    if (HangBlockedSign != 0.f && FMath::Sign(ShimmySpeed) == HangBlockedSign)
+    {
+        ShimmySpeed = 0.f;
+    }
+
+    const float LedgeLength = HangLedge.GetLength();
+    const float Margin = FMath::Min(HangEdgeMargin, LedgeLength * 0.5f);
+    const float TargetDistance = FMath::Clamp(HangDistance + ShimmySpeed * deltaTime, Margin, LedgeLength - Margin);
+
+    const FVector OldLocation = UpdatedComponent->GetComponentLocation();
+    const FQuat TargetQuat = FRotationMatrix::MakeFromX(-HangLedge.WallNormal).ToQuat();
+
+    FHitResult Hit(1.f);
+    SafeMoveUpdatedComponent(
+        GetHangLocationAtDistance(TargetDistance) - OldLocation,
+        FMath::QInterpTo(UpdatedComponent->GetComponentQuat(), TargetQuat, deltaTime, 5.f),
+        true,
+        Hit);
+
+    HangDistance = FMath::Lerp(HangDistance, TargetDistance, Hit.Time);
+    Velocity = (UpdatedComponent->GetComponentLocation() - OldLocation) / deltaTime;
+
+    // Keeps climb movement input and the climb up/down checks working off the ledge
+    CurrentClimbableSurfaceNormal = HangLedge.WallNormal;
+    CurrentClimbableSurfaceLocation = HangLedge.GetPointAtDistance(HangDistance);
+}
+
+FVector UCustomMovementComponent::GetHangLocationAtDistance(float Distance) const
+{
+    return HangLedge.GetPointAtDistance(Distance) +
+           HangLedge.WallNormal * HangWallOffset -
+           FVector::UpVector * HangHeightBelowLedge;
+}
+
+void UCustomMovementComponent::HandleHangHop(float VerticalInput)
+{
+    if (VerticalInput >= 0.9f)
+    {
+        PlayClimbMontage(ClimbToTopMontage);
+    }
+    else if (VerticalInput <= -0.9f)
+    {
+        // Climb down onto the wall below the ledge, or let go when there is nothing to hold
+        if (!GetClimbableSurfaces().IsEmpty())
+        {
+            StartClimbing();
+        }
+        else
+        {
+            StopClimbing();
+        }
+    }
+}
+#pragma endregion
+
+#pragma region SplineClimb
+UClimbSplineComponent *UCustomMovementComponent::FindClimbSplineEntry(float &OutDistance) const
+{
+    return ClimbSplines ? ClimbSplines->FindEntry(UpdatedComponent->GetComponentLocation(), OutDistance) : nullptr;
+}
+
+bool UCustomMovementComponent::TryStartSplineClimbing()
+{
+    float Distance;
+    UClimbSplineComponent *Spline = FindClimbSplineEntry(Distance);
+    if (!Spline)
+        return false;
+
+    StartSplineClimbing(*Spline, Distance);
+    return true;
+}
+
+bool UCustomMovementComponent::TryEnterClimbSplineFromWall()
+{
+    if (!ClimbSplines || IsClimbActionPlaying())
+        return false;
+
+    // Only climbing toward a wall climb end of a spline moves onto it, so handing off to the wall does not come straight back
+    float Distance;
+    UClimbSplineComponent *Spline = ClimbSplines->FindWallClimbEntry(UpdatedComponent->GetComponentLocation(), Velocity, Distance);
+    if (!Spline)
+        return false;
+
+    StartSplineClimbing(*Spline, Distance);
+    return true;
+}
+
+void UCustomMovementComponent::StartSplineClimbing(UClimbSplineComponent &Spline, float Distance)
+{
+    ClimbSpline = &Spline;
+    SplineClimbDistance = Distance;
+    SplineEntryOffset = UpdatedComponent->GetComponentLocation() - Spline.GetClimberTransformAtDistance(Distance).GetLocation();
+
+    SetMovementMode(MOVE_Custom, ECustomMovementMode::MOVE_SplineClimb);
+
+    // Based movement carries the climber with a moving ladder and replicates it relative to it
+    SetBase(&Spline);
+}
+
+void UCustomMovementComponent::PhysSplineClimb(float deltaTime, int32 Iterations)
+{
+    CLIMB_ALLOC_AUDIT_SCOPE(PhysSplineClimb);
+    SCOPE_CYCLE_COUNTER(STAT_ClimbSplinePhys);
+
+    if (deltaTime < MIN_TICK_TIME)
+    {
+        return;
+    }
+
+    UClimbSplineComponent *Spline = ClimbSpline.Get();
+
+    // A server correction can put the climber on a spline this peer never entered, pick it up where the correction left it
+    if (!Spline)
+    {
+        float Distance;
+        Spline = FindClimbSplineEntry(Distance);
+
+        if (Spline)
+        {
+            ClimbSpline = Spline;
+            SplineClimbDistance = Distance;
+            SplineEntryOffset = FVector::ZeroVector;
+            SetBase(Spline);
+        }
+    }
+
+    if (!Spline || !Spline->HasClimbFrames())
+    {
+        StopClimbing();
+        return;
+    }
+
+    // Saved moves and corrections only carry the location, so both peers recover the path distance from it every tick
+    SplineClimbDistance = Spline->FindNearestDistance(UpdatedComponent->GetComponentLocation() - SplineEntryOffset, SplineClimbDistance);
+
+    CalcVelocity(deltaTime, 0.f, true, MaxBreakClimbDeceleration);
+
+    const FVector InputAxis = Spline->GetInputAxisAtDistance(SplineClimbDistance);
+    const float PathSpeed = FVector::DotProduct(Velocity, InputAxis);
+    const float TargetDistance = SplineClimbDistance + PathSpeed * deltaTime;
+
+    if (TargetDistance < 0.f || TargetDistance > Spline->GetPathLength())
+    {
+        LeaveClimbSpline(TargetDistance > 0.f);
+        return;
+    }
+
+    SplineClimbDistance = TargetDistance;
+    SplineEntryOffset = FMath::VInterpTo(SplineEntryOffset, FVector::ZeroVector, deltaTime, SplineEntryInterpSpeed);
+
+    const FTransform Target = Spline->GetClimberTransformAtDistance(SplineClimbDistance);
+    const FQuat TargetQuat = FMath::QInterpTo(UpdatedComponent->GetComponentQuat(), Target.GetRotation(), deltaTime, SplineEntryInterpSpeed);
+
+    // The path is authored clear of geometry, the sweep catches what moved onto it since, and holds the climber there
+    const FVector Delta = Target.GetLocation() + SplineEntryOffset - UpdatedComponent->GetComponentLocation();
+    FHitResult Hit(1.f);
+    SafeMoveUpdatedComponent(Delta, TargetQuat, true, Hit);
+
+    if (Hit.IsValidBlockingHit())
+    {
+        HandleImpact(Hit, deltaTime, Delta);
+        Velocity = FVector::ZeroVector;
+    }
+    else
+    {
+        Velocity = InputAxis * PathSpeed;
+    }
+
+    // Keeps climb movement input working on the path
+    CurrentClimbableSurfaceNormal = -Target.GetRotation().GetForwardVector();
+    CurrentClimbableSurfaceLocation = Target.GetLocation() - CurrentClimbableSurfaceNormal * Spline->GetClimberOffset();
+}
+
+void UCustomMovementComponent::LeaveClimbSpline(bool bTop)
+{
+    const UClimbSplineComponent *Spline = ClimbSpline.Get();
+    if (!Spline)
+    {
+        StopClimbing();
+        return;
+    }
+
+    switch (Spline->GetExit(bTop))
+    {
+    case EClimbSplineExit::Release:
+        SetMovementMode(MOVE_Falling);
+        break;
+
+    case EClimbSplineExit::StepOff:
+        // The step-off segment ended on the floor
+        SetMovementMode(MOVE_Walking);
+        break;
+
+    case EClimbSplineExit::WallClimb:
+        StartClimbing();
+        break;
+    }
+}
+#pragma endregion
+
+#pragma region CancelWindows
+void UCustomMovementComponent::BeginClimbAction(UAnimMontage *Montage)
+{
+    const double Time = GetWorld()->GetTimeSeconds();
+
+    if (LastClimbActionFinishTime >= 0.0 && Time - LastClimbActionFinishTime <= ClimbActionChainMaxGap)
+    {
+        ClimbActionChainStats.NumChains++;
+        ClimbActionChainStats.TotalChainStartToStart += Time - ActiveClimbActionStartTime;
+        ClimbActionChainStats.TotalChainGap += Time - LastClimbActionFinishTime;
+    }
+
+    ClimbActionChainStats.NumActions++;
+    ActiveClimbActionStartTime = Time;
+    ActiveClimbActionMontage = Montage;
+    EndedClimbMontage = nullptr;
+
+    PostClimbEvent(EClimbEventType::ActionStarted, Montage);
+}
+
+void UCustomMovementComponent::FinishClimbAction(EClimbActionEndReason Reason)
+{
+    UAnimMontage *Montage = ActiveClimbActionMontage;
+    if (!Montage)
+        return;
+
+    if (Reason == EClimbActionEndReason::Cancelled)
+    {
+        ClimbActionChainStats.NumCancelled++;
+        ClimbActionChainStats.TotalTimeSaved += FMath::Max(Montage->GetPlayLength() - GetActiveClimbActionTime(), 0.f);
+    }
+
+    // Cleared first, so the blend out notification of the stopped montage is ignored
+    ActiveClimbActionMontage = nullptr;
+
+    if (Reason == EClimbActionEndReason::Cancelled)
+    {
+        RemoveRootMotionSourceByID(ActiveClimbRootMotionSourceID);
+
+        if (OwningPlayerAnimInstance && OwningPlayerAnimInstance->Montage_IsPlaying(Montage))
+        {
+            OwningPlayerAnimInstance->Montage_Stop(ClimbActionCancelBlendOutTime, Montage);
+        }
+    }
+
+    ActiveClimbRootMotionSourceID = (uint16)ERootMotionSourceID::Invalid;
+    LastClimbActionFinishTime = GetWorld()->GetTimeSeconds();
+
+    HandleClimbActionEnded(Montage);
+    PostClimbEvent(EClimbEventType::ActionFinished, Montage, Reason);
+}
+
+float UCustomMovementComponent::GetActiveClimbActionTime()
+{
+    if (ActiveClimbRootMotionSourceID != (uint16)ERootMotionSourceID::Invalid)
+    {
+        const TSharedPtr<FRootMotionSource> Source = GetRootMotionSourceByID(ActiveClimbRootMotionSourceID);
+        return Source.IsValid() ? Source->GetTime() : 0.f;
+    }
+
+    return OwningPlayerAnimInstance ? OwningPlayerAnimInstance->Montage_GetPosition(ActiveClimbActionMontage) : 0.f;
+}
+
+const TArray<FClimbCancelWindow> &UCustomMovementComponent::GetClimbCancelWindows(const UAnimMontage *Montage)
+{
+    if (const TArray<FClimbCancelWindow> *Windows = ClimbCancelWindows.Find(Montage))
+        return *Windows;
+
+    TArray<FClimbCancelWindow> &Windows = ClimbCancelWindows.Add(Montage);
+    UAnimNotifyState_ClimbCancelWindow::GatherWindows(*Montage, Windows);
+    return Windows;
+}
+
+bool UCustomMovementComponent::IsInClimbCancelWindow(bool bTraversal)
+{
+    if (!ActiveClimbActionMontage || !CVarClimbCancelWindows.GetValueOnGameThread())
+        return false;
+
+    const float Time = GetActiveClimbActionTime();
+
+    for (const FClimbCancelWindow &Window : GetClimbCancelWindows(ActiveClimbActionMontage))
+    {
+        if (Window.Contains(Time) && (bTraversal ? Window.bAllowTraversal : Window.bAllowLocomotion))
+            return true;
+    }
+
+    return false;
+}
+
+void UCustomMovementComponent::UpdateClimbLocomotionCancel()
+{
+    if (!ActiveClimbActionMontage || Acceleration.IsNearlyZero())
+        return;
+
+    if (IsInClimbCancelWindow(false))
+    {
+        FinishClimbAction(EClimbActionEndReason::Cancelled);
+    }
+}
+#pragma endregion
+
+#pragma region ClimbEvents
+void UCustomMovementComponent::PostClimbEvent(EClimbEventType Type, UAnimMontage *Montage, EClimbActionEndReason Reason)
+{
+    FClimbEvent Event;
+    Event.Type = Type;
+    Event.Frame = GFrameCounter;
+    Event.Montage = Montage;
+    Event.Reason = Reason;
+
+    if (CVarClimbDeferEvents.GetValueOnGameThread())
+    {
+        ClimbEvents.Post(Event);
+        return;
+    }
+
+    // Listeners run right here, most posts come from inside the movement step
+    FClimbEventStats &Stats = ClimbEvents.Stats;
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    OnClimbEventDelegate.Broadcast(Event);
+
+    Stats.NumPosted++;
+    Stats.NumDispatchedInStep++;
+    Stats.InStepDispatchCycles += FPlatformTime::Cycles64() - StartCycles;
+}
+
+void UCustomMovementComponent::DispatchClimbEvents()
+{
+    FClimbEventStats &Stats = ClimbEvents.Stats;
+
+    if (bCapsuleOverlapsPending)
+    {
+        bCapsuleOverlapsPending = false;
+        Stats.NumOverlapUpdates++;
+        CharacterOwner->GetCapsuleComponent()->UpdateOverlaps();
+    }
+
+    if (!ClimbEvents.HasPending())
+        return;
+
+    SCOPE_CYCLE_COUNTER(STAT_ClimbEventDispatch);
+    const uint64 StartCycles = FPlatformTime::Cycles64();
+
+    FClimbEventQueue::FEventArray Events;
+    ClimbEvents.TakePending(Events);
+
+    for (const FClimbEvent &Event : Events)
+    {
+        OnClimbEventDelegate.Broadcast(Event);
+    }
+
+    INC_DWORD_STAT_BY(STAT_ClimbEventsDispatched, Events.Num());
+    Stats.NumDispatched += Events.Num();
+    Stats.DispatchCycles += FPlatformTime::Cycles64() - StartCycles;
+}
+
+void UCustomMovementComponent::ApplyEndedClimbMontage()
+{
+    UAnimMontage *Montage = EndedClimbMontage;
+    if (!Montage)
+        return;
+
+    EndedClimbMontage = nullptr;
+
+    // Cancelled or rejected since, that already ran its transition
+    if (Montage != ActiveClimbActionMontage)
+        return;
+
+    FinishClimbAction(bEndedClimbMontageInterrupted ? EClimbActionEndReason::Interrupted : EClimbActionEndReason::Completed);
+}
+#pragma endregion
+
+#pragma region InputBuffer
+void UCustomMovementComponent::RequestClimbAction()
+{
+    FClimbBufferedInput Input;
+    Input.PressFrame = GFrameCounter;
+    Input.PressTime = GetWorld()->GetTimeSeconds();
+    Input.bAttemptClimbing = !IsClimbing() && !IsHanging() && !IsClimbingSpline();
+
+    ClimbInputBuffer.Press(EClimbInputAction::Climb, Input);
+    ProcessClimbInputBuffer();
+}
+
+void UCustomMovementComponent::ProcessClimbInputBuffer()
+{
+    CLIMB_ALLOC_AUDIT_SCOPE(ProcessClimbInputBuffer);
+
+    const double Time = GetWorld()->GetTimeSeconds();
+
+    for (const EClimbInputAction Action : {EClimbInputAction::Climb, EClimbInputAction::Hop})
+    {
+        if (!ClimbInputBuffer.UpdatePending(Action, Time))
+            continue;
+
+        if (IsClimbInputActionBlocked(Action, ClimbInputBuffer.GetPending(Action)))
+        {
+            if (!IsInClimbCancelWindow(true))
+            {
+                ClimbInputBuffer.MarkBlocked(Action);
+                continue;
+            }
+
+            // The window lets this action cut the current one short, once its transition ran
+            FinishClimbAction(EClimbActionEndReason::Cancelled);
+        }
+
+        const FClimbBufferedInput Input = ClimbInputBuffer.Consume(Action, GFrameCounter);
+
+        UE_LOG(LogClimbing, Verbose, TEXT("%s: %s fired %d frames after the press"),
+            *GetNameSafe(GetOwner()),
+            Action == EClimbInputAction::Climb ? TEXT("Climb") : TEXT("Hop"),
+            int32(GFrameCounter - Input.PressFrame));
+
+        ExecuteClimbInputAction(Action, Input);
+    }
+}
+
+bool UCustomMovementComponent::IsClimbInputActionBlocked(EClimbInputAction Action, const FClimbBufferedInput &Input) const
+{
+    // Letting go was never held back by a playing action
+    if (Action == EClimbInputAction::Climb && !Input.bAttemptClimbing)
+        return false;
+
+    return IsClimbActionPlaying();
+}
+
+void UCustomMovementComponent::ExecuteClimbInputAction(EClimbInputAction Action, const FClimbBufferedInput &Input)
+{
+    if (Action == EClimbInputAction::Hop)
+    {
+        ExecuteHop(Input.VerticalInput);
+        return;
+    }
+
+    // A grab pressed during the action that got us onto the wall is already satisfied
+    if (Input.bAttemptClimbing && (IsClimbing() || IsHanging() || IsClimbingSpline()))
+        return;
+
+    ToggleClimbing(Input.bAttemptClimbing);
+}
+#pragma endregion
+
+#pragma region ServerValidation
+bool UCustomMovementComponent::IsServerForRemoteClimber() const
+{
+    return CharacterOwner->GetLocalRole() == ROLE_Authority && !CharacterOwner->IsLocallyControlled();
+}
+
+void UCustomMovementComponent::SendClimbStartToServer(EClimbStartAction Action)
+{
+    if (CharacterOwner->GetLocalRole() != ROLE_AutonomousProxy)
+        return;
+
+    ServerRequestClimbStart(Action, GetClimbViewTime());
+}
+
+double UCustomMovementComponent::GetClimbViewTime() const
+{
+    const AGameStateBase *GameState = GetWorld()->GetGameState();
+    if (!GameState)
+        return GetWorld()->GetTimeSeconds();
+
+    // Replicated geometry reaches this client half a round trip after the server moved it
+    const APlayerState *PlayerState = CharacterOwner->GetPlayerState();
+    const double HalfRoundTrip = PlayerState ? PlayerState->GetPingInMilliseconds() * 0.0005 : 0.0;
+
+    return GameState->GetServerWorldTimeSeconds() - HalfRoundTrip;
+}
+
+bool UCustomMovementComponent::ValidateClimbStart(EClimbStartAction Action)
+{
+    switch (Action)
+    {
+    case EClimbStartAction::Climb:
+        return CanStartClimbing();
+
+    case EClimbStartAction::ClimbDownLedge:
+        return CanClimbDownLedge();
+
+    case EClimbStartAction::Vault:
+    {
+        FVector VaultStartPosition;
+        FVector VaultLandPosition;
+
+        if (!CanStartVaulting(VaultStartPosition, VaultLandPosition))
+            return false;
+
+        SetMotionWarpTarget(FName("VaultStartPoint"), VaultStartPosition);
+        SetMotionWarpTarget(FName("VaultEndPoint"), VaultLandPosition);
+        return true;
+    }
+
+    case EClimbStartAction::ClimbUpLedge:
+        return IsClimbing() && CheckHasReachedLedge();
+
+    case EClimbStartAction::ClimbSpline:
+    {
+        float Distance;
+        return FindClimbSplineEntry(Distance) != nullptr;
+    }
+
+    case EClimbStartAction::Hang:
+        // The fitted ledge is kept for the hang, as the vault keeps its warp targets
+        return IsFalling() && FitLedgeSegment(HangLedge);
+    }
+
+    return false;
+}
+
+bool UCustomMovementComponent::ShouldRewindClimbQuery() const
+{
+    if (ClimbRewindTime < 0.0)
+        return false;
+
+    // Charged per query, past the rewind budget of this tick the rest of the request is checked against the present geometry
+    if (ClimbRewind->HasQueryBudget())
+        return true;
+
+    INC_DWORD_STAT(STAT_ClimbStartUnrewoundQueries);
+    return false;
+}
+
+void UCustomMovementComponent::ServerRequestClimbStart_Implementation(EClimbStartAction Action, double ClientViewTime)
+{
+    if (IsClimbActionPlaying())
+    {
+        // Same rule the client's input buffer used, the window lets the request cut the current action short
+        if (!IsInClimbCancelWindow(true))
+        {
+            ClientRejectClimbStart(Action);
+            return;
+        }
+
+        FinishClimbAction(EClimbActionEndReason::Cancelled);
+    }
+
+    if (ClimbRewind)
+    {
+        ClimbRewindTime = ClimbRewind->ClampRewindTime(ClientViewTime);
+    }
+
+    const bool bValid = ValidateClimbStart(Action);
+    ClimbRewindTime = -1.0;
+
+    if (!bValid)
+    {
+        INC_DWORD_STAT(STAT_ClimbStartRejections);
+        UE_LOG(LogClimbing, Verbose, TEXT("%s: rejected climb start %d"), *GetNameSafe(GetOwner()), int32(Action));
+
+        ClimbWarpTargets.Reset();
+        ClientRejectClimbStart(Action);
+        return;
+    }
+
+    switch (Action)
+    {
+    case EClimbStartAction::Climb:
+        PlayClimbMontage(IdleToClimbMontage);
+        break;
+
+    case EClimbStartAction::ClimbDownLedge:
+        PlayClimbMontage(ClimbDownLedgeMontage);
+        break;
+
+    case EClimbStartAction::Vault:
+        StartClimbing();
+        PlayClimbMontage(VaultMontage);
+        break;
+
+    case EClimbStartAction::ClimbUpLedge:
+        PlayClimbMontage(ClimbToTopMontage);
+        break;
+
+    case EClimbStartAction::ClimbSpline:
+        TryStartSplineClimbing();
+        break;
+
+    case EClimbStartAction::Hang:
+        StartHanging(HangLedge);
+        break;
+    }
+}
+
+void UCustomMovementComponent::ClientRejectClimbStart_Implementation(EClimbStartAction Action)
+{
+    // Undo the predicted action without its transition, the server's next movement correction puts the character back
+    if (UAnimMontage *Montage = ActiveClimbActionMontage)
+    {
+        ActiveClimbActionMontage = nullptr;
+
+        RemoveRootMotionSourceByID(ActiveClimbRootMotionSourceID);
+        ActiveClimbRootMotionSourceID = (uint16)ERootMotionSourceID::Invalid;
+
+        if (OwningPlayerAnimInstance && OwningPlayerAnimInstance->Montage_IsPlaying(Montage))
+        {
+            OwningPlayerAnimInstance->Montage_Stop(ClimbActionCancelBlendOutTime, Montage);
+        }
+
+        PostClimbEvent(EClimbEventType::ActionFinished, Montage, EClimbActionEndReason::Interrupted);
+    }
+
+    ClimbWarpTargets.Reset();
+
+    if ((Action == EClimbStartAction::Vault && IsClimbing()) || (Action == EClimbStartAction::ClimbSpline && IsClimbingSpline()))
+    {
+        StopClimbing();
+    }
+
+    if (Action == EClimbStartAction::Hang && IsHanging())
+    {
+        // Back to falling, without grabbing the same ledge again right away
+        StopClimbing();
+        LedgeGrabRetryTime = GetWorld()->GetTimeSeconds() + LedgeGrabRetryCooldown;
+    }
+}
+#pragma endregion
+
+#pragma region ContextualAction
+void UCustomMovementComponent::UpdateContextualAction()
+{
+    if (!bEvaluateContextualActions || !CharacterOwner->IsLocallyControlled() || !CharacterOwner->IsPlayerControlled())
+        return;
+
+    // Only a grounded press starts one of these, otherwise it grabs a ledge or lets go
+    if (!IsMovingOnGround() || IsClimbActionPlaying())
+    {
+        ContextualAction.EvaluatedTime = -1.0;
+        ContextualAction.NextEvaluationTime = 0.0;
+        PublishContextualAction(EClimbContextualAction::None);
+        return;
+    }
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    if (Now < ContextualAction.NextEvaluationTime)
+        return;
+
+    // Background work takes the speculative share, when that is spent the published action stays until next frame
+    const double RequiredByTime = ContextualAction.EvaluatedTime < 0.0 ? Now : ContextualAction.EvaluatedTime + ContextualActionMaxInterval;
+    if (ClimbQueryBudget && !ClimbQueryBudget->TryAcquire(EClimbQueryPriority::Speculative, ContextualActionQueryCount, RequiredByTime))
+        return;
+
+    TGuardValue<bool> QueriesAcquired(bContextualActionQueriesAcquired, true);
+
+    SCOPE_CYCLE_COUNTER(STAT_ClimbContextualAction);
+    INC_DWORD_STAT(STAT_ClimbContextualActionEvaluations);
+
+    const FVector Location = UpdatedComponent->GetComponentLocation();
+    const FVector Forward = UpdatedComponent->GetForwardVector();
+    const FVector KneeLocation = Location - UpdatedComponent->GetUpVector() * CharacterOwner->GetCapsuleComponent()->GetScaledCapsuleHalfHeight() * 0.5f;
+
+    const FHitResult ProximityHit = DoLineTraceSingleByObject(KneeLocation, KneeLocation + Forward * ContextualActionProbeDistance);
+
+    ContextualAction.WallDistance = ProximityHit.bBlockingHit ? ProximityHit.Distance : ContextualActionProbeDistance;
+    ContextualAction.EvaluatedTime = Now;
+    ContextualAction.Location = Location;
+    ContextualAction.Forward = Forward;
+
+    const EClimbContextualAction Action = EvaluateContextualAction(
+        ContextualAction.WallDistance <= ContextualActionReach,
+        ContextualAction.VaultStartPosition,
+        ContextualAction.VaultLandPosition);
+
+    PublishContextualAction(Action);
+    ContextualAction.NextEvaluationTime = Now + GetContextualActionInterval();
+}
+
+EClimbContextualAction UCustomMovementComponent::EvaluateContextualAction(bool bWallInReach, FVector &OutVaultStartPosition, FVector &OutVaultLandPosition)
+{
+    OutVaultStartPosition = FVector::ZeroVector;
+    OutVaultLandPosition = FVector::ZeroVector;
+
+    // Climb splines are found without any queries, and win over the wall they are mounted on
+    float SplineDistance;
+    if (FindClimbSplineEntry(SplineDistance))
+        return EClimbContextualAction::ClimbSpline;
+    if (bWallInReach && CanStartClimbing())
+        return EClimbContextualAction::Climb;
+    if (CanClimbDownLedge())
+        return EClimbContextualAction::ClimbDownLedge;
+    if (bWallInReach && CanStartVaulting(OutVaultStartPosition, OutVaultLandPosition))
+        return EClimbContextualAction::Vault;
+
+    return EClimbContextualAction::None;
+}
+
+bool UCustomMovementComponent::IsContextualActionCacheValid() const
+{
+    // The background pass only checks climb and vault with the wall in reach, a cached None is no answer for a press
+    if (ContextualAction.Action == EClimbContextualAction::None)
+        return false;
+    if (ContextualAction.EvaluatedTime < 0.0 || GetWorld()->GetTimeSeconds() - ContextualAction.EvaluatedTime > ContextualActionValidTime)
+        return false;
+    if (FVector::DistSquared(UpdatedComponent->GetComponentLocation(), ContextualAction.Location) > FMath::Square(ContextualActionMaxDrift))
+        return false;
+
+    return FVector::DotProduct(UpdatedComponent->GetForwardVector(), ContextualAction.Forward) >= FMath::Cos(FMath::DegreesToRadians(ContextualActionMaxTurn));
+}
+
+float UCustomMovementComponent::GetContextualActionInterval() const
+{
+    if (ContextualAction.Action != EClimbContextualAction::None || ContextualAction.WallDistance <= ContextualActionReach)
+        return ContextualActionMinInterval;
+
+    // Far from anything climbable, look again when the character could be halfway there
+    const float Speed = Velocity.Size2D();
+    if (Speed < 1.f)
+        return ContextualActionMaxInterval;
+
+    const float TimeToReach = (ContextualAction.WallDistance - ContextualActionReach) / Speed;
+    return FMath::Clamp(TimeToReach * 0.5f, ContextualActionMinInterval, ContextualActionMaxInterval);
+}
+
+void UCustomMovementComponent::StartContextualAction(EClimbContextualAction Action, const FVector &VaultStartPosition, const FVector &VaultLandPosition)
+{
+    switch (Action)
+    {
+    case EClimbContextualAction::Climb:
+        PlayClimbMontage(IdleToClimbMontage);
+        SendClimbStartToServer(EClimbStartAction::Climb);
+        break;
+
+    case EClimbContextualAction::ClimbDownLedge:
+        PlayClimbMontage(ClimbDownLedgeMontage);
+        SendClimbStartToServer(EClimbStartAction::ClimbDownLedge);
+        break;
+
+    case EClimbContextualAction::Vault:
+        SetMotionWarpTarget(FName("VaultStartPoint"), VaultStartPosition);
+        SetMotionWarpTarget(FName("VaultEndPoint"), VaultLandPosition);
+
+        StartClimbing();
+        PlayClimbMontage(VaultMontage);
+        SendClimbStartToServer(EClimbStartAction::Vault);
+        break;
+
+    case EClimbContextualAction::ClimbSpline:
+        if (TryStartSplineClimbing())
+        {
+            SendClimbStartToServer(EClimbStartAction::ClimbSpline);
+        }
+        break;
+
+    case EClimbContextualAction::None:
+        return;
+    }
+
+    ContextualAction.EvaluatedTime = -1.0;
+    ContextualAction.NextEvaluationTime = 0.0;
+}
+
+void UCustomMovementComponent::PublishContextualAction(EClimbContextualAction Action)
+{
+    if (ContextualAction.Action == Action)
+        return;
+
+    ContextualAction.Action = Action;
+    OnClimbContextualActionChangedDelegate.Broadcast(Action);
+}
+#pragma endregion
+
+#pragma region QueryBudget
+bool UCustomMovementComponent::AcquireClimbQueries(int32 NumQueries, double LastServedTime, bool bSpeculative)
+{
+    // Validating a client request always runs, rewound while the rewind budget lasts, and the contextual action evaluation took its queries up front
+    if (!ClimbQueryBudget || ClimbRewindTime >= 0.0 || bContextualActionQueriesAcquired)
+        return true;
+
+    const double RequiredByTime = LastServedTime < 0.0 ? GetWorld()->GetTimeSeconds() : LastServedTime + ClimbQueryMaxDeferTime;
+    const EClimbQueryPriority Priority = bSpeculative ? EClimbQueryPriority::Speculative : ClimbQueryBudget->GetPriority(*CharacterOwner);
+    return ClimbQueryBudget->TryAcquire(Priority, NumQueries, RequiredByTime);
+}
+#pragma endregion
+
+#pragma region AsyncClimb
+void UCustomMovementComponent::AcquireAsyncClimber()
+{
+    // Replayed client moves need the climb step on the game thread
+    if (!bUseAsyncClimbPhysics || AsyncClimberId != INDEX_NONE || GetNetMode() != NM_Standalone)
+        return;
+
+    AsyncClimbPhysics = GetWorld()->GetSubsystem<UClimbAsyncPhysicsSubsystem>();
+    if (AsyncClimbPhysics)
+    {
+        AsyncClimberId = AsyncClimbPhysics->RegisterClimber();
+    }
+}
+
+void UCustomMovementComponent::ReleaseAsyncClimber()
+{
+    if (AsyncClimbPhysics && AsyncClimberId != INDEX_NONE)
+    {
+        AsyncClimbPhysics->UnregisterClimber(AsyncClimberId);
+    }
+
+    AsyncClimberId = INDEX_NONE;
+    LastSubmittedAsyncClimbSerial = 0;
+    LastAppliedAsyncClimbSerial = 0;
+}
+
+bool UCustomMovementComponent::ShouldRunClimbOnPhysicsThread() const
+{
+    // Root motion moves and corner turns stay on the game thread, the physics thread step only covers free climbing
+    return AsyncClimberId != INDEX_NONE && IsClimbing() && !HasAnimRootMotion() && !CurrentRootMotion.HasOverrideVelocity() &&
+           !ClimbCornerTransition.IsActive();
+}
+
+void UCustomMovementComponent::PhysClimbAsync(float deltaTime)
+{
+    CLIMB_ALLOC_AUDIT_SCOPE(PhysClimbAsync);
+    SCOPE_CYCLE_COUNTER(STAT_ClimbApplyAsyncPhysics);
+
+    if (deltaTime < MIN_TICK_TIME)
+        return;
+
+    const FClimbAsyncClimberOutput *Result = AsyncClimbPhysics->GetLatestOutput(AsyncClimberId);
+
+    if (Result && Result->Serial > LastAppliedAsyncClimbSerial)
+    {
+        LastAppliedAsyncClimbSerial = Result->Serial;
+
+        if (Result->bShouldStop || Result->bReachedFloor)
+        {
+            StopClimbing();
+            return;
+        }
+
+        CurrentClimbableSurfaceLocation = Result->SurfaceLocation;
+        CurrentClimbableSurfaceNormal = Result->SurfaceNormal;
+        Velocity = Result->Velocity;
+
+        // Swept like PhysClimb, the game thread scene may have changed since the physics thread step
+        const FVector Adjusted = Result->Location - UpdatedComponent->GetComponentLocation();
+        FHitResult Hit(1.f);
+        SafeMoveUpdatedComponent(Adjusted, Result->Rotation, true, Hit);
+
+        if (Hit.Time < 1.f)
+        {
+            HandleImpact(Hit, deltaTime, Adjusted);
+            SlideAlongSurface(Adjusted, (1.f - Hit.Time), Hit.Normal, Hit, true);
+        }
+
+        // The game thread probes skip the surface sweep while the climb runs here, so the step's contacts stand in for it.
+        // Their components are resolved here, the physics thread only copied them
+        FClimbContactManifold StepContacts = Result->Contacts;
+        for (int32 i = 0; i < StepContacts.Num; ++i)
+        {
+            const UPrimitiveComponent *Component = Result->ContactComponents[i].Get();
+            StepContacts.PrimitiveIds[i] = Component ? Component->GetUniqueID() : 0;
+        }
+
+        ClimbContacts.UpdateFrom(StepContacts);
+        ClimbContactBase = Result->ContactComponents[0];
+        ClimbCorner = Result->Corner;
+
+        if (const UPrimitiveComponent *Base = ClimbContactBase.Get())
+        {
+            const FTransform &BaseTransform = Base->GetComponentTransform();
+            ClimbContacts.StoreLocalSpace(BaseTransform);
+            ClimbSweepRelativeTransform = UpdatedComponent->GetComponentTransform().GetRelativeTransform(BaseTransform);
+        }
+
+        if (Result->bReachedLedge)
+        {
+            PostClimbEvent(EClimbEventType::LedgeReached);
+
+            if (bHangBeforeClimbingUp && TryStartHanging())
+                return;
+
+            PlayClimbMontage(ClimbToTopMontage);
+            return;
+        }
+
+        // The turn itself runs in PhysClimb, the physics thread picks the climber up again on the face it ends on
+        if (TryStartClimbCornerTransition())
+        {
+            PhysClimbCorner(deltaTime);
+            return;
+        }
+    }
+
+    FClimbAsyncClimberInput Input;
+    Input.ClimberId = AsyncClimberId;
+    Input.Location = UpdatedComponent->GetComponentLocation();
+    Input.Rotation = UpdatedComponent->GetComponentQuat();
+    Input.Velocity = Velocity;
+    Input.Acceleration = Acceleration;
+    Input.MaxSpeed = MaxClimbSpeed;
+    Input.BrakingDeceleration = MaxBreakClimbDeceleration;
+    Input.CapsuleTraceRadius = ClimbCapsuleTraceRadius;
+    Input.CapsuleTraceHalfHeight = ClimbCapsuleTraceHalfHeight;
+    Input.BaseEyeHeight = CharacterOwner->BaseEyeHeight;
+    Input.CornerMinAngle = ClimbCornerMinAngle;
+    Input.ObjectQueryParams = ClimbObjectQueryParams;
+
+    AsyncClimbPhysics->SubmitClimberInput(Input);
+    LastSubmittedAsyncClimbSerial = Input.Serial;
+}
+#pragma endregion
+
+#pragma region LedgeGrab
+void UCustomMovementComponent::UpdateAirborneLedgeGrab()
+{
+    CLIMB_ALLOC_AUDIT_SCOPE(UpdateAirborneLedgeGrab);
+
+    if (!bAutoGrabLedgesWhileFalling || !IsFalling() || IsClimbActionPlaying())
+        return;
+
+    // A remote client reports its own ledge grabs for the server to validate, simulated proxies follow the replicated mode
+    if (IsServerForRemoteClimber() || CharacterOwner->GetLocalRole() == ROLE_SimulatedProxy)
+        return;
+
+    SCOPE_CYCLE_COUNTER(STAT_ClimbLedgeGrab);
+
+    RefreshLedgeGrabCandidates();
+
+    const double Now = GetWorld()->GetTimeSeconds();
+    if (Now < LedgeGrabRetryTime || !CanTrajectoryReachLedgeCandidate())
+        return;
+
+    INC_DWORD_STAT(STAT_ClimbLedgeGrabPreciseChecks);
+    if (TryStartHanging(true))
+    {
+        SendClimbStartToServer(EClimbStartAction::Hang);
+    }
+    else
+    {
+        LedgeGrabRetryTime = Now + LedgeGrabRetryCooldown;
+    }
+}
+
+void UCustomMovementComponent::RefreshLedgeGrabCandidates()
+{
+    const double Now = GetWorld()->GetTimeSeconds();
+    const FVector Location = UpdatedComponent->GetComponentLocation();
+
+    const bool bFresh = LedgeGrabCandidatesTime >= 0.0 && Now - LedgeGrabCandidatesTime < LedgeGrabCandidateRefreshInterval;
+    const bool bNearby = FVector::DistSquared(Location, LedgeGrabCandidatesCenter) < FMath::Square(LedgeGrabCandidateRadius * 0.5f);
+
+    if (bFresh && bNearby)
+        return;
+
+    // Falling keeps the previous candidates until the budget has room
+    const double LastServedTime = LedgeGrabCandidatesTime < 0.0 ? -1.0 : LedgeGrabCandidatesTime + LedgeGrabCandidateRefreshInterval;
+    if (!AcquireClimbQueries(1, LastServedTime, true))
+        return;
+
+    INC_DWORD_STAT(STAT_ClimbLedgeGrabCandidateRefreshes);
+
+    LedgeGrabCandidatesTime = Now;
+    LedgeGrabCandidatesCenter = Location;
+    LedgeGrabCandidates.Reset();
+
+    TArray<FOverlapResult> Overlaps;
+    GetWorld()->OverlapMultiByObjectType(
+        Overlaps,
+        Location,
+        FQuat::Identity,
+        ClimbObjectQueryParams,
+        FCollisionShape::MakeSphere(LedgeGrabCandidateRadius),
+        FCollisionQueryParams(SCENE_QUERY_STAT(ClimbLedgeGrabCandidates), false, CharacterOwner));
+
+    for (const FOverlapResult &Overlap : Overlaps)
+    {
+        if (UPrimitiveComponent *Primitive = Overlap.GetComponent())
+        {
+            LedgeGrabCandidates.AddUnique(Primitive);
+        }
+    }
+}
+
+bool UCustomMovementComponent::CanTrajectoryReachLedgeCandidate() const
+{
+    if (LedgeGrabCandidates.IsEmpty())
+        return false;
+
+    // Box around where a grabbing hand can be over the prediction window, from the ballistic trajectory
+    const FVector Location = UpdatedComponent->GetComponentLocation();
+    const FVector Reach = UpdatedComponent->GetForwardVector() * LedgeGrabReach;
+    const FVector HandOffset = FVector::UpVector * HangHeightBelowLedge;
+    const float GravityZ = GetGravityZ();
+
+    auto GetTrajectoryLocation = [&](float Time)
+    {
+        return Location + Velocity * Time + FVector(0.f, 0.f, 0.5f * GravityZ * Time * Time);
+    };
+
+    FBox HandZone(ForceInit);
+    auto AddTrajectoryPoint = [&](float Time)
+    {
+        const FVector Hands = GetTrajectoryLocation(Time) + HandOffset;
+        HandZone += Hands;
+        HandZone += Hands + Reach;
+    };
+
+    AddTrajectoryPoint(0.f);
+    AddTrajectoryPoint(LedgeGrabPredictionTime);
+
+    if (GravityZ < 0.f && Velocity.Z > 0.f)
+    {
+        const float ApexTime = -Velocity.Z / GravityZ;
+        if (ApexTime < LedgeGrabPredictionTime)
+        {
+            AddTrajectoryPoint(ApexTime);
+        }
+    }
+
+    HandZone = HandZone.ExpandBy(HangLedgeHeightTolerance);
+
+    for (const TWeakObjectPtr<UPrimitiveComponent> &Candidate : LedgeGrabCandidates)
+    {
+        const UPrimitiveComponent *Primitive = Candidate.Get();
+        if (!Primitive)
+            continue;
+
+        // Live bounds, so moving candidates are tested where they are now. The bounds are only a broad phase,
+        // ledges below their top are still candidates and the ledge trace decides whether the hands can hold on
+        if (Primitive->Bounds.GetBox().Intersect(HandZone))
+            return true;
+    }
+
+    return false;
+}
+#pragma endregion
@@ -0,0 +1,259 @@
+#include "Mass/AmbientClimberProcessors.h"
+#include "Mass/AmbientClimberTypes.h"
+#include "Mass/AmbientClimberSettings.h"
+#include "Mass/AmbientClimberSubsystem.h"
+#include "MassCommonFragments.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+#include "MassCommandBuffer.h"
+#include "ClimbingSystem.h"
+
+DECLARE_CYCLE_STAT(TEXT("Ambient Climber Movement"), STAT_AmbientClimberMovement, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("Ambient Climber Promotion"), STAT_AmbientClimberPromotion, STATGROUP_Climbing);
+DECLARE_CYCLE_STAT(TEXT("Ambient Climber Representation"), STAT_AmbientClimberRepresentation, STATGROUP_Climbing);
+
+namespace AmbientClimber
+{
+    static void EnterPhase(FAmbientClimbPhaseFragment &Phase, EAmbientClimbPhase NewPhase)
+    {
+        Phase.Phase = NewPhase;
+        Phase.PhaseTime = 0.f;
+    }
+
+    static void PickClimbDirection(FAmbientClimbPhaseFragment &Phase)
+    {
+        // Mostly upwards, like a player heading for the ledge
+        Phase.Direction = FVector2f(Phase.RandomStream.FRandRange(-0.7f, 0.7f), 1.f).GetSafeNormal();
+    }
+
+    static void Step(FAmbientClimbSurfaceFragment &Surface, FAmbientClimbPhaseFragment &Phase, const UAmbientClimberSettings &Settings, float DeltaTime)
+    {
+        Phase.PhaseTime += DeltaTime;
+
+        switch (Phase.Phase)
+        {
+        case EAmbientClimbPhase::Climbing:
+        {
+            Surface.Position += Phase.Direction * Settings.ClimbSpeed * DeltaTime;
+
+            if (FMath::Abs(Surface.Position.X) >= Surface.Extent.X)
+            {
+                Surface.Position.X = FMath::Clamp(Surface.Position.X, -Surface.Extent.X, Surface.Extent.X);
+                Phase.Direction.X = -Phase.Direction.X;
+            }
+
+            if (Surface.Position.Y >= Surface.Extent.Y)
+            {
+                Surface.Position.Y = Surface.Extent.Y;
+                EnterPhase(Phase, EAmbientClimbPhase::ClimbingUp);
+            }
+            else if (Phase.RandomStream.FRand() < Settings.HopChancePerSecond * DeltaTime)
+            {
+                Phase.PhaseStart = Surface.Position;
+                Phase.PhaseTarget = FVector2f(Surface.Position.X, FMath::Min(Surface.Position.Y + Settings.HopDistance, Surface.Extent.Y));
+                EnterPhase(Phase, EAmbientClimbPhase::Hopping);
+            }
+            break;
+        }
+        case EAmbientClimbPhase::Hopping:
+        {
+            const float Alpha = FMath::Clamp(Phase.PhaseTime / Settings.HopDuration, 0.f, 1.f);
+            Surface.Position = FMath::Lerp(Phase.PhaseStart, Phase.PhaseTarget, FMath::SmoothStep(0.f, 1.f, Alpha));
+
+            if (Alpha >= 1.f)
+            {
+                EnterPhase(Phase, EAmbientClimbPhase::Climbing);
+            }
+            break;
+        }
+        case EAmbientClimbPhase::ClimbingUp:
+        {
+            if (Phase.PhaseTime >= Settings.ClimbUpDuration)
+            {
+                EnterPhase(Phase, EAmbientClimbPhase::Dropping);
+            }
+            break;
+        }
+        case EAmbientClimbPhase::Dropping:
+        {
+            // Recycle the climber to the bottom of its patch
+            Surface.Position.Y -= Phase.PhaseTime * 980.f * DeltaTime;
+
+            if (Surface.Position.Y <= 0.f)
+            {
+                Surface.Position.Y = 0.f;
+                PickClimbDirection(Phase);
+                EnterPhase(Phase, EAmbientClimbPhase::Climbing);
+            }
+            break;
+        }
+        }
+    }
+
+    static FTransform GetWorldTransform(const FAmbientClimbSurfaceFragment &Surface, const FAmbientClimbPhaseFragment &Phase, float StandOff)
+    {
+        FVector Location =
+            Surface.Origin +
+            Surface.Right * Surface.Position.X +
+            Surface.Up * Surface.Position.Y +
+            Surface.Normal * StandOff;
+
+        if (Phase.Phase == EAmbientClimbPhase::ClimbingUp)
+        {
+            // Pull up over the ledge onto the top of the patch
+            Location -= Surface.Normal * StandOff * 2.f * FMath::Min(Phase.PhaseTime, 1.f);
+        }
+
+        return FTransform(FRotationMatrix::MakeFromXZ(-Surface.Normal, Surface.Up).ToQuat(), Location);
+    }
+}
+
+UAmbientClimberMovementProcessor::UAmbientClimberMovementProcessor()
+{
+    ExecutionFlags = int32(EProcessorExecutionFlags::Client | EProcessorExecutionFlags::Standalone);
+    ExecutionOrder.ExecuteInGroup = UE::Mass::ProcessorGroupNames::Movement;
+    ProcessingPhase = EMassProcessingPhase::PrePhysics;
+}
+
+void UAmbientClimberMovementProcessor::ConfigureQueries()
+{
+    EntityQuery.AddRequirement<FAmbientClimbSurfaceFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FAmbientClimbPhaseFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+    EntityQuery.AddTagRequirement<FAmbientClimberTag>(EMassFragmentPresence::All);
+    EntityQuery.RegisterWithProcessor(*this);
+}
+
+void UAmbientClimberMovementProcessor::Execute(FMassEntityManager &EntityManager, FMassExecutionContext &Context)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+    SCOPE_CYCLE_COUNTER(STAT_AmbientClimberMovement);
+
+    const UAmbientClimberSettings &Settings = *GetDefault<UAmbientClimberSettings>();
+
+    EntityQuery.ForEachEntityChunk(EntityManager, Context, [&Settings](FMassExecutionContext &Context)
+    {
+        const float DeltaTime = Context.GetDeltaTimeSeconds();
+        const TArrayView<FAmbientClimbSurfaceFragment> Surfaces = Context.GetMutableFragmentView<FAmbientClimbSurfaceFragment>();
+        const TArrayView<FAmbientClimbPhaseFragment> Phases = Context.GetMutableFragmentView<FAmbientClimbPhaseFragment>();
+        const TArrayView<FTransformFragment> Transforms = Context.GetMutableFragmentView<FTransformFragment>();
+
+        for (int32 EntityIndex = 0; EntityIndex < Context.GetNumEntities(); ++EntityIndex)
+        {
+            AmbientClimber::Step(Surfaces[EntityIndex], Phases[EntityIndex], Settings, DeltaTime);
+            Transforms[EntityIndex].GetMutableTransform() =
+                AmbientClimber::GetWorldTransform(Surfaces[EntityIndex], Phases[EntityIndex], Settings.SurfaceStandOff);
+        }
+    });
+}
+
+UAmbientClimberPromotionProcessor::UAmbientClimberPromotionProcessor()
+{
+    ExecutionFlags = int32(EProcessorExecutionFlags::Client | EProcessorExecutionFlags::Standalone);
+    ExecutionOrder.ExecuteAfter.Add(UE::Mass::ProcessorGroupNames::Movement);
+    ProcessingPhase = EMassProcessingPhase::PrePhysics;
+    bRequiresGameThreadExecution = true;
+}
+
+void UAmbientClimberPromotionProcessor::ConfigureQueries()
+{
+    EntityQuery.AddRequirement<FAmbientClimbSurfaceFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FAmbientClimbPhaseFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddTagRequirement<FAmbientClimberTag>(EMassFragmentPresence::All);
+    EntityQuery.RegisterWithProcessor(*this);
+}
+
+void UAmbientClimberPromotionProcessor::Execute(FMassEntityManager &EntityManager, FMassExecutionContext &Context)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+    SCOPE_CYCLE_COUNTER(STAT_AmbientClimberPromotion);
+
+    UAmbientClimberSubsystem *AmbientClimberSubsystem = UWorld::GetSubsystem<UAmbientClimberSubsystem>(EntityManager.GetWorld());
+    if (!AmbientClimberSubsystem || AmbientClimberSubsystem->GetViewerLocations().IsEmpty())
+        return;
+
+    const float PromoteDistanceSquared = FMath::Square(GetDefault<UAmbientClimberSettings>()->PromoteDistance);
+
+    // Once a promotion is refused the caps are reached for this frame, the remaining chunks are skipped too
+    bool bPromotionsFull = false;
+
+    EntityQuery.ForEachEntityChunk(EntityManager, Context, [AmbientClimberSubsystem, PromoteDistanceSquared, &bPromotionsFull](FMassExecutionContext &Context)
+    {
+        if (bPromotionsFull)
+            return;
+
+        const TConstArrayView<FAmbientClimbSurfaceFragment> Surfaces = Context.GetFragmentView<FAmbientClimbSurfaceFragment>();
+        const TConstArrayView<FAmbientClimbPhaseFragment> Phases = Context.GetFragmentView<FAmbientClimbPhaseFragment>();
+        const TConstArrayView<FTransformFragment> Transforms = Context.GetFragmentView<FTransformFragment>();
+
+        for (int32 EntityIndex = 0; EntityIndex < Context.GetNumEntities(); ++EntityIndex)
+        {
+            // Only hand over climbers that are on the wall, a full character cannot start mid hop or mid ledge climb
+            if (Phases[EntityIndex].Phase != EAmbientClimbPhase::Climbing)
+                continue;
+
+            const FVector Location = Transforms[EntityIndex].GetTransform().GetLocation();
+
+            bool bIsNearViewer = false;
+            for (const FVector &ViewerLocation : AmbientClimberSubsystem->GetViewerLocations())
+            {
+                if (FVector::DistSquared(ViewerLocation, Location) < PromoteDistanceSquared)
+                {
+                    bIsNearViewer = true;
+                    break;
+                }
+            }
+
+            if (!bIsNearViewer)
+                continue;
+
+            if (!AmbientClimberSubsystem->RequestPromotion(Transforms[EntityIndex].GetTransform(), Surfaces[EntityIndex]))
+            {
+                bPromotionsFull = true;
+                break;
+            }
+
+            Context.Defer().DestroyEntity(Context.GetEntity(EntityIndex));
+        }
+    });
+}
+
+UAmbientClimberRepresentationProcessor::UAmbientClimberRepresentationProcessor()
+{
+    ExecutionFlags = int32(EProcessorExecutionFlags::Client | EProcessorExecutionFlags::Standalone);
+    ProcessingPhase = EMassProcessingPhase::FrameEnd;
+    bRequiresGameThreadExecution = true;
+}
+
+void UAmbientClimberRepresentationProcessor::ConfigureQueries()
+{
+    EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+    EntityQuery.AddTagRequirement<FAmbientClimberTag>(EMassFragmentPresence::All);
+    EntityQuery.RegisterWithProcessor(*this);
+}
+
+void UAmbientClimberRepresentationProcessor::Execute(FMassEntityManager &EntityManager, FMassExecutionContext &Context)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+    SCOPE_CYCLE_COUNTER(STAT_AmbientClimberRepresentation);
+
+    UAmbientClimberSubsystem *AmbientClimberSubsystem = UWorld::GetSubsystem<UAmbientClimberSubsystem>(EntityManager.GetWorld());
+    if (!AmbientClimberSubsystem)
+        return;
+
+    TArray<FTransform> &InstanceTransforms = AmbientClimberSubsystem->GetRepresentationTransforms();
+    InstanceTransforms.Reset();
+
+    EntityQuery.ForEachEntityChunk(EntityManager, Context, [&InstanceTransforms](FMassExecutionContext &Context)
+    {
+        const TConstArrayView<FTransformFragment> Transforms = Context.GetFragmentView<FTransformFragment>();
+
+        for (const FTransformFragment &Transform : Transforms)
+        {
+            InstanceTransforms.Add(Transform.GetTransform());
+        }
+    });
+
+    AmbientClimberSubsystem->UpdateRepresentation();
+}
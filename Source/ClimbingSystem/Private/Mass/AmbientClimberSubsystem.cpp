@@ -0,0 +1,347 @@
+#include "Mass/AmbientClimberSubsystem.h"
+#include "Mass/AmbientClimberSettings.h"
+#include "ClimbingSystemCharacter.h"
+#include "Components/CustomMovementComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Misc/App.h"
+#include "MassCommonFragments.h"
+#include "MassEntitySubsystem.h"
+#include "ClimbingSystem.h"
+
+namespace
+{
+    FAutoConsoleCommandWithWorldAndArgs MeasureAmbientClimbersCommand(
+        TEXT("Climb.MeasureAmbientClimbers"),
+        TEXT("Climb.MeasureAmbientClimbers [Count=1000] [Seconds=10]: spawns Count ambient climbers in front of the first viewer and logs the frame times while they climb"),
+        FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString> &Args, UWorld *World)
+        {
+            UAmbientClimberSubsystem *Subsystem = World ? World->GetSubsystem<UAmbientClimberSubsystem>() : nullptr;
+            if (!Subsystem)
+                return;
+
+            const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000;
+            const float Seconds = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 10.f;
+            Subsystem->StartMeasurement(Count, Seconds);
+        }));
+}
+
+bool UAmbientClimberSubsystem::ShouldCreateSubsystem(UObject *Outer) const
+{
+    // Ambient climbers are purely cosmetic
+    const UWorld *World = Cast<UWorld>(Outer);
+    return Super::ShouldCreateSubsystem(Outer) && World && World->IsGameWorld() && !IsRunningDedicatedServer();
+}
+
+void UAmbientClimberSubsystem::OnWorldBeginPlay(UWorld &InWorld)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+    Super::OnWorldBeginPlay(InWorld);
+
+    if (UMassEntitySubsystem *EntitySubsystem = InWorld.GetSubsystem<UMassEntitySubsystem>())
+    {
+        ClimberArchetype = EntitySubsystem->GetMutableEntityManager().CreateArchetype({
+            FTransformFragment::StaticStruct(),
+            FAmbientClimbSurfaceFragment::StaticStruct(),
+            FAmbientClimbPhaseFragment::StaticStruct(),
+            FAmbientClimberTag::StaticStruct()});
+    }
+
+    // Loaded once, entities are only handed over for promotion when there is a class to promote them to
+    PromotedCharacterClass = GetDefault<UAmbientClimberSettings>()->PromotedCharacterClass.LoadSynchronous();
+
+    if (UStaticMesh *RepresentationMesh = GetDefault<UAmbientClimberSettings>()->RepresentationMesh.LoadSynchronous())
+    {
+        FActorSpawnParameters SpawnParameters;
+        SpawnParameters.ObjectFlags = RF_Transient;
+        RepresentationActor = InWorld.SpawnActor<AActor>(SpawnParameters);
+
+        RepresentationComponent = NewObject<UInstancedStaticMeshComponent>(RepresentationActor);
+        RepresentationComponent->SetStaticMesh(RepresentationMesh);
+        RepresentationComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+        RepresentationComponent->SetCastShadow(false);
+        RepresentationActor->SetRootComponent(RepresentationComponent);
+        RepresentationComponent->RegisterComponent();
+    }
+}
+
+void UAmbientClimberSubsystem::Deinitialize()
+{
+    if (RepresentationActor)
+    {
+        RepresentationActor->Destroy();
+        RepresentationActor = nullptr;
+        RepresentationComponent = nullptr;
+    }
+
+    Super::Deinitialize();
+}
+
+TStatId UAmbientClimberSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UAmbientClimberSubsystem, STATGROUP_Tickables);
+}
+
+void UAmbientClimberSubsystem::Tick(float DeltaTime)
+{
+    LLM_SCOPE_BYTAG(Climbing);
+
+    Super::Tick(DeltaTime);
+
+    UpdateViewerLocations();
+    ProcessPromotions();
+    ProcessDemotions();
+    UpdateMeasurement();
+}
+
+void UAmbientClimberSubsystem::StartMeasurement(int32 Count, float Seconds)
+{
+    const APlayerController *PlayerController = GetWorld()->GetFirstPlayerController();
+    if (!PlayerController || !PlayerController->PlayerCameraManager)
+        return;
+
+    // A patch facing the viewer, far enough out that only its near edge is within PromoteDistance
+    const FVector ViewForward = PlayerController->PlayerCameraManager->GetCameraRotation().Vector().GetSafeNormal2D();
+    const FVector ViewLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+    const FVector SurfaceOrigin = ViewLocation + ViewForward * GetDefault<UAmbientClimberSettings>()->PromoteDistance * 1.5f - FVector::UpVector * 200.f;
+
+    SpawnAmbientClimbers(SurfaceOrigin, -ViewForward, 10000.f, 3000.f, Count);
+
+    Measurement = FMeasurement();
+    Measurement.EndTime = GetWorld()->GetRealTimeSeconds() + Seconds;
+    Measurement.MinClimbers = TNumericLimits<int32>::Max();
+
+    UE_LOG(LogClimbing, Display, TEXT("Measuring %d more ambient climbers for %.0f s"), Count, Seconds);
+}
+
+void UAmbientClimberSubsystem::UpdateMeasurement()
+{
+    if (Measurement.EndTime <= 0.0)
+        return;
+
+    Measurement.NumFrames++;
+    Measurement.MinClimbers = FMath::Min(Measurement.MinClimbers, RepresentationTransforms.Num());
+    Measurement.FrameTimeSum += FApp::GetDeltaTime() * 1000.0;
+    Measurement.GameThreadTimeSum += FPlatformTime::ToMilliseconds(GGameThreadTime);
+    Measurement.WorstFrameTime = FMath::Max(Measurement.WorstFrameTime, FApp::GetDeltaTime() * 1000.0);
+
+    if (GetWorld()->GetRealTimeSeconds() < Measurement.EndTime)
+        return;
+
+    UE_LOG(LogClimbing, Display, TEXT("Ambient climbers: at least %d on screen and %d promoted over %d frames, frame %.2f ms average %.2f ms worst, game thread %.2f ms average. See stat Climbing for the processors"),
+        Measurement.MinClimbers,
+        PromotedClimbers.Num(),
+        Measurement.NumFrames,
+        Measurement.FrameTimeSum / Measurement.NumFrames,
+        Measurement.WorstFrameTime,
+        Measurement.GameThreadTimeSum / Measurement.NumFrames);
+
+    Measurement = FMeasurement();
+}
+
+void UAmbientClimberSubsystem::SpawnAmbientClimbers(const FVector &SurfaceOrigin, const FVector &SurfaceNormal, float SurfaceWidth, float SurfaceHeight, int32 Count)
+{
+    if (Count <= 0)
+        return;
+
+    FAmbientClimbSurfaceFragment Surface;
+    Surface.Origin = SurfaceOrigin;
+    Surface.Normal = SurfaceNormal.GetSafeNormal();
+    Surface.Right = FVector::CrossProduct(FVector::UpVector, Surface.Normal).GetSafeNormal();
+    Surface.Up = FVector::CrossProduct(Surface.Normal, Surface.Right);
+    Surface.Extent = FVector2f(SurfaceWidth * 0.5f, SurfaceHeight);
+
+    TArray<FAmbientClimbSurfaceFragment> Surfaces;
+    Surfaces.Reserve(Count);
+
+    FRandomStream RandomStream(GetTypeHash(SurfaceOrigin));
+    for (int32 i = 0; i < Count; ++i)
+    {
+        FAmbientClimbSurfaceFragment &ClimberSurface = Surfaces.Add_GetRef(Surface);
+        ClimberSurface.Position = FVector2f(
+            RandomStream.FRandRange(-Surface.Extent.X, Surface.Extent.X),
+            RandomStream.FRandRange(0.f, Surface.Extent.Y));
+    }
+
+    CreateClimberEntities(Surfaces);
+}
+
+void UAmbientClimberSubsystem::CreateClimberEntities(TConstArrayView<FAmbientClimbSurfaceFragment> Surfaces)
+{
+    UMassEntitySubsystem *EntitySubsystem = GetWorld()->GetSubsystem<UMassEntitySubsystem>();
+    if (!EntitySubsystem || !ClimberArchetype.IsValid())
+        return;
+
+    FMassEntityManager &EntityManager = EntitySubsystem->GetMutableEntityManager();
+
+    TArray<FMassEntityHandle> Entities;
+    TSharedRef<FMassEntityManager::FEntityCreationContext> CreationContext =
+        EntityManager.BatchCreateEntities(ClimberArchetype, Surfaces.Num(), Entities);
+
+    for (int32 i = 0; i < Entities.Num(); ++i)
+    {
+        EntityManager.GetFragmentDataChecked<FAmbientClimbSurfaceFragment>(Entities[i]) = Surfaces[i];
+
+        FAmbientClimbPhaseFragment &Phase = EntityManager.GetFragmentDataChecked<FAmbientClimbPhaseFragment>(Entities[i]);
+        Phase.RandomStream.Initialize(int32(Entities[i].Index));
+        Phase.Direction = FVector2f(Phase.RandomStream.FRandRange(-0.7f, 0.7f), 1.f).GetSafeNormal();
+    }
+}
+
+bool UAmbientClimberSubsystem::RequestPromotion(const FTransform &Transform, const FAmbientClimbSurfaceFragment &Surface)
+{
+    const UAmbientClimberSettings *Settings = GetDefault<UAmbientClimberSettings>();
+
+    if (PendingPromotions.Num() >= Settings->MaxPromotionsPerFrame)
+        return false;
+    if (PendingPromotions.Num() + PromotedClimbers.Num() >= Settings->MaxPromotedClimbers)
+        return false;
+    if (!PromotedCharacterClass)
+        return false;
+
+    PendingPromotions.Add({Transform, Surface});
+    return true;
+}
+
+void UAmbientClimberSubsystem::UpdateViewerLocations()
+{
+    ViewerLocations.Reset();
+
+    for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+    {
+        const APlayerController *PlayerController = It->Get();
+        if (PlayerController && PlayerController->PlayerCameraManager)
+        {
+            ViewerLocations.Add(PlayerController->PlayerCameraManager->GetCameraLocation());
+        }
+    }
+}
+
+bool UAmbientClimberSubsystem::IsNearAnyViewer(const FVector &Location, float Distance) const
+{
+    for (const FVector &ViewerLocation : ViewerLocations)
+    {
+        if (FVector::DistSquared(ViewerLocation, Location) < FMath::Square(Distance))
+            return true;
+    }
+
+    return false;
+}
+
+void UAmbientClimberSubsystem::ProcessPromotions()
+{
+    if (PendingPromotions.IsEmpty())
+        return;
+
+    // The entities are already gone, a climber that fails to spawn goes back to being one
+    TArray<FAmbientClimbSurfaceFragment, TInlineAllocator<8>> FailedSurfaces;
+
+    for (const FPendingPromotion &Promotion : PendingPromotions)
+    {
+        FActorSpawnParameters SpawnParameters;
+        SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+        AClimbingSystemCharacter *Character = PromotedCharacterClass ? GetWorld()->SpawnActor<AClimbingSystemCharacter>(
+            PromotedCharacterClass,
+            Promotion.Transform.GetLocation(),
+            Promotion.Transform.Rotator(),
+            SpawnParameters) : nullptr;
+
+        if (!Character)
+        {
+            FailedSurfaces.Add(Promotion.Surface);
+            continue;
+        }
+
+        Character->SpawnDefaultController();
+
+        if (UCustomMovementComponent *MovementComponent = Character->GetCustomMovementComponent())
+        {
+            MovementComponent->TryStartClimbingImmediately();
+        }
+
+        PromotedClimbers.Add({Character, Promotion.Surface});
+    }
+
+    PendingPromotions.Reset();
+
+    if (!FailedSurfaces.IsEmpty())
+    {
+        UE_LOG(LogClimbing, Warning, TEXT("%d ambient climbers failed to spawn as %s and stay ambient"), FailedSurfaces.Num(), *GetNameSafe(PromotedCharacterClass));
+        CreateClimberEntities(FailedSurfaces);
+    }
+}
+
+void UAmbientClimberSubsystem::ProcessDemotions()
+{
+    const float DemoteDistance = GetDefault<UAmbientClimberSettings>()->DemoteDistance;
+
+    TArray<FAmbientClimbSurfaceFragment, TInlineAllocator<8>> DemotedSurfaces;
+
+    for (int32 i = PromotedClimbers.Num() - 1; i >= 0; --i)
+    {
+        AClimbingSystemCharacter *Character = PromotedClimbers[i].Character.Get();
+
+        if (!Character)
+        {
+            PromotedClimbers.RemoveAtSwap(i);
+            continue;
+        }
+
+        // Demoted whatever they are doing, a character that never started climbing or fell off would otherwise hold its slot forever
+        if (IsNearAnyViewer(Character->GetActorLocation(), DemoteDistance))
+            continue;
+
+        FAmbientClimbSurfaceFragment &Surface = DemotedSurfaces.Add_GetRef(PromotedClimbers[i].Surface);
+
+        // Carry the character's place on the wall back into surface space, off the wall it resumes where it was promoted
+        const UCustomMovementComponent *MovementComponent = Character->GetCustomMovementComponent();
+        if (MovementComponent && MovementComponent->IsClimbing())
+        {
+            const FVector ToCharacter = Character->GetActorLocation() - Surface.Origin;
+            Surface.Position = FVector2f(
+                FMath::Clamp(float(FVector::DotProduct(ToCharacter, Surface.Right)), -Surface.Extent.X, Surface.Extent.X),
+                FMath::Clamp(float(FVector::DotProduct(ToCharacter, Surface.Up)), 0.f, Surface.Extent.Y));
+        }
+
+        Character->Destroy();
+        PromotedClimbers.RemoveAtSwap(i);
+    }
+
+    if (!DemotedSurfaces.IsEmpty())
+    {
+        CreateClimberEntities(DemotedSurfaces);
+    }
+}
+
+void UAmbientClimberSubsystem::UpdateRepresentation()
+{
+    if (!RepresentationComponent)
+        return;
+
+    const int32 NumInstances = RepresentationComponent->GetInstanceCount();
+    const int32 NumTransforms = RepresentationTransforms.Num();
+
+    if (NumInstances < NumTransforms)
+    {
+        TArray<FTransform> NewInstances(RepresentationTransforms.GetData() + NumInstances, NumTransforms - NumInstances);
+        RepresentationComponent->AddInstances(NewInstances, false, true);
+    }
+    else if (NumInstances > NumTransforms)
+    {
+        TArray<int32> RemovedInstances;
+        for (int32 InstanceIndex = NumTransforms; InstanceIndex < NumInstances; ++InstanceIndex)
+        {
+            RemovedInstances.Add(InstanceIndex);
+        }
+        RepresentationComponent->RemoveInstances(RemovedInstances);
+    }
+
+    if (NumTransforms > 0)
+    {
+        RepresentationComponent->BatchUpdateInstancesTransforms(0, RepresentationTransforms, true, true);
+    }
+}
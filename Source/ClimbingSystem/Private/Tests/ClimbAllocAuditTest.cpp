@@ -0,0 +1,91 @@
+#include "ClimbAllocAudit.h"
+#include "Misc/AutomationTest.h"
+
+// Only monolithic builds can put the counting proxy in place, a modular build has no audit to test
+#if WITH_DEV_AUTOMATION_TESTS && CLIMB_ALLOC_AUDIT && IS_MONOLITHIC
+
+#include "ClimbingSystemCharacter.h"
+#include "Components/CustomMovementComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/World.h"
+
+namespace
+{
+    const TCHAR *ClimbAllocAuditCharacterPath = TEXT("/Game/ClimbingSystem/BP_ClimbingSystemCharacter.BP_ClimbingSystemCharacter_C");
+
+    // The first ticks of a climb are not steady state, see UCustomMovementComponent::TickComponent
+    constexpr int32 MinSteadyTicks = 100;
+    constexpr int32 NumClimbTicks = MinSteadyTicks + ClimbAllocAudit::SteadyStateWarmupTicks + 10;
+    constexpr float ClimbTickTime = 1.f / 60.f;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FClimbSteadyStateAllocTest, "ClimbingSystem.AllocAudit.SteadyStateClimb",
+    EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FClimbSteadyStateAllocTest::RunTest(const FString &Parameters)
+{
+    if (!ClimbAllocAudit::IsInstalled())
+    {
+        AddError(TEXT("The climb allocation audit proxy is not in front of GMalloc, no allocations can be counted"));
+        return false;
+    }
+
+    UClass *CharacterClass = LoadClass<AClimbingSystemCharacter>(nullptr, ClimbAllocAuditCharacterPath);
+    UStaticMesh *CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+
+    if (!TestNotNull(TEXT("Climbing character class"), CharacterClass) || !TestNotNull(TEXT("Wall mesh"), CubeMesh))
+        return false;
+
+    UWorld *World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("ClimbAllocAuditTest"));
+    FWorldContext &WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+    WorldContext.SetCurrentWorld(World);
+
+    World->InitializeActorsForPlay(FURL());
+    World->BeginPlay();
+
+    // A 10 m wall in front of the character, taller than the climb covers over the test
+    AStaticMeshActor *Wall = World->SpawnActor<AStaticMeshActor>(FVector(100.f, 0.f, 0.f), FRotator::ZeroRotator);
+    Wall->SetMobility(EComponentMobility::Movable);
+    Wall->GetStaticMeshComponent()->SetStaticMesh(CubeMesh);
+    Wall->SetActorScale3D(FVector(1.f, 10.f, 10.f));
+
+    AClimbingSystemCharacter *Character = World->SpawnActor<AClimbingSystemCharacter>(CharacterClass, FVector::ZeroVector, FRotator::ZeroRotator);
+    UCustomMovementComponent *Movement = Character ? Character->GetCustomMovementComponent() : nullptr;
+
+    if (TestNotNull(TEXT("Climbing movement component"), Movement))
+    {
+        Movement->bRunPhysicsWithNoController = true;
+
+        if (TestTrue(TEXT("Started climbing the wall"), Movement->TryStartClimbingImmediately()))
+        {
+            const bool bWasEnabled = ClimbAllocAudit::IsEnabled();
+            ClimbAllocAudit::SetEnabled(true);
+            ClimbAllocAudit::ResetStats();
+
+            for (int32 i = 0; i < NumClimbTicks; ++i)
+            {
+                Character->AddMovementInput(FVector::UpVector, 1.f);
+                World->Tick(LEVELTICK_All, ClimbTickTime);
+            }
+
+            const FClimbAllocAuditStats Stats = ClimbAllocAudit::GetStats();
+            ClimbAllocAudit::SetEnabled(bWasEnabled);
+
+            TestTrue(TEXT("Still climbing"), Movement->IsClimbing());
+            TestTrue(FString::Printf(TEXT("%d steady state climb ticks ran"), Stats.NumSteadyTicks), Stats.NumSteadyTicks >= MinSteadyTicks);
+            TestEqual(
+                FString::Printf(TEXT("Steady state climb ticks over the budget of %d allocations, worst made %llu"), ClimbAllocAudit::GetSteadyStateBudget(), Stats.MaxSteadyTickAllocs),
+                Stats.NumTicksOverBudget,
+                0);
+        }
+    }
+
+    GEngine->DestroyWorldContext(World);
+    World->DestroyWorld(false);
+    return true;
+}
+
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimNotifies/AnimNotifyState.h"
+#include "AnimNotifyState_ClimbCancelWindow.generated.h"
+
+class UAnimMontage;
+
+/** A cancel window of a climb montage, in montage time */
+struct FClimbCancelWindow
+{
+	float StartTime = 0.f;
+	float EndTime = 0.f;
+	bool bAllowTraversal = false;
+	bool bAllowLocomotion = false;
+
+	FORCEINLINE bool Contains(float Time) const { return Time >= StartTime && Time <= EndTime; }
+};
+
+/**
+ * Marks where a climb montage may be cut short. Inside a traversal window the next buffered climb
+ * action starts right away, inside a locomotion window movement input ends the action.
+ * Read by UCustomMovementComponent from the montage itself, the notify does nothing when it fires.
+ */
+UCLASS(meta = (DisplayName = "Climb Cancel Window"))
+class CLIMBINGSYSTEM_API UAnimNotifyState_ClimbCancelWindow : public UAnimNotifyState
+{
+	GENERATED_BODY()
+
+public:
+	/** Another climb, hop or vault may start inside this window */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climbing")
+	bool bAllowTraversal = true;
+
+	/** Movement input ends the action inside this window and locomotion resumes */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climbing")
+	bool bAllowLocomotion = false;
+
+	virtual FString GetNotifyName_Implementation() const override;
+
+	static void GatherWindows(const UAnimMontage &Montage, TArray<FClimbCancelWindow> &OutWindows);
+};
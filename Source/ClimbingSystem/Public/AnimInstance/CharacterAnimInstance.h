@@ -2,10 +2,13 @@
 
 #include "CoreMinimal.h"
 #include "Animation/AnimInstance.h"
+#include "Components/CustomMovementComponent.h"
+#include "Components/ClimbLimbIKComponent.h"
 #include "CharacterAnimInstance.generated.h"
 
 class AClimbingSystemCharacter;
 class UCustomMovementComponent;
+class UClimbLimbIKComponent;
 /**
  *
  */
@@ -17,6 +20,7 @@ class CLIMBINGSYSTEM_API UCharacterAnimInstance : public UAnimInstance
 public:
 	virtual void NativeInitializeAnimation() override;
 	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
 
 private:
 	UPROPERTY()
@@ -25,6 +29,9 @@ private:
 	UPROPERTY()
 	UCustomMovementComponent *CustomMovementComponent;
 
+	UPROPERTY()
+	UClimbLimbIKComponent *ClimbLimbIKComponent;
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"))
 	float GroundSpeed;
 	void GetGroundSpeed();
@@ -45,7 +52,28 @@ private:
 	bool bIsClimbing;
 	void GetIsClimbing();
 
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"))
+	bool bIsHanging;
+	void GetIsHanging();
+
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"))
 	FVector ClimbVelocity;
 	void GetClimbVelocity();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Reference, meta = (AllowPrivateAccess = "true"))
+	EClimbPhase ClimbPhase;
+	void GetClimbPhase();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climbing IK", meta = (AllowPrivateAccess = "true"))
+	FClimbLimbIKTarget LeftHandIK;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climbing IK", meta = (AllowPrivateAccess = "true"))
+	FClimbLimbIKTarget RightHandIK;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climbing IK", meta = (AllowPrivateAccess = "true"))
+	FClimbLimbIKTarget LeftFootIK;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Climbing IK", meta = (AllowPrivateAccess = "true"))
+	FClimbLimbIKTarget RightFootIK;
+	void GetLimbIKTargets();
 };
\ No newline at end of file
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ClimbCollisionProxyCommandlet.generated.h"
+
+/**
+ * Generates UClimbCollisionProxyUserData for every static mesh under a content path and saves the meshes.
+ * Run it whenever climbable meshes change; climbers with bUseClimbCollisionProxies query only these proxies.
+ *
+ * UnrealEditor-Cmd.exe ClimbingSystem.uproject -run=ClimbCollisionProxy [-Path=/Game] [-Remove]
+ */
+UCLASS()
+class UClimbCollisionProxyCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UClimbCollisionProxyCommandlet();
+
+	virtual int32 Main(const FString &Params) override;
+};
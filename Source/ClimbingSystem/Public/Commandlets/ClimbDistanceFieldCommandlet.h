@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ClimbDistanceFieldCommandlet.generated.h"
+
+/**
+ * Generates UClimbDistanceFieldUserData for the static meshes under a content path whose default collision
+ * object type is one of the character's ClimbableSurfaceTraceTypes, and saves the meshes. -All skips that
+ * filter for meshes only placed with overridden collision. MaxKB bounds each field, the voxel size grows until it fits.
+ *
+ * UnrealEditor-Cmd.exe ClimbingSystem.uproject -run=ClimbDistanceField [-Path=/Game]
+ *     [-Character=/Game/ClimbingSystem/BP_ClimbingSystemCharacter] [-VoxelSize=10] [-BandVoxels=4] [-MaxKB=256] [-All] [-Remove]
+ */
+UCLASS()
+class UClimbDistanceFieldCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UClimbDistanceFieldCommandlet();
+
+	virtual int32 Main(const FString &Params) override;
+};
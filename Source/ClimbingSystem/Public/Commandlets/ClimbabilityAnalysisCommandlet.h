@@ -0,0 +1,27 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ClimbabilityAnalysisCommandlet.generated.h"
+
+/**
+ * Loads a map headless and classifies every static mesh on the climbable trace channels with the
+ * same rules UCustomMovementComponent uses at runtime (see ClimbSurfaceRules).
+ * Writes a per-map heatmap report to Saved/ClimbAnalysis and flags dead-end and unreachable walls.
+ * World partition maps are loaded one RegionSize square at a time. Walls of touching meshes, such as
+ * stacked modular pieces, are joined in world space before they are flagged.
+ *
+ * UnrealEditor-Cmd.exe ClimbingSystem.uproject -run=ClimbabilityAnalysis -Map=/Game/ThirdPerson/Maps/ThirdPersonMap
+ *     [-Character=/Game/ClimbingSystem/BP_ClimbingSystemCharacter] [-CellSize=200] [-SampleSpacing=100]
+ *     [-MinRegionArea=1] [-RegionSize=51200] [-RegionMargin=1000] [-ConnectTolerance=10] [-Output=<file>]
+ */
+UCLASS()
+class UClimbabilityAnalysisCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UClimbabilityAnalysisCommandlet();
+
+	virtual int32 Main(const FString &Params) override;
+};
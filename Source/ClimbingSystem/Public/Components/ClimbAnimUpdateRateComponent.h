@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Components/CustomMovementComponent.h"
+#include "ClimbAnimUpdateRateComponent.generated.h"
+
+struct FAnimUpdateRateParameters;
+class USkeletalMeshComponent;
+
+/**
+ * Climb aware update rate optimization for the owning character's mesh.
+ * Throttles anim evaluation per LOD and while hanging still on a wall, and forces full rate
+ * for a few frames around climb phase changes so motion warped montages do not pop.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class CLIMBINGSYSTEM_API UClimbAnimUpdateRateComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UClimbAnimUpdateRateComponent();
+
+protected:
+	virtual void OnRegister() override;
+	virtual void BeginPlay() override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
+
+private:
+	void OnAnimUpdateRateParamsCreated(FAnimUpdateRateParameters *Params);
+	void ApplyFrameSkips();
+	void UpdateBudgetSignificance();
+
+	/** Frames skipped between evaluations, indexed by LOD. LODs past the end use the last entry. */
+	UPROPERTY(EditDefaultsOnly, Category = "Character Animation: Update Rate")
+	TArray<int32> LODFrameSkips = {0, 1, 2, 3};
+
+	/** Frames skipped while hanging still on a wall, never fewer than the LOD value */
+	UPROPERTY(EditDefaultsOnly, Category = "Character Animation: Update Rate")
+	int32 IdleClimbFrameSkip = 3;
+
+	/** Full rate frames after every climb phase change */
+	UPROPERTY(EditDefaultsOnly, Category = "Character Animation: Update Rate")
+	int32 PhaseBoundaryFullRateFrames = 4;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Character Animation: Update Rate")
+	bool bInterpolateSkippedFrames = true;
+
+	/** Hand the mesh to the anim budget allocator, which then owns the frame skipping */
+	UPROPERTY(EditDefaultsOnly, Category = "Character Animation: Update Rate")
+	bool bUseAnimBudgetAllocator = false;
+
+	/** Distance at which budget allocator significance reaches zero */
+	UPROPERTY(EditDefaultsOnly, Category = "Character Animation: Update Rate", meta = (EditCondition = "bUseAnimBudgetAllocator"))
+	float BudgetSignificanceDistance = 5000.f;
+
+	/** Significance multiplier while hanging still on a wall */
+	UPROPERTY(EditDefaultsOnly, Category = "Character Animation: Update Rate", meta = (EditCondition = "bUseAnimBudgetAllocator"))
+	float IdleClimbSignificanceScale = 0.25f;
+
+	UPROPERTY()
+	USkeletalMeshComponent *OwnerMesh;
+
+	UPROPERTY()
+	UCustomMovementComponent *CustomMovementComponent;
+
+	FAnimUpdateRateParameters *UpdateRateParams = nullptr;
+	EClimbPhase LastClimbPhase = EClimbPhase::Grounded;
+	int32 FullRateFramesRemaining = 0;
+	bool bFrameSkipsDirty = true;
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Chaos/SimCallbackInput.h"
+#include "Chaos/SimCallbackObject.h"
+#include "Components/ClimbContactManifold.h"
+#include "ClimbAsyncPhysicsSubsystem.generated.h"
+
+class UPrimitiveComponent;
+
+/** Everything the physics thread needs for one fixed climb step, copied on the game thread */
+struct FClimbAsyncClimberInput
+{
+	int32 ClimberId = INDEX_NONE;
+
+	/** Increments every game thread submission, a new serial resets the physics thread state to this transform */
+	uint32 Serial = 0;
+
+	FVector Location = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+	FVector Velocity = FVector::ZeroVector;
+	FVector Acceleration = FVector::ZeroVector;
+
+	float MaxSpeed = 0.f;
+	float BrakingDeceleration = 0.f;
+	float CapsuleTraceRadius = 0.f;
+	float CapsuleTraceHalfHeight = 0.f;
+	float BaseEyeHeight = 0.f;
+	float CornerMinAngle = 0.f;
+	FCollisionObjectQueryParams ObjectQueryParams;
+};
+
+struct FClimbAsyncInput : public Chaos::FSimCallbackInput
+{
+	/** Set with the climbers on the game thread, only used as the query context of physics thread scene queries */
+	const UWorld *World = nullptr;
+
+	TArray<FClimbAsyncClimberInput> Climbers;
+	TArray<int32> RemovedClimbers;
+
+	void Reset()
+	{
+		World = nullptr;
+		Climbers.Reset();
+		RemovedClimbers.Reset();
+	}
+};
+
+/** Climb state after a physics thread step, read back by the game thread */
+struct FClimbAsyncClimberOutput
+{
+	int32 ClimberId = INDEX_NONE;
+	uint32 Serial = 0;
+
+	FVector Location = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+	FVector Velocity = FVector::ZeroVector;
+	FVector SurfaceLocation = FVector::ZeroVector;
+	FVector SurfaceNormal = FVector::ZeroVector;
+
+	/** Contacts of the step's surface sweep without primitive IDs, the game thread fills them in from ContactComponents */
+	FClimbContactManifold Contacts;
+
+	/** Hit component of each contact, only copied on the physics thread and resolved on the game thread */
+	TWeakObjectPtr<UPrimitiveComponent> ContactComponents[FClimbContactManifold::MaxContacts];
+
+	/** Planes of the corner the contacts span, the surface is the facing plane of it rather than the average of both */
+	FClimbCornerFit Corner;
+
+	bool bShouldStop = false;
+	bool bReachedFloor = false;
+	bool bReachedLedge = false;
+};
+
+struct FClimbAsyncOutput : public Chaos::FSimCallbackOutput
+{
+	TArray<FClimbAsyncClimberOutput> Climbers;
+
+	void Reset()
+	{
+		Climbers.Reset();
+	}
+};
+
+/**
+ * Steps every climber submitted this frame on the physics thread, at the fixed physics step,
+ * with climb queries against the physics thread scene.
+ */
+class FClimbAsyncPhysicsCallback : public Chaos::TSimCallbackObject<FClimbAsyncInput, FClimbAsyncOutput, Chaos::ESimCallbackOptions::Presimulate>
+{
+private:
+	struct FClimberState
+	{
+		uint32 Serial = 0;
+		FVector Location = FVector::ZeroVector;
+		FQuat Rotation = FQuat::Identity;
+		FVector Velocity = FVector::ZeroVector;
+	};
+
+	virtual void OnPreSimulate_Internal() override;
+
+	void StepClimber(const UWorld *World, const FClimbAsyncClimberInput &Input, FClimberState &State, float DeltaTime, FClimbAsyncClimberOutput &Output) const;
+
+	/** Physics thread only */
+	TMap<int32, FClimberState> ClimberStates;
+};
+
+/**
+ * Owns the climb physics callback of a world. Climbers submit their input during their movement tick,
+ * which the physics step of the same frame consumes, and read back the latest output on later frames.
+ * Runs on the physics thread with Tick Physics Async enabled in the project physics settings,
+ * inside the synchronous physics tick otherwise.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbAsyncPhysicsSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject *Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld &InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	int32 RegisterClimber();
+	void UnregisterClimber(int32 ClimberId);
+
+	/** Queues Input for the next physics step, the serial is assigned here */
+	void SubmitClimberInput(FClimbAsyncClimberInput &Input);
+
+	/** Latest physics thread result for the climber, nullptr until its first step completed */
+	const FClimbAsyncClimberOutput *GetLatestOutput(int32 ClimberId) const;
+
+private:
+	FClimbAsyncPhysicsCallback *Callback = nullptr;
+
+	TMap<int32, FClimbAsyncClimberOutput> LatestOutputs;
+	TMap<int32, uint32> SubmittedSerials;
+	int32 NextClimberId = 0;
+};
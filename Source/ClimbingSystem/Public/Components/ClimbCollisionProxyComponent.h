@@ -0,0 +1,49 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/PrimitiveComponent.h"
+#include "ClimbCollisionProxyComponent.generated.h"
+
+class UBodySetup;
+class UStaticMeshComponent;
+
+/**
+ * Query-only collision on the ClimbProxy object channel, built from the UClimbCollisionProxyUserData
+ * of the static mesh it is attached to. Instanced meshes are split into spatial clusters by
+ * UClimbCollisionProxySubsystem, one proxy body per cluster.
+ */
+UCLASS(ClassGroup = (Climbing), meta = (BlueprintSpawnableComponent))
+class CLIMBINGSYSTEM_API UClimbCollisionProxyComponent : public UPrimitiveComponent
+{
+	GENERATED_BODY()
+
+public:
+	UClimbCollisionProxyComponent();
+
+	/** Rebuilds the proxy body from the attach parent's mesh, e.g. after regenerating its proxy data */
+	void RebuildProxyBody();
+
+	/** Instances of the attach parent's instanced mesh this proxy covers, all of them when empty. Call before registering */
+	void SetSourceInstances(TArray<int32> &&InInstanceIndices);
+
+	/** Off when the owner builds the body later, UClimbCollisionProxySubsystem spreads the builds over frames */
+	bool bBuildOnRegister = true;
+
+	FORCEINLINE int32 GetNumProxyElements() const { return NumProxyElements; }
+	UStaticMeshComponent *GetSourceMeshComponent() const;
+
+#pragma region Overriden Functions
+	virtual UBodySetup *GetBodySetup() override;
+	virtual FBoxSphereBounds CalcBounds(const FTransform &LocalToWorld) const override;
+
+protected:
+	virtual void OnRegister() override;
+#pragma endregion
+
+private:
+	UPROPERTY(Transient)
+	UBodySetup *ProxyBodySetup;
+
+	TArray<int32> SourceInstances;
+	int32 NumProxyElements = 0;
+};
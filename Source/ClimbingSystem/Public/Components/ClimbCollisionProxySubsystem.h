@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ClimbCollisionProxySubsystem.generated.h"
+
+class ULevel;
+class UClimbCollisionProxyComponent;
+
+/**
+ * Adds a UClimbCollisionProxyComponent to every static mesh component whose mesh carries climb proxy data,
+ * for persistent and streamed in levels alike. Instanced meshes get one proxy per spatial cluster of instances,
+ * capped by Climb.CollisionProxy.MaxShapesPerBody. The proxy bodies are built on the following ticks within
+ * Climb.CollisionProxy.BuildShapesPerFrame instead of during the level load.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbCollisionProxySubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject *Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase &Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld &InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Logs query cost and hit counts of the climb sweep against the art collision and against the proxies */
+	void RunBenchmark(int32 SamplesPerProxy) const;
+
+private:
+	void OnLevelAddedToWorld(ULevel *Level, UWorld *World);
+	void AddProxiesToLevel(ULevel &Level);
+	void AddProxy(AActor &Actor, UStaticMeshComponent &MeshComponent, TArray<int32> &&InstanceIndices);
+	void AddInstancedProxies(AActor &Actor, UStaticMeshComponent &MeshComponent, int32 ElementsPerInstance);
+
+	TArray<TWeakObjectPtr<UClimbCollisionProxyComponent>> ProxyComponents;
+
+	/** Registered proxies whose bodies are not built yet, oldest first from NextPendingBuild */
+	TArray<TWeakObjectPtr<UClimbCollisionProxyComponent>> PendingBuilds;
+	int32 NextPendingBuild = 0;
+	FDelegateHandle LevelAddedHandle;
+};
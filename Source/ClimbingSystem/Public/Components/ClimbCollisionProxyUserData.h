@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/AssetUserData.h"
+#include "PhysicsEngine/AggregateGeom.h"
+#include "ClimbCollisionProxyUserData.generated.h"
+
+class UStaticMesh;
+
+struct FClimbCollisionProxyBuildSettings
+{
+	/** Triangles within this angle of a patch seed and this far from its plane join the patch */
+	float PatchNormalTolerance = 25.f;
+	float PatchPlaneTolerance = 15.f;
+	float PatchThickness = 10.f;
+	float MinPatchArea = 400.f;
+	int32 MaxPatches = 48;
+
+	/** Convex edges between two patches sharper than this become ledge capsules */
+	float LedgeMinAngle = 45.f;
+	float LedgeRadius = 5.f;
+	int32 MaxLedges = 32;
+
+	/** Meshes no larger than this in every axis are covered by a single vault box */
+	float CompactMeshMaxSize = 150.f;
+};
+
+/**
+ * Simplified climb-only collision generated from a static mesh by UClimbCollisionProxyCommandlet.
+ * Instanced in the world by UClimbCollisionProxyComponent on the ClimbProxy object channel.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbCollisionProxyUserData : public UAssetUserData
+{
+	GENERATED_BODY()
+
+public:
+	/** Mesh space planar patch boxes, ledge edge capsules, or one vault box for low and compact meshes */
+	UPROPERTY(VisibleAnywhere, Category = "Climb Proxy")
+	FKAggregateGeom ProxyGeometry;
+
+	UPROPERTY(VisibleAnywhere, Category = "Climb Proxy")
+	int32 SourceTriangleCount = 0;
+
+	void Generate(const UStaticMesh &StaticMesh, const FClimbCollisionProxyBuildSettings &Settings);
+
+	static UClimbCollisionProxyUserData *Get(const UStaticMesh *StaticMesh);
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EClimbCornerType : uint8
+{
+	None,
+	/** The faces turn toward each other, the climber pivots in the corner */
+	Inner,
+	/** The faces turn away from each other, the climber wraps around the edge */
+	Outer
+};
+
+/** Two planes fitted to the contacts where the climber touches both faces of a corner */
+struct FClimbCornerFit
+{
+	EClimbCornerType Type = EClimbCornerType::None;
+	FVector Normals[2];
+	FVector Points[2];
+
+	/** Point on the line the planes meet along, level with the contacts, and the line direction */
+	FVector EdgePoint;
+	FVector EdgeDirection;
+
+	FORCEINLINE bool IsCorner() const { return Type != EClimbCornerType::None; }
+	FORCEINLINE void Reset() { Type = EClimbCornerType::None; }
+
+	/** The plane the climber faces more directly */
+	FORCEINLINE int32 GetFacingPlane(const FVector &Forward) const
+	{
+		return FVector::DotProduct(Forward, Normals[0]) <= FVector::DotProduct(Forward, Normals[1]) ? 0 : 1;
+	}
+};
+
+/**
+ * Fixed capacity, structure-of-arrays set of climb surface contacts.
+ * Keeps only what the climb math reads from the capsule sweep, most relevant hits first,
+ * and matches contacts with the previous update so each one keeps a persistent ID.
+ */
+struct CLIMBINGSYSTEM_API FClimbContactManifold
+{
+	static constexpr int32 MaxContacts = 8;
+
+	/** Contacts on the same primitive closer than this to a previous contact keep its ID */
+	static constexpr float ContactMatchDistance = 20.f;
+
+	FVector Positions[MaxContacts];
+	FVector Normals[MaxContacts];
+	uint32 PrimitiveIds[MaxContacts];
+	uint32 ContactIds[MaxContacts];
+	int32 Num = 0;
+
+	/** Contacts in the space of the climbed primitive, the best contact's, so they can follow it without a new sweep */
+	FVector LocalPositions[MaxContacts];
+	FVector LocalNormals[MaxContacts];
+
+	FORCEINLINE bool IsEmpty() const { return Num == 0; }
+	FORCEINLINE void Reset() { Num = 0; }
+
+	/** Indices of the MaxContacts most relevant hits, most relevant first, returns their count. Touches no hit component */
+	static int32 SelectMostRelevantHits(const TArray<FHitResult> &Hits, const FVector &ProbeLocation, const FVector &ProbeForward, int32 (&OutHitIndices)[MaxContacts]);
+
+	/** Keeps the MaxContacts most relevant hits sorted by relevance and carries contact IDs over from the previous update */
+	void Update(const TArray<FHitResult> &Hits, const FVector &ProbeLocation, const FVector &ProbeForward);
+
+	/** Takes the contacts of a manifold updated elsewhere, such as the physics thread climb step, and carries this one's contact IDs over to them */
+	void UpdateFrom(const FClimbContactManifold &Source);
+
+	/** Stores the contacts on the best contact's primitive in the space of BaseTransform, that primitive's transform */
+	void StoreLocalSpace(const FTransform &BaseTransform);
+
+	/** Moves the contacts on the best contact's primitive along with BaseTransform, the ones on other primitives can't follow and are dropped */
+	void UpdateFromLocalSpace(const FTransform &BaseTransform);
+
+	/** True when some contacts lie on another primitive than the best contact, such as a corner between two meshes */
+	bool SpansMultiplePrimitives() const;
+
+	FVector GetAverageLocation() const;
+	FVector GetAverageNormal() const;
+	int32 FindContactIndexById(uint32 ContactId) const;
+
+	/** Splits the contacts between two planes at least MinCornerAngle degrees apart, false on a single face */
+	bool FitCorner(FClimbCornerFit &OutCorner, float MinCornerAngle) const;
+
+private:
+	/** Gives the current contacts the IDs of the previous contacts they match, new IDs otherwise */
+	void CarryContactIds(const FVector *PreviousPositions, const uint32 *PreviousPrimitiveIds, const uint32 *PreviousContactIds, int32 NumPrevious);
+
+	uint32 NextContactId = 1;
+};
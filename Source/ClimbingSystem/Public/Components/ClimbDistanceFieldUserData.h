@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/AssetUserData.h"
+#include "ClimbDistanceFieldUserData.generated.h"
+
+class UPrimitiveComponent;
+class UStaticMesh;
+struct FClimbMeshGeometry;
+
+struct FClimbDistanceFieldBuildSettings
+{
+	/** Finest sample spacing, doubled until the field fits in MaxBytes */
+	float VoxelSize = 10.f;
+
+	/** Distances are only stored this many voxels to either side of the surface */
+	int32 BandVoxels = 4;
+
+	int32 MaxBytes = 256 * 1024;
+};
+
+/**
+ * Narrow band signed distance field of a static mesh, generated by the ClimbDistanceField commandlet.
+ * Samples are quantized to a byte and kept in 8^3 bricks that share their border samples, so a query reads
+ * one brick and is a single trilinear lookup. Bricks without any surface near them are not stored.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbDistanceFieldUserData : public UAssetUserData
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int32 BrickSize = 8;
+	static constexpr int32 BrickCells = BrickSize - 1;
+	static constexpr int32 BrickSampleCount = BrickSize * BrickSize * BrickSize;
+
+	/** Mesh space position of the first sample */
+	UPROPERTY(VisibleAnywhere, Category = "Climb Distance Field")
+	FVector3f Origin = FVector3f::ZeroVector;
+
+	UPROPERTY(VisibleAnywhere, Category = "Climb Distance Field")
+	float VoxelSize = 0.f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Climb Distance Field")
+	float BandDistance = 0.f;
+
+	UPROPERTY(VisibleAnywhere, Category = "Climb Distance Field")
+	FIntVector BrickGridSize = FIntVector::ZeroValue;
+
+	UPROPERTY(VisibleAnywhere, Category = "Climb Distance Field")
+	int32 SourceTriangleCount = 0;
+
+	/** Brick index per brick grid cell, INDEX_NONE where the surface is farther than the band */
+	UPROPERTY()
+	TArray<int32> BrickTable;
+
+	/** BrickSampleCount bytes per brick, 0 at -BandDistance and 255 at +BandDistance */
+	UPROPERTY()
+	TArray<uint8> BrickSamples;
+
+	void Generate(const UStaticMesh &StaticMesh, const FClimbDistanceFieldBuildSettings &Settings);
+
+	/** Mesh space distance and gradient, false outside the band or the field */
+	bool Sample(const FVector3f &MeshPosition, float &OutDistance, FVector3f &OutGradient) const;
+
+	/** World space distance and surface normal under a component transform */
+	bool SampleWorld(const FTransform &ComponentTransform, const FVector &WorldPosition, float &OutDistance, FVector &OutNormal) const;
+
+	int32 GetFieldBytes() const;
+	FORCEINLINE bool IsEmpty() const { return BrickSamples.IsEmpty(); }
+
+	static UClimbDistanceFieldUserData *Get(const UStaticMesh *StaticMesh);
+
+	/** Field of the mesh a plain static mesh component renders, instanced components are not supported */
+	static const UClimbDistanceFieldUserData *Get(const UPrimitiveComponent *Primitive);
+
+private:
+	bool Build(const FClimbMeshGeometry &Geometry, const FBox3f &Bounds, float InVoxelSize, int32 BandVoxels, int32 MaxBytes);
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "Chaos/ChaosEngineInterface.h"
+#include "ClimbEffectsSettings.generated.h"
+
+class USoundBase;
+class UNiagaraSystem;
+
+UENUM(BlueprintType)
+enum class EClimbEffect : uint8
+{
+	HandPlant,
+	FootScuff,
+	LedgeGrab,
+	VaultImpact,
+	Num UMETA(Hidden)
+};
+
+/** Sound and particles of one climb effect on one surface type */
+USTRUCT()
+struct FClimbSurfaceEffect
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, Category = "Climb Effects")
+	EClimbEffect Effect = EClimbEffect::HandPlant;
+
+	/** Default is used for every surface type without its own entry */
+	UPROPERTY(EditAnywhere, Category = "Climb Effects")
+	TEnumAsByte<EPhysicalSurface> SurfaceType = SurfaceType_Default;
+
+	UPROPERTY(EditAnywhere, Category = "Climb Effects")
+	TSoftObjectPtr<USoundBase> Sound;
+
+	UPROPERTY(EditAnywhere, Category = "Climb Effects")
+	TSoftObjectPtr<UNiagaraSystem> Niagara;
+};
+
+/**
+ * Hand plant, foot scuff, ledge grab and vault impact effects per physical surface type, and the
+ * budget UClimbEffectsSubsystem plays them under.
+ */
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "Climb Effects"))
+class CLIMBINGSYSTEM_API UClimbEffectsSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(config, EditAnywhere, Category = "Effects")
+	TArray<FClimbSurfaceEffect> Effects;
+
+	/** Effects farther than this from every local view are dropped before their surface is looked up */
+	UPROPERTY(config, EditAnywhere, Category = "Budget")
+	float CullDistance = 3000.f;
+
+	/** Requests of the same effect this close together in one frame play once */
+	UPROPERTY(config, EditAnywhere, Category = "Budget")
+	float MergeDistance = 25.f;
+
+	UPROPERTY(config, EditAnywhere, Category = "Budget")
+	int32 MaxSpawnsPerFrame = 8;
+
+	UPROPERTY(config, EditAnywhere, Category = "Budget")
+	int32 MaxSpawnsPerEffectPerFrame = 4;
+
+	/** Pooled audio components, an effect is dropped when all of them are still playing */
+	UPROPERTY(config, EditAnywhere, Category = "Pools")
+	int32 AudioPoolSize = 16;
+
+	UPROPERTY(config, EditAnywhere, Category = "Pools")
+	int32 NiagaraPoolSize = 16;
+
+	/** The surface type cache starts over once it holds this many primitives */
+	UPROPERTY(config, EditAnywhere, Category = "Pools")
+	int32 MaxCachedSurfaces = 1024;
+};
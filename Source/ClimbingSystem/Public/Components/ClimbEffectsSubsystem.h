@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "Components/ClimbEffectsSettings.h"
+#include "ClimbEffectsSubsystem.generated.h"
+
+class UAudioComponent;
+class UNiagaraComponent;
+class UPhysicalMaterial;
+class UPrimitiveComponent;
+class UCustomMovementComponent;
+struct FClimbEvent;
+
+/** Climb effect work since the last Climb.ReportEffects */
+struct FClimbEffectStats
+{
+	int32 NumRequested = 0;
+	int32 NumCulled = 0;
+	int32 NumMerged = 0;
+	int32 NumOverBudget = 0;
+	int32 NumSpawned = 0;
+	int32 NumPoolExhausted = 0;
+	int32 NumSurfaceLookups = 0;
+	int32 NumSurfaceCacheMisses = 0;
+};
+
+/**
+ * Plays climb effects from pooled audio and Niagara components. Requests are culled by distance to the
+ * local views as they come in, the surface type comes from a per primitive cache, and the requests of a
+ * frame are spawned together on the subsystem tick, closest first, within a per frame budget.
+ * Limb plants come from UClimbLimbIKComponent, ledge grabs and vault impacts from the climb events.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbEffectsSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject *Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld &InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Queues Effect for this frame's spawn batch. HitMaterial, when known, decides the surface type over the primitive's cached one */
+	void RequestEffect(EClimbEffect Effect, const FVector &Location, const FVector &Normal, UPrimitiveComponent *Surface, const UPhysicalMaterial *HitMaterial = nullptr);
+
+	/** Plays ledge grab and vault impact effects from the climber's events */
+	void RegisterClimber(UCustomMovementComponent &Climber);
+
+	FORCEINLINE FClimbEffectStats &GetStats() { return Stats; }
+	FORCEINLINE int32 GetAudioPoolSize() const { return AudioPool.Num(); }
+	FORCEINLINE int32 GetNiagaraPoolSize() const { return NiagaraPool.Num(); }
+	int32 GetNumActiveAudio() const;
+	int32 GetNumActiveNiagara() const;
+
+private:
+	struct FResolvedEffect
+	{
+		USoundBase *Sound = nullptr;
+		UNiagaraSystem *Niagara = nullptr;
+	};
+
+	struct FEffectRequest
+	{
+		EClimbEffect Effect;
+		EPhysicalSurface SurfaceType;
+		FVector Location;
+		FVector Normal;
+		float ViewDistanceSquared;
+	};
+
+	void LoadEffects();
+	void CreatePools(UWorld &InWorld);
+	void UpdateViewerLocations();
+	void SpawnPendingEffects();
+	bool PlaySound(USoundBase *Sound, const FEffectRequest &Request);
+	bool PlayNiagara(UNiagaraSystem *System, const FEffectRequest &Request);
+	const FResolvedEffect &GetResolvedEffect(EClimbEffect Effect, EPhysicalSurface SurfaceType) const;
+	EPhysicalSurface GetSurfaceType(UPrimitiveComponent *Surface, const UPhysicalMaterial *HitMaterial);
+	void CacheSurfaceType(UPrimitiveComponent &Surface, EPhysicalSurface SurfaceType);
+	float GetViewDistanceSquared(const FVector &Location) const;
+	void OnClimbEvent(const FClimbEvent &Event, TWeakObjectPtr<UCustomMovementComponent> WeakClimber);
+
+	/** Indexed by effect and surface type */
+	TArray<FResolvedEffect> ResolvedEffects;
+
+	/** Keeps the assets ResolvedEffects points at loaded */
+	UPROPERTY()
+	TArray<UObject *> LoadedEffectAssets;
+
+	UPROPERTY()
+	AActor *PoolActor;
+
+	UPROPERTY()
+	TArray<UAudioComponent *> AudioPool;
+
+	UPROPERTY()
+	TArray<UNiagaraComponent *> NiagaraPool;
+
+	int32 NextAudio = 0;
+	int32 NextNiagara = 0;
+
+	TMap<TObjectKey<UPrimitiveComponent>, EPhysicalSurface> SurfaceTypes;
+	TArray<FVector> ViewerLocations;
+	TArray<FEffectRequest> PendingRequests;
+	FClimbEffectStats Stats;
+};
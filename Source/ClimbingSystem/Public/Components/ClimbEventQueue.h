@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ClimbEventQueue.generated.h"
+
+class UAnimMontage;
+
+UENUM(BlueprintType)
+enum class EClimbActionEndReason : uint8
+{
+	Completed,
+	Cancelled UMETA(ToolTip = "Cut short inside a cancel window"),
+	Interrupted
+};
+
+enum class EClimbEventType : uint8
+{
+	/** Entered climbing, hanging or a climb spline from outside climbing */
+	ClimbStarted,
+	ClimbEnded,
+	/** A climb, vault or hop montage started, the event carries the montage */
+	ActionStarted,
+	/** Sent exactly once per climb action, after its state transition ran */
+	ActionFinished,
+	/** Climbed up to a ledge, about to climb over or hang from it */
+	LedgeReached,
+	CornerStarted,
+	Num
+};
+
+/** One climb state change, posted from inside the movement update */
+struct FClimbEvent
+{
+	EClimbEventType Type = EClimbEventType::ClimbStarted;
+	uint64 Frame = 0;
+
+	/** Action events only */
+	UAnimMontage *Montage = nullptr;
+	EClimbActionEndReason Reason = EClimbActionEndReason::Completed;
+};
+
+/** Where listener work for climb events was spent, deferred to the end of the tick or inside the movement step */
+struct FClimbEventStats
+{
+	int32 NumPosted = 0;
+	int32 NumCoalesced = 0;
+	int32 NumDispatched = 0;
+	uint64 DispatchCycles = 0;
+
+	/** Dispatched straight from the post with Climb.DeferEvents off */
+	int32 NumDispatchedInStep = 0;
+	uint64 InStepDispatchCycles = 0;
+
+	int32 NumCapsuleResizes = 0;
+	int32 NumOverlapUpdates = 0;
+	int32 NumOverlapUpdatesInStep = 0;
+};
+
+/**
+ * Climb events of one climber waiting for the end of its movement tick. Leaving and entering climbing in
+ * the same frame cancel out and repeats of a state event collapse into the latest, so listeners only see
+ * the net change. Action events are never merged.
+ */
+struct CLIMBINGSYSTEM_API FClimbEventQueue
+{
+	static constexpr int32 NumInlineEvents = 8;
+	using FEventArray = TArray<FClimbEvent, TInlineAllocator<NumInlineEvents>>;
+
+	FClimbEventStats Stats;
+
+	void Post(const FClimbEvent &Event);
+
+	/** Moves the pending events to OutEvents in post order, events posted while they are handled wait for the next take */
+	void TakePending(FEventArray &OutEvents);
+
+	FORCEINLINE bool HasPending() const { return !Pending.IsEmpty(); }
+
+private:
+	FEventArray Pending;
+};
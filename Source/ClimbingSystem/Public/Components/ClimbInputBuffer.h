@@ -0,0 +1,67 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EClimbInputAction : uint8
+{
+	Climb,
+	Hop,
+	Num
+};
+
+/** One buffered press, with what the action needs captured at press time */
+struct FClimbBufferedInput
+{
+	bool bPending = false;
+	uint64 PressFrame = 0;
+	double PressTime = 0.0;
+
+	/** Climb: whether the press was to grab on (true) or to let go (false) */
+	bool bAttemptClimbing = false;
+
+	/** Hop: input direction in the climber's space, projected on its up axis */
+	float VerticalInput = 0.f;
+};
+
+/** Input to action latency of one action, in frames */
+struct FClimbInputLatency
+{
+	int32 NumFired = 0;
+	int32 NumBuffered = 0;
+	int32 NumExpired = 0;
+	uint64 TotalFrames = 0;
+	int32 MaxFrames = 0;
+
+	float GetAverageFrames() const { return NumFired > 0 ? float(TotalFrames) / NumFired : 0.f; }
+};
+
+/**
+ * Holds the latest press of each climb action for its window, so presses made while a montage
+ * or transition blocks the action fire on the first frame it is allowed again.
+ */
+struct CLIMBINGSYSTEM_API FClimbInputBuffer
+{
+	static constexpr int32 NumActions = int32(EClimbInputAction::Num);
+
+	/** Seconds a press stays buffered, per action */
+	float Windows[NumActions] = {};
+
+	void Press(EClimbInputAction Action, const FClimbBufferedInput &Input);
+
+	/** Drops presses older than their window, false when nothing is pending for Action */
+	bool UpdatePending(EClimbInputAction Action, double Time);
+
+	/** Takes the pending press and records its latency */
+	FClimbBufferedInput Consume(EClimbInputAction Action, uint64 Frame);
+
+	/** Marks the pending press as having waited at least one frame */
+	void MarkBlocked(EClimbInputAction Action);
+
+	const FClimbBufferedInput &GetPending(EClimbInputAction Action) const { return Pending[int32(Action)]; }
+	const FClimbInputLatency &GetLatency(EClimbInputAction Action) const { return Latencies[int32(Action)]; }
+
+private:
+	FClimbBufferedInput Pending[NumActions];
+	bool bPendingBlocked[NumActions] = {};
+	FClimbInputLatency Latencies[NumActions];
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Straight piece of ledge edge on the wall face, fitted once when a hang starts and then extended
+ * incrementally as the hang validation probe finds more ledge past either end.
+ */
+struct CLIMBINGSYSTEM_API FClimbLedgeSegment
+{
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+
+	FVector Direction = FVector::ZeroVector;
+
+	/** Horizontal, pointing out of the wall */
+	FVector WallNormal = FVector::ZeroVector;
+
+	/** Keeps FallbackDirection while the segment is still a single point */
+	FORCEINLINE void SetEndpoints(const FVector &InStart, const FVector &InEnd, const FVector &FallbackDirection)
+	{
+		Start = InStart;
+		End = InEnd;
+		Direction = (End - Start).IsNearlyZero() ? FallbackDirection : (End - Start).GetSafeNormal();
+	}
+
+	FORCEINLINE bool IsValid() const { return !WallNormal.IsNearlyZero(); }
+	FORCEINLINE void Reset() { *this = FClimbLedgeSegment(); }
+	FORCEINLINE float GetLength() const { return FVector::Dist(Start, End); }
+	FORCEINLINE const FVector &GetDirection() const { return Direction; }
+
+	/** Distance along the segment from Start, not clamped */
+	FORCEINLINE float GetDistanceAlong(const FVector &Location) const
+	{
+		return FVector::DotProduct(Location - Start, GetDirection());
+	}
+
+	/** Point on the edge line, extrapolated past either end */
+	FORCEINLINE FVector GetPointAtDistance(float Distance) const
+	{
+		return Start + GetDirection() * Distance;
+	}
+};
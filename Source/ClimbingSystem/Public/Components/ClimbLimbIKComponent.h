@@ -0,0 +1,146 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+#include "ClimbLimbIKComponent.generated.h"
+
+class UCustomMovementComponent;
+class UClimbQueryBudgetSubsystem;
+class UClimbEffectsSubsystem;
+class UPhysicalMaterial;
+class USkeletalMeshComponent;
+
+UENUM(BlueprintType)
+enum class EClimbLimb : uint8
+{
+	LeftHand,
+	RightHand,
+	LeftFoot,
+	RightFoot,
+	Num UMETA(Hidden)
+};
+
+USTRUCT(BlueprintType)
+struct FClimbLimbIKTarget
+{
+	GENERATED_BODY()
+
+	/** World space effector location */
+	UPROPERTY(BlueprintReadOnly, Category = "Climbing IK")
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Climbing IK")
+	FVector Normal = FVector::ZeroVector;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Climbing IK")
+	float Alpha = 0.f;
+};
+
+/** Limb targets of one frame, copied out under a lock for the anim worker thread */
+struct FClimbLimbIKSnapshot
+{
+	FClimbLimbIKTarget Limbs[int32(EClimbLimb::Num)];
+};
+
+/**
+ * Plants hands and feet on the wall while climbing and hanging. A limb keeps its planted point until
+ * it drifts too far from where the pose puts it, then takes a nearby climb contact or, failing that,
+ * is probed again. The probes of one frame go out as one batch of async traces, every few frames for
+ * distant characters, and hanging hands come straight from the ledge segment.
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class CLIMBINGSYSTEM_API UClimbLimbIKComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UClimbLimbIKComponent();
+
+	/** Safe to call from any thread */
+	void ReadSnapshot(FClimbLimbIKSnapshot &OutSnapshot) const;
+
+protected:
+	virtual void OnRegister() override;
+	virtual void BeginPlay() override;
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
+
+private:
+	struct FPlantedLimb
+	{
+		/** In the space of Base when there is one, world space otherwise */
+		FVector Location = FVector::ZeroVector;
+		FVector Normal = FVector::ZeroVector;
+		TWeakObjectPtr<UPrimitiveComponent> Base;
+		bool bOnBase = false;
+		bool bPlanted = false;
+		bool bProbePending = false;
+	};
+
+	FVector GetNominalLimbLocation(EClimbLimb Limb, const FVector &SurfaceLocation, const FVector &SurfaceNormal) const;
+	int32 GetProbeInterval() const;
+	void PlantLimb(FPlantedLimb &Limb, const FVector &Location, const FVector &Normal, UPrimitiveComponent *Base, const UPhysicalMaterial *HitMaterial = nullptr);
+	bool GetPlantedLocation(const FPlantedLimb &Limb, FVector &OutLocation, FVector &OutNormal) const;
+	bool TryReuseClimbContact(const FVector &NominalLocation, const FVector &SurfaceNormal, FVector &OutLocation, FVector &OutNormal) const;
+	void UpdateClimbLimbs(bool bProbeFrame);
+	void UpdateHangLimbs(bool bProbeFrame);
+	void UpdateWallLimb(EClimbLimb Limb, const FVector &SurfaceLocation, const FVector &SurfaceNormal, bool bProbeFrame, bool bReuseClimbContacts);
+	void ProbeLimb(EClimbLimb Limb, const FVector &NominalLocation, const FVector &SurfaceNormal);
+	void OnLimbProbeDone(const FTraceHandle &Handle, FTraceDatum &Datum);
+	void UpdateSnapshot(float DeltaTime, bool bActive);
+
+	/** Hand location relative to the character on the wall plane, mirrored for the left hand */
+	UPROPERTY(EditDefaultsOnly, Category = "Character Animation: Climbing IK")
+	FVector HandOffset = FVector(0.f, 25.f, 70.f);
+
+	UPROPERTY(EditDefaultsOnly, Category = "Character Animation: Climbing IK")
+	FVector FootOffset = FVector(0.f, 18.f, -75.f);
+
+	/** Probe length to each side of the wall plane */
+	UPROPERTY(EditDefaultsOnly, Category = "Character Animation: Climbing IK")
+	float ProbeDepth = 30.f;
+
+	/** A planted limb stays put until the pose has moved this far away from it */
+	UPROPERTY(EditDefaultsOnly, Category = "Character Animation: Climbing IK")
+	float ReplantDistance = 20.f;
+
+	/** A climb contact this close to where a limb needs to go is used instead of probing */
+	UPROPERTY(EditDefaultsOnly, Category = "Character Animation: Climbing IK")
+	float ContactReuseRadius = 12.f;
+
+	/** Beyond this distance from every local view, limbs are probed every DistantProbeInterval frames */
+	UPROPERTY(EditDefaultsOnly, Category = "Character Animation: Climbing IK")
+	float FullRateDistance = 1500.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Character Animation: Climbing IK", meta = (ClampMin = "1"))
+	int32 DistantProbeInterval = 4;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Character Animation: Climbing IK")
+	float LimbMoveSpeed = 15.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Character Animation: Climbing IK")
+	float AlphaBlendSpeed = 8.f;
+
+	UPROPERTY()
+	UCustomMovementComponent *CustomMovementComponent;
+
+	UPROPERTY()
+	USkeletalMeshComponent *OwnerMesh;
+
+	UPROPERTY()
+	UClimbQueryBudgetSubsystem *QueryBudget;
+
+	UPROPERTY()
+	UClimbEffectsSubsystem *ClimbEffects;
+
+	FPlantedLimb PlantedLimbs[int32(EClimbLimb::Num)];
+
+	/** Smoothed targets, game thread only */
+	FClimbLimbIKTarget Targets[int32(EClimbLimb::Num)];
+
+	FTraceDelegate LimbProbeDelegate;
+
+	mutable FRWLock SnapshotLock;
+	FClimbLimbIKSnapshot Snapshot;
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UStaticMesh;
+
+/** Welded, local space triangle soup of a static mesh LOD0, as used by the offline climb tools */
+struct CLIMBINGSYSTEM_API FClimbMeshGeometry
+{
+	TArray<FVector3f> Positions;
+	TArray<FVector3f> VertexNormals;
+	TArray<int32> Indices;
+
+	void Build(const UStaticMesh &StaticMesh);
+	FORCEINLINE int32 GetNumTriangles() const { return Indices.Num() / 3; }
+};
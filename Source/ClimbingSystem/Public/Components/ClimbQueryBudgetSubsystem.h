@@ -0,0 +1,70 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/StaticArray.h"
+#include "ClimbQueryBudgetSubsystem.generated.h"
+
+class APawn;
+
+UENUM()
+enum class EClimbQueryPriority : uint8
+{
+	/** Player controlled climbers, locally or on the server. Never deferred, a refused probe would drop the player's input, but counted against the budget */
+	LocalPlayer,
+	NearAI,
+	FarAI,
+	/** Probes nothing waits on yet, such as ledge grab candidates and limb placement */
+	Speculative,
+	Num UMETA(Hidden)
+};
+
+/** Scene queries granted and deferred during one frame, per priority */
+struct FClimbQueryBudgetFrame
+{
+	uint64 FrameNumber = 0;
+	int32 Budget = 0;
+	int32 Granted[int32(EClimbQueryPriority::Num)] = {};
+	int32 Deferred[int32(EClimbQueryPriority::Num)] = {};
+
+	/** Deferred probes granted because their deadline passed */
+	int32 Overdue = 0;
+
+	int32 GetNumGranted() const;
+	int32 GetNumDeferred() const;
+};
+
+/**
+ * World wide budget of climb scene queries per frame. Climb probes ask for their queries before running them,
+ * each priority may only fill a share of the budget so the lower ones give way first, and a refused probe keeps
+ * its last result. A probe that has waited past its deadline may use the whole remaining budget. Only player movement
+ * queries run past it, speculative probes of players are deferred like AI ones.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbQueryBudgetSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static constexpr int32 HistoryFrames = 120;
+
+	virtual bool ShouldCreateSubsystem(UObject *Outer) const override;
+
+	/** False when the probe should be deferred and its last result reused. RequiredByTime is world time */
+	bool TryAcquire(EClimbQueryPriority Priority, int32 NumQueries, double RequiredByTime);
+
+	EClimbQueryPriority GetPriority(const APawn &Pawn);
+
+	void LogReport() const;
+
+private:
+	void BeginFrame();
+
+	FClimbQueryBudgetFrame CurrentFrame;
+	TStaticArray<FClimbQueryBudgetFrame, HistoryFrames> History;
+	int32 HistoryHead = INDEX_NONE;
+	int32 HistoryNum = 0;
+
+	/** Local cameras, and player pawns on a server, gathered once per frame */
+	TArray<FVector> ViewerLocations;
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Containers/StaticArray.h"
+#include "ClimbRewindSubsystem.generated.h"
+
+class ULevel;
+class UPrimitiveComponent;
+
+/** Transform history of one moving primitive, a fixed ring of the latest samples */
+struct FClimbRewindTrack
+{
+	static constexpr int32 NumSamples = 32;
+
+	struct FSample
+	{
+		double Time = 0.0;
+		FVector Location = FVector::ZeroVector;
+		FQuat Rotation = FQuat::Identity;
+	};
+
+	TWeakObjectPtr<UPrimitiveComponent> Primitive;
+	TStaticArray<FSample, NumSamples> Samples;
+	int32 Head = INDEX_NONE;
+	int32 Num = 0;
+
+	void Record(double Time, const FTransform &Transform);
+
+	/** Interpolated transform at Time, clamped to the recorded range. False until the first sample */
+	bool GetTransformAt(double Time, const FVector &Scale, FTransform &OutTransform) const;
+};
+
+/**
+ * Server side history of replicated movable primitives, so client climb requests can be checked
+ * against the geometry the client saw. Rewound queries run the normal world query without the
+ * primitives that moved since then, plus one component query per moved primitive with the query
+ * moved into where that primitive was. The scene itself is never touched.
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbRewindSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject *Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase &Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld &InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Records Primitive from now on, for climbable movers the automatic scan does not pick up */
+	void TrackPrimitive(UPrimitiveComponent *Primitive);
+
+	/** Rewinding stops for the rest of the tick once this tick's rewound component queries ran out */
+	bool HasQueryBudget() const;
+
+	/** Time clamped to the recorded history */
+	double ClampRewindTime(double Time) const;
+
+	/** ExcludedPrimitive is queried as it is now, for the base the querying character moves with */
+	void SweepMultiAtTime(TArray<FHitResult> &OutHits, const FVector &Start, const FVector &End, const FQuat &Rotation, const FCollisionShape &Shape,
+		const FCollisionObjectQueryParams &ObjectParams, const FCollisionQueryParams &Params, double Time, const UPrimitiveComponent *ExcludedPrimitive);
+
+	FHitResult LineTraceSingleAtTime(const FVector &Start, const FVector &End,
+		const FCollisionObjectQueryParams &ObjectParams, const FCollisionQueryParams &Params, double Time, const UPrimitiveComponent *ExcludedPrimitive);
+
+private:
+	struct FRewoundPrimitive
+	{
+		UPrimitiveComponent *Primitive;
+
+		/** Current world space to world space at the rewind time */
+		FTransform NowToThen;
+	};
+
+	void OnLevelAddedToWorld(ULevel *Level, UWorld *World);
+	void OnActorSpawned(AActor *Actor);
+	void TrackActor(const AActor &Actor);
+
+	/** Fills OutRewound with the primitives that moved since Time and adds them to the ignore list of OutWorldParams */
+	void GatherRewoundPrimitives(double Time, const FCollisionObjectQueryParams &ObjectParams, const UPrimitiveComponent *ExcludedPrimitive,
+		FCollisionQueryParams &OutWorldParams, TArray<FRewoundPrimitive, TInlineAllocator<8>> &OutRewound) const;
+
+	TArray<FClimbRewindTrack> Tracks;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle ActorSpawnedHandle;
+	int32 NumQueriesThisTick = 0;
+	bool bRecording = false;
+};
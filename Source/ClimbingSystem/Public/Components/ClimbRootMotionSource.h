@@ -0,0 +1,78 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/RootMotionSource.h"
+#include "ClimbRootMotionSource.generated.h"
+
+class UAnimMontage;
+
+/** Root motion of a climb montage sampled at a fixed rate, in actor space relative to where the montage starts */
+struct CLIMBINGSYSTEM_API FClimbRootMotionBake
+{
+	static constexpr float SampleRate = 30.f;
+
+	float Duration = 0.f;
+	TArray<FVector> Path;
+
+	/** Montage time at which each motion warping window ends, i.e. when the root reaches that warp target */
+	TArray<TPair<FName, float>> WarpTargetTimes;
+
+	static FClimbRootMotionBake Bake(const UAnimMontage &Montage, const FQuat &MeshToActorRotation);
+	FVector SamplePath(float Time) const;
+	FORCEINLINE bool IsValid() const { return Duration > UE_SMALL_NUMBER && Path.Num() >= 2; }
+};
+
+/**
+ * Moves the character along a baked climb montage path without evaluating the montage.
+ * Motion warp targets are honored by blending in a correction up to the time each target is reached.
+ * Only the montage, the quantized start transform and the warp corrections replicate, each peer rebakes the path.
+ */
+USTRUCT()
+struct CLIMBINGSYSTEM_API FRootMotionSource_ClimbPath : public FRootMotionSource
+{
+	GENERATED_BODY()
+
+	FRootMotionSource_ClimbPath();
+	virtual ~FRootMotionSource_ClimbPath() {}
+
+	UPROPERTY()
+	UAnimMontage *Montage = nullptr;
+
+	UPROPERTY()
+	FVector StartLocation = FVector::ZeroVector;
+
+	UPROPERTY()
+	FQuat StartRotation = FQuat::Identity;
+
+	/** Baked from Montage on each peer the first time the source moves the character, never replicated */
+	TArray<FVector> Path;
+
+	UPROPERTY()
+	TArray<float> CorrectionTimes;
+
+	UPROPERTY()
+	TArray<FVector> Corrections;
+
+	void Initialize(UAnimMontage &InMontage, const FClimbRootMotionBake &Bake, const FTransform &StartTransform, const TMap<FName, FVector> &WarpTargets);
+	FVector GetWorldLocationAtTime(float Time) const;
+
+	virtual FRootMotionSource *Clone() const override;
+	virtual bool Matches(const FRootMotionSource *Other) const override;
+	virtual bool MatchesAndHasSameState(const FRootMotionSource *Other) const override;
+	virtual bool UpdateStateFrom(const FRootMotionSource *SourceToTakeStateFrom, bool bMarkForSimulatedCatchup = false) override;
+	virtual void PrepareRootMotion(float SimulationTime, float MovementTickTime, const ACharacter &Character, const UCharacterMovementComponent &MoveComponent) override;
+	virtual bool NetSerialize(FArchive &Ar, UPackageMap *Map, bool &bOutSuccess) override;
+	virtual UScriptStruct *GetScriptStruct() const override;
+	virtual FString ToSimpleString() const override;
+	virtual void AddReferencedObjects(class FReferenceCollector &Collector) override;
+};
+
+template <>
+struct TStructOpsTypeTraits<FRootMotionSource_ClimbPath> : public TStructOpsTypeTraitsBase2<FRootMotionSource_ClimbPath>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithCopy = true
+	};
+};
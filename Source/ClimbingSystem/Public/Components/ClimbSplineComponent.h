@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SplineComponent.h"
+#include "ClimbSplineComponent.generated.h"
+
+/** What happens to a climber moving past an end of a climb spline */
+UENUM(BlueprintType)
+enum class EClimbSplineExit : uint8
+{
+	/** Let go and fall */
+	Release,
+	/** Follow the path on to the exit offset, then walk */
+	StepOff,
+	/** Carry on with the regular wall climb, which needs climbable geometry past the end */
+	WallClimb
+};
+
+/** Component space climber transform at one sample of the path */
+struct FClimbSplineFrame
+{
+	FVector3f Location;
+	FQuat4f Rotation;
+
+	/** Direction climb input moves the climber along the path */
+	FVector3f InputAxis;
+};
+
+/**
+ * Ladder, pipe or drainpipe climbed as a 1-D path. The spline runs from the bottom end to the top end and its
+ * up vector points away from the object, toward the climber. Climber transforms along the spline and the step-off
+ * segments at its ends are sampled into frames when the spline changes, so climbing it is a frame lookup per tick.
+ */
+UCLASS(ClassGroup = (Climbing), meta = (BlueprintSpawnableComponent))
+class CLIMBINGSYSTEM_API UClimbSplineComponent : public USplineComponent
+{
+	GENERATED_BODY()
+
+public:
+	UClimbSplineComponent();
+
+	/** World space climber transform at a distance along the path, step-off segments included */
+	FTransform GetClimberTransformAtDistance(float Distance) const;
+	FVector GetInputAxisAtDistance(float Distance) const;
+
+	/** Path distance of the frame closest to Location, false when no frame is within EntryRadius */
+	bool FindEntryDistance(const FVector &Location, float &OutDistance, float &OutDistanceSquared) const;
+
+	/** Path distance closest to Location, searched from the frame at NearDistance outward, for a climber already on the path */
+	float FindNearestDistance(const FVector &Location, float NearDistance) const;
+
+	/** Path distance of a wall climb end within EntryRadius of Location, when Direction leads onto the path */
+	bool FindWallClimbEntryDistance(const FVector &Location, const FVector &Direction, float &OutDistance) const;
+
+	FORCEINLINE bool HasClimbFrames() const { return ClimbFrames.Num() >= 2; }
+	FORCEINLINE float GetPathLength() const { return PathLength; }
+	FORCEINLINE float GetClimberOffset() const { return ClimberOffset; }
+	FORCEINLINE EClimbSplineExit GetExit(bool bTop) const { return bTop ? TopExit : BottomExit; }
+
+#pragma region Overriden Functions
+	virtual void UpdateSpline() override;
+
+protected:
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+#pragma endregion
+
+private:
+	void BuildClimbFrames();
+	FTransform GetClimberTransformAtSplineDistance(float SplineDistance) const;
+	void GetFrameAtDistance(float Distance, int32 &OutIndex, float &OutAlpha) const;
+
+	/** Capsule center distance from the spline, along the spline up vector */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Spline", meta = (AllowPrivateAccess = "true"))
+	float ClimberOffset = 40.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Spline", meta = (AllowPrivateAccess = "true", ClampMin = "1"))
+	float FrameSpacing = 10.f;
+
+	/** A climb press this close to the path starts climbing it */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Spline", meta = (AllowPrivateAccess = "true"))
+	float EntryRadius = 100.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Spline", meta = (AllowPrivateAccess = "true"))
+	EClimbSplineExit BottomExit = EClimbSplineExit::Release;
+
+	/** Where stepping off the bottom end leads, relative to the climber there */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Spline", meta = (AllowPrivateAccess = "true"))
+	FVector BottomExitOffset = FVector(-40.f, 0.f, 0.f);
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Spline", meta = (AllowPrivateAccess = "true"))
+	EClimbSplineExit TopExit = EClimbSplineExit::StepOff;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Climb Spline", meta = (AllowPrivateAccess = "true"))
+	FVector TopExitOffset = FVector(60.f, 0.f, 100.f);
+
+	TArray<FClimbSplineFrame> ClimbFrames;
+	FBox FrameBounds = FBox(ForceInit);
+	float FrameStep = 0.f;
+	float PathLength = 0.f;
+
+	/** Path distances of the spline ends, past the bottom step-off segment */
+	float ClimbStartDistance = 0.f;
+	float ClimbEndDistance = 0.f;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ClimbSplineSubsystem.generated.h"
+
+class UClimbSplineComponent;
+
+/** Climb splines of a game world, so climbers find ladders and pipes without scene queries */
+UCLASS()
+class CLIMBINGSYSTEM_API UClimbSplineSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject *Outer) const override;
+
+	void Register(UClimbSplineComponent &Spline);
+	void Unregister(UClimbSplineComponent &Spline);
+
+	/** Spline with the path point closest to Location within its entry radius, and the path distance to enter at */
+	UClimbSplineComponent *FindEntry(const FVector &Location, float &OutDistance) const;
+
+	/** Spline a wall climber at Location moving along Direction climbs onto at one of its wall climb ends */
+	UClimbSplineComponent *FindWallClimbEntry(const FVector &Location, const FVector &Direction, float &OutDistance) const;
+
+private:
+	TArray<TWeakObjectPtr<UClimbSplineComponent>> Splines;
+};
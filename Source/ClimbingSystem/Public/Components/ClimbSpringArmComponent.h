@@ -0,0 +1,105 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "ClimbSpringArmComponent.generated.h"
+
+class UCustomMovementComponent;
+
+USTRUCT(BlueprintType)
+struct FClimbCameraFraming
+{
+	GENERATED_BODY()
+
+	FClimbCameraFraming() = default;
+	FClimbCameraFraming(float InArmLength, const FVector &InSocketOffset, float InWallOffset, float InHeightOffset)
+		: ArmLength(InArmLength), SocketOffset(InSocketOffset), WallOffset(InWallOffset), HeightOffset(InHeightOffset)
+	{
+	}
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera")
+	float ArmLength = 400.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera")
+	FVector SocketOffset = FVector::ZeroVector;
+
+	/** Moves the arm pivot away from the climbed surface, along its normal */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera")
+	float WallOffset = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Camera")
+	float HeightOffset = 0.f;
+};
+
+/**
+ * Spring arm with ground, climb and hang framings. While on a wall the pivot is pushed out along
+ * the smoothed surface normal, and occlusion is probed every few frames instead of every frame,
+ * with the arm pulled in quickly and eased back out so uneven faces do not make it snap.
+ * Ground framing probes every frame, like the stock spring arm.
+ */
+UCLASS(ClassGroup = Camera, meta = (BlueprintSpawnableComponent))
+class CLIMBINGSYSTEM_API UClimbSpringArmComponent : public USpringArmComponent
+{
+	GENERATED_BODY()
+
+public:
+	UClimbSpringArmComponent();
+
+protected:
+	virtual void OnRegister() override;
+	virtual void UpdateDesiredArmLocation(bool bDoTrace, bool bDoLocationLag, bool bDoRotationLag, float DeltaTime) override;
+
+private:
+	const FClimbCameraFraming &GetCurrentFraming() const;
+	bool ShouldProbeOcclusion(const FRotator &DesiredRotation, const FVector &ArmOrigin) const;
+	void ProbeOcclusion(const FRotator &DesiredRotation);
+
+	UPROPERTY(EditDefaultsOnly, Category = "Camera: Climbing")
+	FClimbCameraFraming GroundFraming;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Camera: Climbing")
+	FClimbCameraFraming ClimbFraming;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Camera: Climbing")
+	FClimbCameraFraming HangFraming;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Camera: Climbing")
+	float FramingBlendSpeed = 4.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Camera: Climbing")
+	float WallNormalBlendSpeed = 3.f;
+
+	/** Frames between occlusion probes, staggered between arms */
+	UPROPERTY(EditDefaultsOnly, Category = "Camera: Climbing", meta = (ClampMin = "1"))
+	int32 OcclusionProbeInterval = 4;
+
+	/** Probe right away when the view turned further than this since the last probe */
+	UPROPERTY(EditDefaultsOnly, Category = "Camera: Climbing")
+	float OcclusionReprobeAngle = 15.f;
+
+	/** Probe right away when the arm pivot moved further than this since the last probe, such as on a fast mantle */
+	UPROPERTY(EditDefaultsOnly, Category = "Camera: Climbing")
+	float OcclusionReprobeDistance = 30.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Camera: Climbing")
+	float OcclusionPullInSpeed = 20.f;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Camera: Climbing")
+	float OcclusionEaseOutSpeed = 2.f;
+
+	UPROPERTY()
+	UCustomMovementComponent *CustomMovementComponent;
+
+	FVector BlendedSocketOffset = FVector::ZeroVector;
+	float BlendedFramingArmLength = 0.f;
+	float BlendedWallOffset = 0.f;
+	float BlendedHeightOffset = 0.f;
+	FVector SmoothedWallNormal = FVector::ZeroVector;
+
+	float OccludedArmLength = TNumericLimits<float>::Max();
+	float CurrentArmLength = 0.f;
+	FRotator LastProbeRotation = FRotator::ZeroRotator;
+	FVector LastProbeOrigin = FVector::ZeroVector;
+	uint64 LastProbeFrame = 0;
+	bool bFramingInitialized = false;
+};
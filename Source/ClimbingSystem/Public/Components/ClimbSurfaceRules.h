@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Surface rules shared by the climb checks in UCustomMovementComponent and the offline
+ * climbability analysis, so both classify geometry the same way.
+ */
+namespace ClimbSurfaceRules
+{
+	// ShouldStopClimbing
+	constexpr float MaxStopClimbingSurfaceAngle = 60.f;
+
+	// GetClimbableSurfaces, and the distance field probe that stands in for it
+	constexpr float SurfaceSweepForwardOffset = 30.f;
+
+	// CanStartClimbing / CheckHasReachedLedge
+	constexpr float EyeHeightTraceDistance = 100.f;
+	constexpr float LedgeTraceStartOffset = 50.f;
+	constexpr float LedgeWalkableTraceDepth = 100.f;
+	constexpr float MinClimbUpLedgeSpeed = 10.f;
+
+	// CanClimbDownLedge
+	constexpr float ClimbDownWalkableTraceDepth = 100.f;
+	constexpr float ClimbDownLedgeTraceDepth = 300.f;
+
+	// CanStartVaulting
+	constexpr int32 VaultTraceCount = 5;
+	constexpr float VaultTraceHeight = 100.f;
+	constexpr float VaultTraceStep = 100.f;
+
+	// CheckHasReachedFloor
+	constexpr float FloorTraceStartOffset = 50.f;
+	constexpr float MinReachFloorSpeed = 10.f;
+
+	FORCEINLINE float GetSurfaceAngleFromUp(const FVector &SurfaceNormal)
+	{
+		const float DotResult = FMath::Clamp(FVector::DotProduct(SurfaceNormal, FVector::UpVector), -1.f, 1.f);
+		return FMath::RadiansToDegrees(FMath::Acos(DotResult));
+	}
+
+	FORCEINLINE bool IsClimbableSurfaceNormal(const FVector &SurfaceNormal)
+	{
+		return GetSurfaceAngleFromUp(SurfaceNormal) > MaxStopClimbingSurfaceAngle;
+	}
+
+	FORCEINLINE bool IsFloorSurfaceNormal(const FVector &ImpactNormal)
+	{
+		return FVector::Parallel(-ImpactNormal, FVector::UpVector);
+	}
+}
@@ -4,23 +4,135 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/CharacterMovementComponent.h"
+#include "ClimbContactManifold.h"
+#include "ClimbRootMotionSource.h"
+#include "ClimbLedgeSegment.h"
+#include "ClimbInputBuffer.h"
+#include "ClimbEventQueue.h"
+#include "AnimInstance/AnimNotifyState_ClimbCancelWindow.h"
 #include "CustomMovementComponent.generated.h"
 
-DECLARE_DELEGATE(FOnEnterClimbState)
-DECLARE_DELEGATE(FOnExitClimbState)
-
 class UAnimMontage;
 class UAnimInstance;
 class AClimbingSystemCharacter;
+class UClimbAsyncPhysicsSubsystem;
+class UClimbRewindSubsystem;
+class UClimbQueryBudgetSubsystem;
+class UClimbSplineSubsystem;
+class UClimbSplineComponent;
+struct FClimbMovementMode;
+struct FHangMovementMode;
+struct FSplineClimbMovementMode;
 
+/** Custom movement modes, each implemented by a mode struct in CustomMovementModes.h */
 UENUM(BlueprintType)
 namespace ECustomMovementMode
 {
 	enum Type
 	{
-		MOVE_Climb UMETA(DisplayName = "Climb Mode")
+		MOVE_Climb UMETA(DisplayName = "Climb Mode"),
+		MOVE_Hang UMETA(DisplayName = "Braced Hang Mode"),
+		MOVE_SplineClimb UMETA(DisplayName = "Spline Climb Mode")
 	};
 }
+
+/** World queries a custom movement mode needs each tick, run once by the shared probe layer before its phys step */
+enum class EClimbProbe : uint8
+{
+	None = 0,
+	/** Capsule sweep into the contact manifold, then the averaged surface location and normal */
+	SurfaceContacts = 1 << 0,
+	/** One ledge top trace ahead of the hands, validating and extending the hang ledge segment */
+	LedgeValidation = 1 << 1,
+};
+ENUM_CLASS_FLAGS(EClimbProbe)
+
+UENUM(BlueprintType)
+enum class EClimbPhase : uint8
+{
+	Grounded,
+	Falling,
+	ClimbingIdle,
+	ClimbingMoving,
+	Traversal UMETA(ToolTip = "Playing a climb, vault or hop montage"),
+	Hanging
+};
+
+/** Climb outcomes an autonomous client predicts and the server validates against the geometry the client saw */
+UENUM()
+enum class EClimbStartAction : uint8
+{
+	Climb,
+	ClimbDownLedge,
+	Vault,
+	ClimbUpLedge,
+	ClimbSpline,
+	Hang UMETA(ToolTip = "Grab a ledge while falling")
+};
+
+/** Grounded climb action a climb press would start right now, for the on-screen prompt */
+UENUM(BlueprintType)
+enum class EClimbContextualAction : uint8
+{
+	None,
+	Climb,
+	ClimbDownLedge,
+	Vault,
+	ClimbSpline UMETA(ToolTip = "Grab a ladder or pipe climb spline")
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnClimbContextualActionChanged, EClimbContextualAction)
+
+/** Background evaluation of the contextual action, and where the character stood when it ran */
+struct FClimbContextualActionCache
+{
+	EClimbContextualAction Action = EClimbContextualAction::None;
+	double EvaluatedTime = -1.0;
+	double NextEvaluationTime = 0.0;
+	FVector Location = FVector::ZeroVector;
+	FVector Forward = FVector::ZeroVector;
+	FVector VaultStartPosition = FVector::ZeroVector;
+	FVector VaultLandPosition = FVector::ZeroVector;
+
+	/** Distance to climbable geometry straight ahead at knee height, the probe length when there was none */
+	float WallDistance = 0.f;
+};
+
+/** Analytic turn around a wall corner, kept in the space of the climbed primitive */
+struct FClimbCornerTransition
+{
+	EClimbCornerType Type = EClimbCornerType::None;
+	FVector EdgePoint = FVector::ZeroVector;
+	FVector FromNormal = FVector::ZeroVector;
+	FVector ToNormal = FVector::ZeroVector;
+	FVector StartLocation = FVector::ZeroVector;
+
+	/** Where the turn itself starts, level with the edge point: off the edge when wrapping, the pivot in an inner corner */
+	FVector TurnStart = FVector::ZeroVector;
+
+	/** Climber distance from the face the turn started on */
+	float StandOff = 0.f;
+	float Alpha = 0.f;
+	float Duration = 0.f;
+
+	FORCEINLINE bool IsActive() const { return Type != EClimbCornerType::None; }
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnClimbEvent, const FClimbEvent &)
+
+/** Timing of climb actions started shortly after the previous one finished */
+struct FClimbActionChainStats
+{
+	int32 NumActions = 0;
+	int32 NumCancelled = 0;
+	int32 NumChains = 0;
+	double TotalChainStartToStart = 0.0;
+	double TotalChainGap = 0.0;
+
+	/** Montage time left when actions were cancelled */
+	double TotalTimeSaved = 0.0;
+};
+
 /**
  *
  */
@@ -29,13 +141,21 @@ class CLIMBINGSYSTEM_API UCustomMovementComponent : public UCharacterMovementCom
 {
 	GENERATED_BODY()
 
+	friend struct FClimbMovementMode;
+	friend struct FHangMovementMode;
+	friend struct FSplineClimbMovementMode;
+
 public:
-	FOnEnterClimbState OnEnterClimbStateDelegate;
-	FOnExitClimbState OnExitClimbStateDelegate;
+	/** Climb events, dispatched at the end of the movement tick rather than from inside the movement step */
+	FOnClimbEvent OnClimbEventDelegate;
+
+	/** Drives the climb, drop and vault prompt of locally controlled players */
+	FOnClimbContextualActionChanged OnClimbContextualActionChangedDelegate;
 
 protected:
 #pragma region Overriden Functions
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction *ThisTickFunction) override;
 	virtual void OnMovementModeChanged(EMovementMode PreviousMovementMode, uint8 PreviousCustomMode) override;
 	virtual void PhysCustom(float deltaTime, int32 Iterations) override;
@@ -46,12 +166,28 @@ protected:
 
 private:
 #pragma region ClimbTraces
-	TArray<FHitResult> DoCapsuleTraceMultiByObject(const FVector &Start, const FVector &End, bool bShowDebugShape = false, bool bDrawPersistentShapes = false);
+	void DoCapsuleTraceMultiByObject(const FVector &Start, const FVector &End, TArray<FHitResult> &OutCapsuleTraceHitResults, bool bShowDebugShape = false, bool bDrawPersistentShapes = false);
 	FHitResult DoLineTraceSingleByObject(const FVector &Start, const FVector &End, bool bShowDebugShape = false, bool bDrawPersistentShapes = false);
 #pragma endregion
 
+#pragma region ModeSupport
+	void RunProbes(EClimbProbe Probes);
+	void SetCharacterCapsuleHalfHeight(float HalfHeight);
+	void ResetPitchAndRoll();
+#pragma endregion
+
+#pragma region ClimbBase
+	bool CanReuseClimbContacts() const;
+	void UpdateClimbMovementBase();
+	bool SampleClimbDistanceField(FVector &OutSurfaceLocation, FVector &OutSurfaceNormal) const;
+	bool TrackClimbableSurfaceWithDistanceField();
+
+	/** Moves the contacts on the climbed primitive to where the sweep would find them now, for the limbs and effects that read them */
+	void RefreshClimbContactsFromDistanceField();
+#pragma endregion
+
 #pragma region ClimbCore
-	TArray<FHitResult> GetClimbableSurfaces();
+	const FClimbContactManifold &GetClimbableSurfaces();
 	FHitResult TraceFromEyeHeight(float TraceDistance, float TraceStartOffset = 0.f, bool bShowDebugShape = false, bool bDrawPersistantShapes = false);
 	bool CanStartClimbing();
 	bool CanClimbDownLedge();
@@ -64,12 +200,16 @@ private:
 	FQuat GetClimbRotation(float DeltaTime);
 	void SnapMovementToClimbableSurfaces(float DeltaTime);
 	bool CheckHasReachedLedge();
-	void TryStartVaulting();
 	bool CanStartVaulting(FVector &OutVaultStartPosition, FVector &OutVaultLandPosition);
 	void PlayClimbMontage(UAnimMontage *MontageToPlay);
+	bool ShouldUseProceduralRootMotion() const;
+	const FClimbRootMotionBake &GetClimbRootMotionBake(const UAnimMontage *Montage);
+	bool ApplyClimbRootMotionSource(UAnimMontage *Montage);
+	void TickClimbRootMotionSource();
 
 	UFUNCTION()
 	void OnClimbMontageEnded(UAnimMontage *Montage, bool bInterrupted);
+	void HandleClimbActionEnded(UAnimMontage *Montage);
 	void SetMotionWarpTarget(const FName &InWarpTargetName, const FVector &InTargetPosition);
 	void HandleHopUp();
 	bool CheckCanHopUp(FVector &OutHopUpTargetPosition);
@@ -77,8 +217,211 @@ private:
 	bool CheckCanHopDown(FVector &OutHopDownTargetPosition);
 #pragma endregion
 
+#pragma region Corners
+	bool TryStartClimbCornerTransition();
+	void PhysClimbCorner(float deltaTime);
+	FTransform GetClimbCornerBaseTransform() const;
+#pragma endregion
+
+#pragma region HangCore
+	/** Speculative grabs, such as the automatic one while falling, ask the query budget at the speculative priority */
+	bool TryStartHanging(bool bSpeculative = false);
+	void StartHanging(const FClimbLedgeSegment &Ledge);
+	bool FitLedgeSegment(FClimbLedgeSegment &OutLedge);
+	bool TraceLedgeTop(const FVector &EdgePoint, const FVector &WallNormal, float SearchAbove, float SearchBelow, FVector &OutLedgeTop);
+	void ProbeHangLedge();
+	void PhysHang(float deltaTime, int32 Iterations);
+	FVector GetHangLocationAtDistance(float Distance) const;
+	void HandleHangHop(float VerticalInput);
+#pragma endregion
+
+#pragma region SplineClimb
+	UClimbSplineComponent *FindClimbSplineEntry(float &OutDistance) const;
+	bool TryStartSplineClimbing();
+	bool TryEnterClimbSplineFromWall();
+	void StartSplineClimbing(UClimbSplineComponent &Spline, float Distance);
+	void PhysSplineClimb(float deltaTime, int32 Iterations);
+	void LeaveClimbSpline(bool bTop);
+#pragma endregion
+
+#pragma region CancelWindows
+	void BeginClimbAction(UAnimMontage *Montage);
+	void FinishClimbAction(EClimbActionEndReason Reason);
+	float GetActiveClimbActionTime();
+	const TArray<FClimbCancelWindow> &GetClimbCancelWindows(const UAnimMontage *Montage);
+	bool IsInClimbCancelWindow(bool bTraversal);
+	void UpdateClimbLocomotionCancel();
+#pragma endregion
+
+#pragma region ClimbEvents
+	void PostClimbEvent(EClimbEventType Type, UAnimMontage *Montage = nullptr, EClimbActionEndReason Reason = EClimbActionEndReason::Completed);
+	void DispatchClimbEvents();
+	void ApplyEndedClimbMontage();
+#pragma endregion
+
+#pragma region InputBuffer
+	void ProcessClimbInputBuffer();
+	bool IsClimbInputActionBlocked(EClimbInputAction Action, const FClimbBufferedInput &Input) const;
+	void ExecuteClimbInputAction(EClimbInputAction Action, const FClimbBufferedInput &Input);
+	void ExecuteHop(float VerticalInput);
+#pragma endregion
+
+#pragma region ServerValidation
+	bool IsServerForRemoteClimber() const;
+	void SendClimbStartToServer(EClimbStartAction Action);
+	double GetClimbViewTime() const;
+	bool ValidateClimbStart(EClimbStartAction Action);
+
+	/** True while validating a client request and this tick's rewind budget has room for another query */
+	bool ShouldRewindClimbQuery() const;
+
+	UFUNCTION(Server, Reliable)
+	void ServerRequestClimbStart(EClimbStartAction Action, double ClientViewTime);
+
+	UFUNCTION(Client, Reliable)
+	void ClientRejectClimbStart(EClimbStartAction Action);
+#pragma endregion
+
+#pragma region ContextualAction
+	void UpdateContextualAction();
+	EClimbContextualAction EvaluateContextualAction(bool bWallInReach, FVector &OutVaultStartPosition, FVector &OutVaultLandPosition);
+	/** Whether a press can start the cached action without evaluating, never for a cached None */
+	bool IsContextualActionCacheValid() const;
+	float GetContextualActionInterval() const;
+	void StartContextualAction(EClimbContextualAction Action, const FVector &VaultStartPosition, const FVector &VaultLandPosition);
+	void PublishContextualAction(EClimbContextualAction Action);
+#pragma endregion
+
+#pragma region QueryBudget
+	/**
+	 * Asks the world climb query budget for NumQueries at the character's priority, or the speculative one, false when the
+	 * probe should keep its last result or wait. LastServedTime is negative for a probe that never ran
+	 */
+	bool AcquireClimbQueries(int32 NumQueries, double LastServedTime, bool bSpeculative = false);
+#pragma endregion
+
+#pragma region AsyncClimb
+	void AcquireAsyncClimber();
+	void ReleaseAsyncClimber();
+	bool ShouldRunClimbOnPhysicsThread() const;
+	void PhysClimbAsync(float deltaTime);
+#pragma endregion
+
+#pragma region LedgeGrab
+	void UpdateAirborneLedgeGrab();
+	void RefreshLedgeGrabCandidates();
+	bool CanTrajectoryReachLedgeCandidate() const;
+#pragma endregion
+
+#pragma region CancelWindowVariables
+	TMap<const UAnimMontage *, TArray<FClimbCancelWindow>> ClimbCancelWindows;
+	double ActiveClimbActionStartTime = 0.0;
+	double LastClimbActionFinishTime = -1.0;
+	FClimbActionChainStats ClimbActionChainStats;
+#pragma endregion
+
+#pragma region InputBufferVariables
+	FClimbInputBuffer ClimbInputBuffer;
+#pragma endregion
+
+#pragma region ClimbEventsVariables
+	FClimbEventQueue ClimbEvents;
+
+	/** Capsule resized during the movement step, its overlaps are brought up to date with the event dispatch */
+	bool bCapsuleOverlapsPending = false;
+
+	/** Climb montage that ended during the anim update, its state transition runs before the next movement step */
+	UPROPERTY()
+	UAnimMontage *EndedClimbMontage = nullptr;
+
+	bool bEndedClimbMontageInterrupted = false;
+#pragma endregion
+
+#pragma region ServerValidationVariables
+	UPROPERTY()
+	UClimbRewindSubsystem *ClimbRewind;
+
+	/** Server time the climb traces run at while validating a client request, negative outside validation */
+	double ClimbRewindTime = -1.0;
+#pragma endregion
+
+#pragma region ContextualActionVariables
+	FClimbContextualActionCache ContextualAction;
+
+	/** Set while the background evaluation runs on queries it already took from the budget */
+	bool bContextualActionQueriesAcquired = false;
+#pragma endregion
+
+#pragma region QueryBudgetVariables
+	UPROPERTY()
+	UClimbQueryBudgetSubsystem *ClimbQueryBudget;
+
+	/** When the surface sweep, the floor and ledge checks of the climb step, the surface snap and the hang ledge probe last ran */
+	double LastClimbSurfaceQueryTime = -1.0;
+	double LastClimbStepQueryTime = -1.0;
+	double LastClimbSnapQueryTime = -1.0;
+	double LastHangLedgeQueryTime = -1.0;
+#pragma endregion
+
+#pragma region AsyncClimbVariables
+	UPROPERTY()
+	UClimbAsyncPhysicsSubsystem *AsyncClimbPhysics;
+
+	int32 AsyncClimberId = INDEX_NONE;
+
+	/** Physics thread results based on a submission at or before LastAppliedAsyncClimbSerial are stale */
+	uint32 LastSubmittedAsyncClimbSerial = 0;
+	uint32 LastAppliedAsyncClimbSerial = 0;
+#pragma endregion
+
+#pragma region LedgeGrabVariables
+	/** Primitives on the climb query channels around a falling character, refreshed every LedgeGrabCandidateRefreshInterval */
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> LedgeGrabCandidates;
+	FVector LedgeGrabCandidatesCenter = FVector::ZeroVector;
+	double LedgeGrabCandidatesTime = -1.0;
+
+	/** No precise ledge check before this time, after one failed */
+	double LedgeGrabRetryTime = -1.0;
+#pragma endregion
+
+#pragma region CornersVariables
+	/** Plane pair of the last contacts when they lie on both faces of a corner */
+	FClimbCornerFit ClimbCorner;
+	FClimbCornerTransition ClimbCornerTransition;
+#pragma endregion
+
+#pragma region HangCoreVariables
+	FClimbLedgeSegment HangLedge;
+	float HangDistance = 0.f;
+
+	/** Set by the validation probe when there is no ledge ahead in this direction (-1 or 1) */
+	float HangBlockedSign = 0.f;
+	bool bHangLedgeLost = false;
+#pragma endregion
+
+#pragma region SplineClimbVariables
+	UPROPERTY()
+	UClimbSplineSubsystem *ClimbSplines;
+
+	TWeakObjectPtr<UClimbSplineComponent> ClimbSpline;
+
+	/** Recovered from the climber's location at the start of every spline climb step */
+	float SplineClimbDistance = 0.f;
+
+	/** Where the climber was relative to the path on entering it, blended out over the first ticks */
+	FVector SplineEntryOffset = FVector::ZeroVector;
+#pragma endregion
+
 #pragma region ClimbCoreVariables
-	TArray<FHitResult> ClimbableSurfacesTracedResults;
+	FClimbContactManifold ClimbContacts;
+	int32 LastClimbSweepHitCount = 0;
+
+	/** Primitive the best contact is on, and the climber transform relative to it at the last sweep */
+	TWeakObjectPtr<UPrimitiveComponent> ClimbContactBase;
+	FTransform ClimbSweepRelativeTransform;
+
+	/** Surface probes answered by the climb base distance field since the last sweep */
+	int32 DistanceFieldProbesSinceSweep = 0;
 	FVector CurrentClimbableSurfaceLocation;
 	FVector CurrentClimbableSurfaceNormal;
 
@@ -87,18 +430,58 @@ private:
 
 	UPROPERTY()
 	AClimbingSystemCharacter *OwningPlayerCharacter;
+
+	TArray<TEnumAsByte<EObjectTypeQuery>> ClimbQueryObjectTypes;
+	FCollisionObjectQueryParams ClimbObjectQueryParams;
+
+	/** Consecutive ticks spent climbing without an action, used by the allocation audit */
+	int32 SteadyClimbTicks = 0;
+
+	TMap<const UAnimMontage *, FClimbRootMotionBake> ClimbRootMotionBakes;
+	TMap<FName, FVector> ClimbWarpTargets;
+
+	UPROPERTY()
+	UAnimMontage *ActiveClimbActionMontage;
+
+	uint16 ActiveClimbRootMotionSourceID = (uint16)ERootMotionSourceID::Invalid;
 #pragma endregion
 
 #pragma region ClimbBPVariables
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
 	TArray<TEnumAsByte<EObjectTypeQuery>> ClimbableSurfaceTraceTypes;
 
+	/** Run climb queries against the generated climb proxies only, instead of the ClimbableSurfaceTraceTypes art collision */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseClimbCollisionProxies = false;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
 	float ClimbCapsuleTraceRadius = 50.f;
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"));
 	float ClimbCapsuleTraceHalfHeight = 72;
 
+	/** The climb sweep only runs again once the climber moved or turned this much relative to the climbed primitive */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	float ClimbReprobeDistance = 2.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	float ClimbReprobeAngle = 2.f;
+
+	/** Track and snap to the climbed mesh with its generated distance field, sweeping only every ClimbDistanceFieldSweepInterval probes to validate */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseClimbDistanceFields = false;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true", ClampMin = "1"))
+	int32 ClimbDistanceFieldSweepInterval = 8;
+
+	/** A climb probe the query budget deferred for this long runs as soon as the budget has room at all */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	float ClimbQueryMaxDeferTime = 0.1f;
+
+	/** Step climbing in a physics callback with physics thread scene queries, the game thread only applies the results. Standalone only */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseAsyncClimbPhysics = false;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
 	float MaxBreakClimbDeceleration = 400.f;
 
@@ -114,6 +497,142 @@ private:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
 	float ClimbDownLedgeTraceOffset = 25.f;
 
+	/** Drive climb actions with root motion sources baked from the montages instead of montage root motion, on server and clients alike */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bUseProceduralRootMotion = false;
+
+	/** With bUseProceduralRootMotion nothing on a dedicated server needs the pose, so mesh and anim ticking are skipped there entirely */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
+	bool bDisableMeshTickOnDedicatedServer = true;
+
+	/** Contacts whose normals are at least this many degrees apart are split into the two faces of a corner */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Corners", meta = (AllowPrivateAccess = "true"))
+	float ClimbCornerMinAngle = 30.f;
+
+	/** Moving into a corner turns it from this close to where the turn starts */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Corners", meta = (AllowPrivateAccess = "true"))
+	float ClimbCornerTriggerDistance = 30.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Corners", meta = (AllowPrivateAccess = "true"))
+	float ClimbCornerMinTurnTime = 0.25f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Hang", meta = (AllowPrivateAccess = "true"))
+	float MaxHangShimmySpeed = 80.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Hang", meta = (AllowPrivateAccess = "true"))
+	float MaxHangAcceleration = 300.f;
+
+	/** Character location relative to the ledge edge while hanging */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Hang", meta = (AllowPrivateAccess = "true"))
+	float HangWallOffset = 35.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Hang", meta = (AllowPrivateAccess = "true"))
+	float HangHeightBelowLedge = 105.f;
+
+	/** How far behind the wall face ledge top traces start */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Hang", meta = (AllowPrivateAccess = "true"))
+	float HangLedgeInset = 10.f;
+
+	/** Ledge tops this far above or below eye height can be grabbed */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Hang", meta = (AllowPrivateAccess = "true"))
+	float HangLedgeSearchHeight = 100.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Hang", meta = (AllowPrivateAccess = "true"))
+	float HangLedgeHeightTolerance = 20.f;
+
+	/** Spacing and count of the ledge samples taken to each side when the segment is first fitted */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Hang", meta = (AllowPrivateAccess = "true"))
+	float HangFitStep = 25.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Hang", meta = (AllowPrivateAccess = "true"))
+	int32 HangFitSamples = 6;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Hang", meta = (AllowPrivateAccess = "true"))
+	float HangLedgeLookAhead = 30.f;
+
+	/** Closest the hands get to either end of the known ledge */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Hang", meta = (AllowPrivateAccess = "true"))
+	float HangEdgeMargin = 25.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Spline", meta = (AllowPrivateAccess = "true"))
+	float MaxSplineClimbSpeed = 120.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Spline", meta = (AllowPrivateAccess = "true"))
+	float MaxSplineClimbAcceleration = 600.f;
+
+	/** How fast the climber settles onto a climb spline after grabbing it */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Spline", meta = (AllowPrivateAccess = "true"))
+	float SplineEntryInterpSpeed = 8.f;
+
+	/** Grab ledges automatically when the fall trajectory brings the hands up to one */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Ledge Grab", meta = (AllowPrivateAccess = "true"))
+	bool bAutoGrabLedgesWhileFalling = true;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Ledge Grab", meta = (AllowPrivateAccess = "true"))
+	float LedgeGrabCandidateRadius = 800.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Ledge Grab", meta = (AllowPrivateAccess = "true"))
+	float LedgeGrabCandidateRefreshInterval = 0.5f;
+
+	/** How far ahead the ballistic trajectory is tested against the candidate bounds */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Ledge Grab", meta = (AllowPrivateAccess = "true"))
+	float LedgeGrabPredictionTime = 0.2f;
+
+	/** Horizontal reach of the hands in front of the capsule */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Ledge Grab", meta = (AllowPrivateAccess = "true"))
+	float LedgeGrabReach = 80.f;
+
+	/** Seconds between precise ledge checks while the trajectory keeps passing a candidate without a grabbable ledge */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Ledge Grab", meta = (AllowPrivateAccess = "true"))
+	float LedgeGrabRetryCooldown = 0.15f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Cancel Windows", meta = (AllowPrivateAccess = "true"))
+	float ClimbActionCancelBlendOutTime = 0.2f;
+
+	/** An action starting at most this long after the previous one finished counts as chained */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Cancel Windows", meta = (AllowPrivateAccess = "true"))
+	float ClimbActionChainMaxGap = 0.5f;
+
+	/** Keep the climb, drop or vault action of locally controlled players evaluated ahead of the press */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Contextual Action", meta = (AllowPrivateAccess = "true"))
+	bool bEvaluateContextualActions = true;
+
+	/** Evaluation interval next to climbable geometry or while an action is available */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Contextual Action", meta = (AllowPrivateAccess = "true"))
+	float ContextualActionMinInterval = 0.05f;
+
+	/** Evaluation interval standing still or with nothing climbable ahead */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Contextual Action", meta = (AllowPrivateAccess = "true"))
+	float ContextualActionMaxInterval = 0.5f;
+
+	/** A press uses the evaluated action while it is this young and the character moved and turned less than this since */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Contextual Action", meta = (AllowPrivateAccess = "true"))
+	float ContextualActionValidTime = 0.2f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Contextual Action", meta = (AllowPrivateAccess = "true"))
+	float ContextualActionMaxDrift = 20.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Contextual Action", meta = (AllowPrivateAccess = "true"))
+	float ContextualActionMaxTurn = 15.f;
+
+	/** Length of the proximity trace ahead; climb and vault are only checked with geometry within ContextualActionReach */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Contextual Action", meta = (AllowPrivateAccess = "true"))
+	float ContextualActionProbeDistance = 500.f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Contextual Action", meta = (AllowPrivateAccess = "true"))
+	float ContextualActionReach = 150.f;
+
+	/** Seconds a climb press made during a climb action is kept, to fire once the action ends */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Input Buffer", meta = (AllowPrivateAccess = "true"))
+	float ClimbInputBufferWindow = 0.2f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Input Buffer", meta = (AllowPrivateAccess = "true"))
+	float HopInputBufferWindow = 0.3f;
+
+	/** Stop in a braced hang when climbing reaches a ledge, instead of climbing straight up */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing|Hang", meta = (AllowPrivateAccess = "true"))
+	bool bHangBeforeClimbingUp = false;
+
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Character Movement: Climbing", meta = (AllowPrivateAccess = "true"))
 	UAnimMontage *IdleToClimbMontage;
 
@@ -135,8 +654,37 @@ private:
 
 public:
 	void ToggleClimbing(bool bAttemptClimbing);
+	bool TryStartClimbingImmediately();
+
+	/** Buffered climb and hop presses, fired right away or on the first frame no climb action blocks them */
+	void RequestClimbAction();
 	void RequestHopping();
 	bool IsClimbing() const;
+	bool IsHanging() const;
+	bool IsClimbingSpline() const;
+	bool IsClimbActionPlaying() const;
+	EClimbPhase GetClimbPhase() const;
+	FORCEINLINE EClimbContextualAction GetContextualAction() const { return ContextualAction.Action; }
 	FORCEINLINE FVector GetClimbableSurfaceNormal() const { return CurrentClimbableSurfaceNormal; }
+	FORCEINLINE FVector GetClimbableSurfaceLocation() const { return CurrentClimbableSurfaceLocation; }
+	FORCEINLINE const FClimbContactManifold &GetClimbContacts() const { return ClimbContacts; }
+	FORCEINLINE const FClimbRootMotionBake *FindClimbRootMotionBake(const UAnimMontage *Montage) const { return ClimbRootMotionBakes.Find(Montage); }
+	FORCEINLINE const FClimbCornerFit &GetClimbCorner() const { return ClimbCorner; }
+	FORCEINLINE bool IsTurningClimbCorner() const { return ClimbCornerTransition.IsActive(); }
+	FORCEINLINE const FClimbLedgeSegment &GetHangLedge() const { return HangLedge; }
+	FORCEINLINE const UAnimMontage *GetVaultMontage() const { return VaultMontage; }
+	FORCEINLINE float GetHangDistance() const { return HangDistance; }
+	FORCEINLINE UClimbSplineComponent *GetClimbSpline() const { return ClimbSpline.Get(); }
+	FORCEINLINE float GetSplineClimbDistance() const { return SplineClimbDistance; }
+	FORCEINLINE const FClimbInputBuffer &GetClimbInputBuffer() const { return ClimbInputBuffer; }
+	FORCEINLINE FClimbActionChainStats &GetClimbActionChainStats() { return ClimbActionChainStats; }
+	FORCEINLINE FClimbEventStats &GetClimbEventStats() { return ClimbEvents.Stats; }
+	FORCEINLINE int32 GetLastClimbSweepHitCount() const { return LastClimbSweepHitCount; }
+	FORCEINLINE const TArray<TEnumAsByte<EObjectTypeQuery>> &GetClimbableSurfaceTraceTypes() const { return ClimbableSurfaceTraceTypes; }
+	FORCEINLINE const FCollisionObjectQueryParams &GetClimbObjectQueryParams() const { return ClimbObjectQueryParams; }
+	FORCEINLINE float GetClimbCapsuleTraceRadius() const { return ClimbCapsuleTraceRadius; }
+	FORCEINLINE float GetClimbCapsuleTraceHalfHeight() const { return ClimbCapsuleTraceHalfHeight; }
+	FORCEINLINE float GetClimbDownWalkableSurfaceTraceOffset() const { return ClimbDownWalkableSurfaceTraceOffset; }
+	FORCEINLINE float GetClimbDownLedgeTraceOffset() const { return ClimbDownLedgeTraceOffset; }
 	FVector GetUnrotatedClimbVelocity() const;
 };
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/CustomMovementComponent.h"
+
+/**
+ * Custom movement modes of UCustomMovementComponent, dispatched statically.
+ *
+ * A mode is a stateless struct with:
+ *   static constexpr ECustomMovementMode::Type Mode;
+ *   static constexpr EClimbProbe RequiredProbes;      gathered by the shared probe layer before PhysStep
+ *   static void PhysStep(UCustomMovementComponent &, float DeltaTime, int32 Iterations);
+ *   static float GetMaxSpeed(const UCustomMovementComponent &);
+ *   static float GetMaxAcceleration(const UCustomMovementComponent &);
+ *   static void OnEnter(UCustomMovementComponent &);
+ *   static void OnExit(UCustomMovementComponent &);
+ *
+ * New modes add an ECustomMovementMode entry, a struct here, a friend declaration in
+ * UCustomMovementComponent and an entry in FCustomMovementModes.
+ */
+template <typename... TModes>
+struct TCustomMovementModeTable
+{
+	/** Calls Visitor with the mode matching CustomMode, false when no mode matches */
+	template <typename TVisitor>
+	static FORCEINLINE bool Visit(uint8 CustomMode, TVisitor &&Visitor)
+	{
+		return ((CustomMode == TModes::Mode ? (Visitor(TModes{}), true) : false) || ...);
+	}
+
+	static constexpr int32 Num() { return sizeof...(TModes); }
+};
+
+struct FClimbMovementMode
+{
+	static constexpr ECustomMovementMode::Type Mode = ECustomMovementMode::MOVE_Climb;
+	static constexpr EClimbProbe RequiredProbes = EClimbProbe::SurfaceContacts;
+
+	static void PhysStep(UCustomMovementComponent &Component, float DeltaTime, int32 Iterations)
+	{
+		if (Component.ShouldRunClimbOnPhysicsThread())
+		{
+			Component.PhysClimbAsync(DeltaTime);
+		}
+		else
+		{
+			Component.PhysClimb(DeltaTime, Iterations);
+		}
+	}
+
+	static float GetMaxSpeed(const UCustomMovementComponent &Component)
+	{
+		return Component.MaxClimbSpeed;
+	}
+
+	static float GetMaxAcceleration(const UCustomMovementComponent &Component)
+	{
+		return Component.MaxClimbAcceleration;
+	}
+
+	static void OnEnter(UCustomMovementComponent &Component)
+	{
+		Component.bOrientRotationToMovement = false;
+		Component.SetCharacterCapsuleHalfHeight(48.f);
+		Component.AcquireAsyncClimber();
+		Component.PostClimbEvent(EClimbEventType::ClimbStarted);
+	}
+
+	static void OnExit(UCustomMovementComponent &Component)
+	{
+		Component.bOrientRotationToMovement = true;
+		Component.SetCharacterCapsuleHalfHeight(96.f);
+		Component.ResetPitchAndRoll();
+		Component.StopMovementImmediately();
+		Component.ReleaseAsyncClimber();
+		Component.ClimbCorner.Reset();
+		Component.ClimbCornerTransition = FClimbCornerTransition();
+		Component.PostClimbEvent(EClimbEventType::ClimbEnded);
+	}
+};
+
+struct FHangMovementMode
+{
+	static constexpr ECustomMovementMode::Type Mode = ECustomMovementMode::MOVE_Hang;
+	static constexpr EClimbProbe RequiredProbes = EClimbProbe::LedgeValidation;
+
+	static void PhysStep(UCustomMovementComponent &Component, float DeltaTime, int32 Iterations)
+	{
+		Component.PhysHang(DeltaTime, Iterations);
+	}
+
+	static float GetMaxSpeed(const UCustomMovementComponent &Component)
+	{
+		return Component.MaxHangShimmySpeed;
+	}
+
+	static float GetMaxAcceleration(const UCustomMovementComponent &Component)
+	{
+		return Component.MaxHangAcceleration;
+	}
+
+	static void OnEnter(UCustomMovementComponent &Component)
+	{
+		FClimbMovementMode::OnEnter(Component);
+	}
+
+	static void OnExit(UCustomMovementComponent &Component)
+	{
+		FClimbMovementMode::OnExit(Component);
+		Component.HangLedge.Reset();
+		Component.HangBlockedSign = 0.f;
+		Component.bHangLedgeLost = false;
+	}
+};
+
+struct FSplineClimbMovementMode
+{
+	static constexpr ECustomMovementMode::Type Mode = ECustomMovementMode::MOVE_SplineClimb;
+
+	/** The climb spline carries its own frames, nothing is queried while on it */
+	static constexpr EClimbProbe RequiredProbes = EClimbProbe::None;
+
+	static void PhysStep(UCustomMovementComponent &Component, float DeltaTime, int32 Iterations)
+	{
+		Component.PhysSplineClimb(DeltaTime, Iterations);
+	}
+
+	static float GetMaxSpeed(const UCustomMovementComponent &Component)
+	{
+		return Component.MaxSplineClimbSpeed;
+	}
+
+	static float GetMaxAcceleration(const UCustomMovementComponent &Component)
+	{
+		return Component.MaxSplineClimbAcceleration;
+	}
+
+	static void OnEnter(UCustomMovementComponent &Component)
+	{
+		Component.bOrientRotationToMovement = false;
+		Component.SetCharacterCapsuleHalfHeight(48.f);
+
+		// The wall climb a spline hands off to must not reuse contacts from before it
+		Component.ClimbContacts.Reset();
+		Component.ClimbContactBase.Reset();
+		Component.PostClimbEvent(EClimbEventType::ClimbStarted);
+	}
+
+	static void OnExit(UCustomMovementComponent &Component)
+	{
+		Component.bOrientRotationToMovement = true;
+		Component.SetCharacterCapsuleHalfHeight(96.f);
+		Component.ResetPitchAndRoll();
+		Component.StopMovementImmediately();
+		Component.ClimbSpline.Reset();
+		Component.PostClimbEvent(EClimbEventType::ClimbEnded);
+	}
+};
+
+using FCustomMovementModes = TCustomMovementModeTable<FClimbMovementMode, FHangMovementMode, FSplineClimbMovementMode>;
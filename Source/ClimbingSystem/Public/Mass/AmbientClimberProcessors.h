@@ -0,0 +1,57 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "MassEntityQuery.h"
+#include "AmbientClimberProcessors.generated.h"
+
+/** Runs the climb, hop and ledge phases of every ambient climber in chunked batches, no scene queries */
+UCLASS()
+class CLIMBINGSYSTEM_API UAmbientClimberMovementProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UAmbientClimberMovementProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager &EntityManager, FMassExecutionContext &Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
+
+/** Hands ambient climbers close to a viewer over to UAmbientClimberSubsystem to become full characters */
+UCLASS()
+class CLIMBINGSYSTEM_API UAmbientClimberPromotionProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UAmbientClimberPromotionProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager &EntityManager, FMassExecutionContext &Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
+
+/** Copies ambient climber transforms into the instanced mesh owned by UAmbientClimberSubsystem */
+UCLASS()
+class CLIMBINGSYSTEM_API UAmbientClimberRepresentationProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UAmbientClimberRepresentationProcessor();
+
+protected:
+	virtual void ConfigureQueries() override;
+	virtual void Execute(FMassEntityManager &EntityManager, FMassExecutionContext &Context) override;
+
+private:
+	FMassEntityQuery EntityQuery;
+};
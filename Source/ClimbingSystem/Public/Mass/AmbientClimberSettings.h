@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "AmbientClimberSettings.generated.h"
+
+class AClimbingSystemCharacter;
+class UStaticMesh;
+
+/**
+ * Ambient climbers are MassEntity climbers simulated on wall patches without any scene queries.
+ * They are promoted to full characters near a viewer and demoted again once they are far away.
+ */
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "Ambient Climbers"))
+class CLIMBINGSYSTEM_API UAmbientClimberSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(config, EditAnywhere, Category = "Representation")
+	TSoftClassPtr<AClimbingSystemCharacter> PromotedCharacterClass;
+
+	UPROPERTY(config, EditAnywhere, Category = "Representation")
+	TSoftObjectPtr<UStaticMesh> RepresentationMesh;
+
+	UPROPERTY(config, EditAnywhere, Category = "Representation")
+	float PromoteDistance = 2500.f;
+
+	/** Kept above PromoteDistance so climbers at the boundary do not flip every frame */
+	UPROPERTY(config, EditAnywhere, Category = "Representation")
+	float DemoteDistance = 3500.f;
+
+	UPROPERTY(config, EditAnywhere, Category = "Representation")
+	int32 MaxPromotedClimbers = 16;
+
+	UPROPERTY(config, EditAnywhere, Category = "Representation")
+	int32 MaxPromotionsPerFrame = 2;
+
+	UPROPERTY(config, EditAnywhere, Category = "Climbing")
+	float ClimbSpeed = 100.f;
+
+	UPROPERTY(config, EditAnywhere, Category = "Climbing")
+	float SurfaceStandOff = 45.f;
+
+	UPROPERTY(config, EditAnywhere, Category = "Climbing")
+	float HopDistance = 150.f;
+
+	UPROPERTY(config, EditAnywhere, Category = "Climbing")
+	float HopDuration = 0.6f;
+
+	UPROPERTY(config, EditAnywhere, Category = "Climbing")
+	float HopChancePerSecond = 0.1f;
+
+	UPROPERTY(config, EditAnywhere, Category = "Climbing")
+	float ClimbUpDuration = 2.f;
+};
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "MassArchetypeTypes.h"
+#include "Mass/AmbientClimberTypes.h"
+#include "AmbientClimberSubsystem.generated.h"
+
+class AClimbingSystemCharacter;
+class UInstancedStaticMeshComponent;
+
+/**
+ * Owns the ambient climber entities, their instanced representation, and the promotion of entities
+ * close to a viewer into full AClimbingSystemCharacters (and their demotion back once far away).
+ */
+UCLASS()
+class CLIMBINGSYSTEM_API UAmbientClimberSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject *Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld &InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/** Spawns Count climbers spread over a wall patch. SurfaceOrigin is the bottom center of the patch. */
+	UFUNCTION(BlueprintCallable, Category = "Ambient Climbers")
+	void SpawnAmbientClimbers(const FVector &SurfaceOrigin, const FVector &SurfaceNormal, float SurfaceWidth, float SurfaceHeight, int32 Count);
+
+	/** Queues an entity to become a full character this frame, false when the promotion budget is used up */
+	bool RequestPromotion(const FTransform &Transform, const FAmbientClimbSurfaceFragment &Surface);
+
+	void UpdateRepresentation();
+
+	/** Spawns Count climbers on a wall patch in front of the first viewer, then logs the frame times of the next Seconds. See Climb.MeasureAmbientClimbers */
+	void StartMeasurement(int32 Count, float Seconds);
+
+	FORCEINLINE const TArray<FVector> &GetViewerLocations() const { return ViewerLocations; }
+	FORCEINLINE TArray<FTransform> &GetRepresentationTransforms() { return RepresentationTransforms; }
+
+private:
+	struct FPendingPromotion
+	{
+		FTransform Transform;
+		FAmbientClimbSurfaceFragment Surface;
+	};
+
+	struct FPromotedClimber
+	{
+		TWeakObjectPtr<AClimbingSystemCharacter> Character;
+		FAmbientClimbSurfaceFragment Surface;
+	};
+
+	struct FMeasurement
+	{
+		double EndTime = 0.0;
+		int32 NumFrames = 0;
+		int32 MinClimbers = 0;
+		double FrameTimeSum = 0.0;
+		double GameThreadTimeSum = 0.0;
+		double WorstFrameTime = 0.0;
+	};
+
+	void UpdateViewerLocations();
+	void ProcessPromotions();
+	void ProcessDemotions();
+	void CreateClimberEntities(TConstArrayView<FAmbientClimbSurfaceFragment> Surfaces);
+	bool IsNearAnyViewer(const FVector &Location, float Distance) const;
+	void UpdateMeasurement();
+
+	FMassArchetypeHandle ClimberArchetype;
+	TArray<FVector> ViewerLocations;
+	TArray<FPendingPromotion> PendingPromotions;
+	TArray<FPromotedClimber> PromotedClimbers;
+	TArray<FTransform> RepresentationTransforms;
+
+	/** Running while EndTime is set */
+	FMeasurement Measurement;
+
+	UPROPERTY()
+	UClass *PromotedCharacterClass;
+
+	UPROPERTY()
+	AActor *RepresentationActor;
+
+	UPROPERTY()
+	UInstancedStaticMeshComponent *RepresentationComponent;
+};
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "AmbientClimberTypes.generated.h"
+
+UENUM()
+enum class EAmbientClimbPhase : uint8
+{
+	Climbing,
+	Hopping,
+	ClimbingUp,
+	Dropping
+};
+
+/** Wall patch an ambient climber moves on, and the climber's position on it in surface space */
+USTRUCT()
+struct CLIMBINGSYSTEM_API FAmbientClimbSurfaceFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	/** Bottom center of the patch */
+	FVector Origin = FVector::ZeroVector;
+	FVector Normal = -FVector::ForwardVector;
+	FVector Right = FVector::RightVector;
+	FVector Up = FVector::UpVector;
+
+	/** Half width and full height of the patch */
+	FVector2f Extent = FVector2f(200.f, 400.f);
+
+	/** Right and up offset from Origin */
+	FVector2f Position = FVector2f::ZeroVector;
+};
+
+USTRUCT()
+struct CLIMBINGSYSTEM_API FAmbientClimbPhaseFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	EAmbientClimbPhase Phase = EAmbientClimbPhase::Climbing;
+	float PhaseTime = 0.f;
+	FVector2f Direction = FVector2f(0.f, 1.f);
+	FVector2f PhaseStart = FVector2f::ZeroVector;
+	FVector2f PhaseTarget = FVector2f::ZeroVector;
+	FRandomStream RandomStream;
+};
+
+USTRUCT()
+struct CLIMBINGSYSTEM_API FAmbientClimberTag : public FMassTag
+{
+	GENERATED_BODY()
+};